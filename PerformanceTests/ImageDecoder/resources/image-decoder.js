@@ -0,0 +1,152 @@
+// ImageDecoderRunner measures how long it takes to decode a 1024x1024 image of
+// a given format, optionally drawn as a smaller thumbnail. The images are
+// generated on the fly, and each run loads them from a new blob URL so that
+// no decoded pixels are reused.
+(function () {
+    var SIZE = 1024;
+
+    // Deterministic noise, so that every run decodes the same image and the
+    // encoders can't compress it away.
+    var seed = 1;
+    function random() {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed >> 16;
+    }
+
+    function createPixels(context, opaque) {
+        var imageData = context.createImageData(SIZE, SIZE);
+        var data = imageData.data;
+        for (var y = 0; y < SIZE; ++y) {
+            for (var x = 0; x < SIZE; ++x) {
+                var i = (y * SIZE + x) * 4;
+                data[i] = (x >> 2) + (random() & 15);
+                data[i + 1] = (y >> 2) + (random() & 15);
+                data[i + 2] = ((x + y) >> 3) + (random() & 15);
+                data[i + 3] = opaque ? 255 : 128 + ((x ^ y) & 127);
+            }
+        }
+        return imageData;
+    }
+
+    function encodeWithCanvas(type, opaque) {
+        var canvas = document.createElement("canvas");
+        canvas.width = SIZE;
+        canvas.height = SIZE;
+        var context = canvas.getContext("2d");
+        context.putImageData(createPixels(context, opaque), 0, 0);
+        var binary = atob(canvas.toDataURL(type, 0.9).split(",")[1]);
+        var bytes = new Uint8Array(binary.length);
+        for (var i = 0; i < binary.length; ++i)
+            bytes[i] = binary.charCodeAt(i);
+        return bytes;
+    }
+
+    // Writes a 256 color GIF whose index 0 is transparent. The LZW data is
+    // left uncompressed: 9 bit literal codes with a clear code often enough
+    // that the code size never grows.
+    function encodeGIF() {
+        var bytes = [];
+        function writeShort(value) {
+            bytes.push(value & 255, value >> 8);
+        }
+
+        bytes.push(0x47, 0x49, 0x46, 0x38, 0x39, 0x61); // GIF89a
+        writeShort(SIZE);
+        writeShort(SIZE);
+        bytes.push(0xf7, 0, 0); // Global color table of 256 entries.
+        for (var i = 0; i < 256; ++i)
+            bytes.push(i, 255 - i, (i * 7) & 255);
+        bytes.push(0x21, 0xf9, 4, 1, 0, 0, 0, 0); // Index 0 is transparent.
+        bytes.push(0x2c);
+        writeShort(0);
+        writeShort(0);
+        writeShort(SIZE);
+        writeShort(SIZE);
+        bytes.push(0);
+
+        var CLEAR = 256;
+        var END = 257;
+        var codes = [];
+        for (var y = 0; y < SIZE; ++y) {
+            for (var x = 0; x < SIZE; ++x) {
+                if (!(codes.length % 250))
+                    codes.push(CLEAR);
+                codes.push(((x >> 2) + (y >> 2) + (random() & 7)) & 255);
+            }
+        }
+        codes.push(END);
+
+        var data = [];
+        var bits = 0;
+        var bitCount = 0;
+        for (var i = 0; i < codes.length; ++i) {
+            bits |= codes[i] << bitCount;
+            bitCount += 9;
+            while (bitCount >= 8) {
+                data.push(bits & 255);
+                bits >>= 8;
+                bitCount -= 8;
+            }
+        }
+        if (bitCount)
+            data.push(bits & 255);
+
+        bytes.push(8); // LZW minimum code size.
+        for (var i = 0; i < data.length; i += 255) {
+            var block = data.slice(i, i + 255);
+            bytes.push(block.length);
+            Array.prototype.push.apply(bytes, block);
+        }
+        bytes.push(0, 0x3b);
+        return new Uint8Array(bytes);
+    }
+
+    var ImageDecoderRunner = {};
+
+    // |format| is one of "png", "jpeg" or "gif". |drawSize| is the width and
+    // height the image is drawn at, the full size by default.
+    ImageDecoderRunner.start = function (format, drawSize) {
+        drawSize = drawSize || SIZE;
+        var bytes;
+        if (format == "gif")
+            bytes = encodeGIF();
+        else
+            bytes = encodeWithCanvas("image/" + format, format == "jpeg");
+        var type = "image/" + format;
+
+        var canvas = document.createElement("canvas");
+        canvas.width = drawSize;
+        canvas.height = drawSize;
+        var context = canvas.getContext("2d");
+
+        var isDone = false;
+        PerfTestRunner.prepareToMeasureValuesAsync({
+            description: "Measures the time it takes to decode and draw a 1024x1024 (1M pixel) " + format.toUpperCase() + " image"
+                + (drawSize == SIZE ? "." : " as a " + drawSize + "x" + drawSize + " thumbnail."),
+            unit: "ms",
+            done: function () { isDone = true; }
+        });
+
+        function decodeOnce() {
+            var url = URL.createObjectURL(new Blob([bytes], {type: type}));
+            var image = new Image();
+            image.onload = function () {
+                // Drawing at the natural size decodes the whole image, and
+                // reading a pixel back makes sure the draw isn't deferred.
+                // Thumbnails may be decoded at a reduced size.
+                var start = PerfTestRunner.now();
+                context.drawImage(image, 0, 0, drawSize, drawSize);
+                context.getImageData(0, 0, 1, 1);
+                var time = PerfTestRunner.now() - start;
+                URL.revokeObjectURL(url);
+                PerfTestRunner.measureValueAsync(time);
+                if (!isDone)
+                    setTimeout(decodeOnce, 0);
+            };
+            image.src = url;
+        }
+        decodeOnce();
+    }
+
+    window.ImageDecoderRunner = ImageDecoderRunner;
+})();
@@ -0,0 +1,33 @@
+(function() {
+    // Builds a gallery of floated thumbnails with captions and text wrapping
+    // around them, the way image galleries are commonly laid out.
+    function createGallery(floatCount) {
+        var container = document.createElement("div");
+        container.className = "gallery";
+        for (var i = 0; i < floatCount; ++i) {
+            var item = document.createElement("div");
+            item.className = i % 7 ? "thumbnail" : "thumbnail right";
+            item.style.height = (40 + (i * 37) % 60) + "px";
+            container.appendChild(item);
+            if (!(i % 5))
+                container.appendChild(document.createTextNode("Photo " + i + " was taken on a long walk along the coast. "));
+        }
+        document.body.appendChild(container);
+        return container;
+    }
+
+    function createTestFunction(floatCount) {
+        var container = createGallery(floatCount);
+        var widths = ["600px", "750px", "900px"];
+        return function() {
+            container.style.display = "block";
+            for (var i = 0; i < widths.length; ++i) {
+                container.style.width = widths[i];
+                PerfTestRunner.forceLayoutOrFullFrame();
+            }
+            container.style.display = "none";
+        };
+    }
+
+    window.createFloatGalleryTestFunction = createTestFunction;
+})();
@@ -0,0 +1,27 @@
+(function() {
+    // Builds a data grid of auto-placed cells in content-sized tracks, and
+    // returns a test function that relayouts it at a different width.
+    function createGridDataTestFunction(rows, columns) {
+        var grid = document.createElement("div");
+        grid.className = "data-grid";
+        grid.style.gridTemplateColumns = "repeat(" + columns + ", minmax(min-content, max-content))";
+        grid.style.gridAutoRows = "auto";
+        for (var row = 0; row < rows; ++row) {
+            for (var column = 0; column < columns; ++column) {
+                var cell = document.createElement("div");
+                cell.textContent = "Item " + row + "." + column + (column % 3 ? "" : " with a longer label");
+                grid.appendChild(cell);
+            }
+        }
+        document.body.appendChild(grid);
+        PerfTestRunner.forceLayoutOrFullFrame();
+
+        var index = 0;
+        return function() {
+            grid.style.width = ++index % 2 ? "99%" : "98%";
+            PerfTestRunner.forceLayoutOrFullFrame();
+        };
+    }
+
+    window.createGridDataTestFunction = createGridDataTestFunction;
+})();
@@ -4466,6 +4466,36 @@ template<> inline CSSPrimitiveValue::operator EIsolation() const
     return IsolationAuto;
 }
 
+template<> inline CSSPrimitiveValue::CSSPrimitiveValue(EContain contain)
+    : CSSValue(PrimitiveClass)
+{
+    m_primitiveUnitType = CSS_VALUE_ID;
+    switch (contain) {
+    case ContainNone:
+        m_value.valueID = CSSValueNone;
+        break;
+    case ContainStrict:
+        m_value.valueID = CSSValueStrict;
+        break;
+    }
+}
+
+template<> inline CSSPrimitiveValue::operator EContain() const
+{
+    ASSERT(isValueID());
+    switch (m_value.valueID) {
+    case CSSValueNone:
+        return ContainNone;
+    case CSSValueStrict:
+        return ContainStrict;
+    default:
+        break;
+    }
+
+    ASSERT_NOT_REACHED();
+    return ContainNone;
+}
+
 template<> inline CSSPrimitiveValue::operator ScrollBlocksOn() const
 {
     switch (m_value.valueID) {
@@ -37,6 +37,7 @@
 #include "core/css/StylePropertySet.h"
 #include "core/css/StyleRule.h"
 #include "core/css/invalidation/DescendantInvalidationSet.h"
+#include "core/css/invalidation/SiblingInvalidationSet.h"
 #include "core/dom/Element.h"
 #include "core/dom/Node.h"
 #include "core/inspector/InspectorTraceEvents.h"
@@ -286,6 +287,7 @@ void RuleFeatureSet::updateInvalidationSets(const RuleData& ruleData)
     auto result = extractInvalidationSetFeatures(ruleData.selector(), features, false);
     if (result.first) {
         features.forceSubtree = result.second == ForceSubtree;
+        features.maxDirectAdjacentSelectors = maxDirectAdjacentSelectorsForSiblingInvalidation(ruleData.selector(), features);
         addFeaturesToInvalidationSets(*result.first, features);
     }
 
@@ -366,10 +368,37 @@ RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, Inva
     return std::make_pair(nullptr,  foundFeatures ? UseFeatures : ForceSubtree);
 }
 
+// If the rightmost compound selector is preceded by an adjacent combinator, as in ".a + .b"
+// or ".a ~ .b", return the number of following siblings which need to be checked when a
+// feature of the compound selector left of the combinator changes. Return 0 if the features
+// cannot be used for sibling invalidation.
+unsigned RuleFeatureSet::maxDirectAdjacentSelectorsForSiblingInvalidation(const CSSSelector& selector, const InvalidationSetFeatures& features)
+{
+    if (!features.adjacent || features.treeBoundaryCrossing || features.insertionPointCrossing || features.customPseudoElement)
+        return 0;
+
+    const CSSSelector* current = &selector;
+    while (current->relation() == CSSSelector::SubSelector)
+        current = current->tagHistory();
+    ASSERT(current->isAdjacentSelector());
+
+    for (const CSSSelector* sibling = current->tagHistory(); sibling; sibling = sibling->tagHistory()) {
+        if (sibling->isTreeBoundaryCrossing() || sibling->isInsertionPointCrossing())
+            return 0;
+        if (sibling->relation() != CSSSelector::SubSelector)
+            break;
+    }
+    return current->isDirectAdjacentSelector() ? 1 : SiblingInvalidationSet::DirectAdjacentMax;
+}
+
 // Add features extracted from the rightmost compound selector to descendant invalidation
 // sets for features found in other compound selectors.
 //
-// Style invalidation is currently supported for descendants only, not for sibling subtrees.
+// Features found in the compound selector directly left of an adjacent combinator which
+// precedes the rightmost compound selector are added to sibling invalidation sets, so that
+// only the following siblings which match the rightmost compound are invalidated.
+//
+// Otherwise, style invalidation is supported for descendants only, not for sibling subtrees.
 // We use wholeSubtree invalidation for features found left of adjacent combinators as
 // SubtreeStyleChange will force sibling subtree recalc in
 // ContainerNode::checkForChildrenAdjacentRuleChanges.
@@ -380,6 +409,10 @@ RuleFeatureSet::extractInvalidationSetFeatures(const CSSSelector& selector, Inva
 
 void RuleFeatureSet::addFeaturesToInvalidationSet(DescendantInvalidationSet& invalidationSet, const InvalidationSetFeatures& features)
 {
+    if (features.maxDirectAdjacentSelectors) {
+        addFeaturesToSiblingInvalidationSet(invalidationSet, features);
+        return;
+    }
     if (features.treeBoundaryCrossing)
         invalidationSet.setTreeBoundaryCrossing();
     if (features.insertionPointCrossing)
@@ -400,6 +433,26 @@ void RuleFeatureSet::addFeaturesToInvalidationSet(DescendantInvalidationSet& inv
         invalidationSet.setCustomPseudoInvalid();
 }
 
+void RuleFeatureSet::addFeaturesToSiblingInvalidationSet(DescendantInvalidationSet& invalidationSet, const InvalidationSetFeatures& features)
+{
+    SiblingInvalidationSet& siblingInvalidationSet = invalidationSet.ensureSiblingInvalidationSet();
+    siblingInvalidationSet.updateMaxDirectAdjacentSelectors(features.maxDirectAdjacentSelectors);
+
+    DescendantInvalidationSet& siblingFeatures = siblingInvalidationSet.siblingFeatures();
+    if (features.forceSubtree) {
+        siblingFeatures.setWholeSubtreeInvalid();
+        return;
+    }
+    if (!features.id.isEmpty())
+        siblingFeatures.addId(features.id);
+    if (!features.tagName.isEmpty())
+        siblingFeatures.addTagName(features.tagName);
+    for (const auto& className : features.classes)
+        siblingFeatures.addClass(className);
+    for (const auto& attribute : features.attributes)
+        siblingFeatures.addAttribute(attribute);
+}
+
 void RuleFeatureSet::addFeaturesToInvalidationSets(const CSSSelector& selector, InvalidationSetFeatures& features)
 {
     for (const CSSSelector* current = &selector; current; current = current->tagHistory()) {
@@ -424,6 +477,7 @@ void RuleFeatureSet::addFeaturesToInvalidationSets(const CSSSelector& selector,
             features.treeBoundaryCrossing = true;
 
         features.adjacent = current->isAdjacentSelector();
+        features.maxDirectAdjacentSelectors = 0;
     }
 }
 
@@ -91,6 +91,8 @@ public:
         return m_idInvalidationSets.size() > 0;
     }
 
+    DescendantInvalidationSet* classInvalidationSetForTesting(const AtomicString& className) const { return m_classInvalidationSets.get(className); }
+
     StyleInvalidator& styleInvalidator();
 
     void trace(Visitor*);
@@ -137,6 +139,7 @@ private:
             , adjacent(false)
             , insertionPointCrossing(false)
             , forceSubtree(false)
+            , maxDirectAdjacentSelectors(0)
         { }
 
         bool useSubtreeInvalidation() const { return forceSubtree || adjacent; }
@@ -151,6 +154,10 @@ private:
         bool adjacent;
         bool insertionPointCrossing;
         bool forceSubtree;
+        // Non-zero while adding features to the compound selector directly
+        // left of an adjacent combinator. The features are then added to
+        // sibling invalidation sets instead of invalidating the whole subtree.
+        unsigned maxDirectAdjacentSelectors;
     };
 
     static bool extractInvalidationSetFeature(const CSSSelector&, InvalidationSetFeatures&);
@@ -159,7 +166,10 @@ private:
 
     std::pair<const CSSSelector*, UseFeaturesType> extractInvalidationSetFeatures(const CSSSelector&, InvalidationSetFeatures&, bool negated);
 
+    static unsigned maxDirectAdjacentSelectorsForSiblingInvalidation(const CSSSelector&, const InvalidationSetFeatures&);
+
     void addFeaturesToInvalidationSet(DescendantInvalidationSet&, const InvalidationSetFeatures&);
+    void addFeaturesToSiblingInvalidationSet(DescendantInvalidationSet&, const InvalidationSetFeatures&);
     void addFeaturesToInvalidationSets(const CSSSelector&, InvalidationSetFeatures&);
 
     void addClassToInvalidationSet(const AtomicString& className, Element&);
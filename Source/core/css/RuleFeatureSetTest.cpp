@@ -0,0 +1,117 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/css/RuleFeature.h"
+
+#include "core/HTMLNames.h"
+#include "core/css/CSSTestHelper.h"
+#include "core/css/RuleSet.h"
+#include "core/css/invalidation/DescendantInvalidationSet.h"
+#include "core/css/invalidation/SiblingInvalidationSet.h"
+#include "core/dom/Document.h"
+#include "core/dom/Element.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class RuleFeatureSetTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_document = Document::create();
+    }
+
+    DescendantInvalidationSet* classInvalidationSet(const char* ruleText, const char* className)
+    {
+        m_helper.addCSSRules(ruleText);
+        return m_helper.ruleSet().features().classInvalidationSetForTesting(className);
+    }
+
+    PassRefPtrWillBeRawPtr<Element> elementWithClass(const char* className)
+    {
+        RefPtrWillBeRawPtr<Element> element = m_document->createElement("div", nullAtom, ASSERT_NO_EXCEPTION);
+        element->setAttribute(HTMLNames::classAttr, className);
+        return element.release();
+    }
+
+    CSSTestHelper m_helper;
+    RefPtrWillBePersistent<Document> m_document;
+};
+
+TEST_F(RuleFeatureSetTest, DirectAdjacent)
+{
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a + .b { }", "a");
+    ASSERT_TRUE(invalidationSet);
+    EXPECT_FALSE(invalidationSet->wholeSubtreeInvalid());
+    EXPECT_FALSE(invalidationSet->isEmpty());
+
+    SiblingInvalidationSet* siblingInvalidationSet = invalidationSet->siblingInvalidationSet();
+    ASSERT_TRUE(siblingInvalidationSet);
+    EXPECT_EQ(1u, siblingInvalidationSet->maxDirectAdjacentSelectors());
+    EXPECT_TRUE(siblingInvalidationSet->invalidatesElement(*elementWithClass("b")));
+    EXPECT_FALSE(siblingInvalidationSet->invalidatesElement(*elementWithClass("c")));
+
+    // The descendants of the element with class "a" are not affected.
+    EXPECT_FALSE(invalidationSet->invalidatesElement(*elementWithClass("b")));
+}
+
+TEST_F(RuleFeatureSetTest, IndirectAdjacent)
+{
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a ~ .b { }", "a");
+    ASSERT_TRUE(invalidationSet);
+    EXPECT_FALSE(invalidationSet->wholeSubtreeInvalid());
+
+    SiblingInvalidationSet* siblingInvalidationSet = invalidationSet->siblingInvalidationSet();
+    ASSERT_TRUE(siblingInvalidationSet);
+    EXPECT_EQ(SiblingInvalidationSet::DirectAdjacentMax, siblingInvalidationSet->maxDirectAdjacentSelectors());
+    EXPECT_TRUE(siblingInvalidationSet->invalidatesElement(*elementWithClass("b")));
+}
+
+TEST_F(RuleFeatureSetTest, AdjacentCombinedWithIndirectAdjacent)
+{
+    m_helper.addCSSRules(".a + .b { }");
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a ~ .c { }", "a");
+    ASSERT_TRUE(invalidationSet);
+
+    SiblingInvalidationSet* siblingInvalidationSet = invalidationSet->siblingInvalidationSet();
+    ASSERT_TRUE(siblingInvalidationSet);
+    EXPECT_EQ(SiblingInvalidationSet::DirectAdjacentMax, siblingInvalidationSet->maxDirectAdjacentSelectors());
+    EXPECT_TRUE(siblingInvalidationSet->invalidatesElement(*elementWithClass("b")));
+    EXPECT_TRUE(siblingInvalidationSet->invalidatesElement(*elementWithClass("c")));
+}
+
+TEST_F(RuleFeatureSetTest, AdjacentUniversal)
+{
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a + * { }", "a");
+    ASSERT_TRUE(invalidationSet);
+    EXPECT_FALSE(invalidationSet->wholeSubtreeInvalid());
+
+    SiblingInvalidationSet* siblingInvalidationSet = invalidationSet->siblingInvalidationSet();
+    ASSERT_TRUE(siblingInvalidationSet);
+    EXPECT_TRUE(siblingInvalidationSet->siblingFeatures().wholeSubtreeInvalid());
+    EXPECT_TRUE(siblingInvalidationSet->invalidatesElement(*elementWithClass("c")));
+}
+
+// Only the compound selector directly left of the rightmost one can use
+// sibling invalidation. Otherwise the siblings' subtrees are invalidated.
+TEST_F(RuleFeatureSetTest, AdjacentFollowedByDescendant)
+{
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a + .b .c { }", "a");
+    ASSERT_TRUE(invalidationSet);
+    EXPECT_TRUE(invalidationSet->wholeSubtreeInvalid());
+    EXPECT_FALSE(invalidationSet->siblingInvalidationSet());
+}
+
+TEST_F(RuleFeatureSetTest, NoSiblingInvalidationForDescendants)
+{
+    DescendantInvalidationSet* invalidationSet = classInvalidationSet(".a .b { }", "a");
+    ASSERT_TRUE(invalidationSet);
+    EXPECT_FALSE(invalidationSet->siblingInvalidationSet());
+    EXPECT_TRUE(invalidationSet->invalidatesElement(*elementWithClass("b")));
+}
+
+} // namespace
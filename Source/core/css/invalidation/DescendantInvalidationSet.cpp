@@ -98,6 +98,11 @@ bool DescendantInvalidationSet::invalidatesElement(Element& element) const
 
 void DescendantInvalidationSet::combine(const DescendantInvalidationSet& other)
 {
+    // Sibling invalidation is independent of whether the whole subtree of the
+    // element is invalid, so combine it first.
+    if (other.m_siblingInvalidationSet)
+        ensureSiblingInvalidationSet().combine(*other.m_siblingInvalidationSet);
+
     // No longer bother combining data structures, since the whole subtree is deemed invalid.
     if (wholeSubtreeInvalid())
         return;
@@ -165,6 +170,13 @@ WillBeHeapHashSet<AtomicString>& DescendantInvalidationSet::ensureAttributeSet()
     return *m_attributes;
 }
 
+SiblingInvalidationSet& DescendantInvalidationSet::ensureSiblingInvalidationSet()
+{
+    if (!m_siblingInvalidationSet)
+        m_siblingInvalidationSet = SiblingInvalidationSet::create();
+    return *m_siblingInvalidationSet;
+}
+
 void DescendantInvalidationSet::addClass(const AtomicString& className)
 {
     if (wholeSubtreeInvalid())
@@ -214,6 +226,7 @@ void DescendantInvalidationSet::trace(Visitor* visitor)
     visitor->trace(m_ids);
     visitor->trace(m_tagNames);
     visitor->trace(m_attributes);
+    visitor->trace(m_siblingInvalidationSet);
 #endif
 }
 
@@ -260,6 +273,12 @@ void DescendantInvalidationSet::toTracedValue(TracedValue* value) const
         value->endArray();
     }
 
+    if (m_siblingInvalidationSet) {
+        value->beginArray("siblings");
+        m_siblingInvalidationSet->toTracedValue(value);
+        value->endArray();
+    }
+
     value->endDictionary();
 }
 
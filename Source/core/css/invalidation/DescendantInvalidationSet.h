@@ -31,6 +31,7 @@
 #ifndef DescendantInvalidationSet_h
 #define DescendantInvalidationSet_h
 
+#include "core/css/invalidation/SiblingInvalidationSet.h"
 #include "platform/heap/Handle.h"
 #include "wtf/Forward.h"
 #include "wtf/HashSet.h"
@@ -76,7 +77,12 @@ public:
     void setCustomPseudoInvalid() { m_customPseudoInvalid = true; }
     bool customPseudoInvalid() const { return m_customPseudoInvalid; }
 
-    bool isEmpty() const { return !m_classes && !m_ids && !m_tagNames && !m_attributes; }
+    bool isEmpty() const { return !m_classes && !m_ids && !m_tagNames && !m_attributes && !m_siblingInvalidationSet; }
+
+    // Invalidation of the following siblings of the element this set is
+    // scheduled on. Null if no sibling rules depend on the feature.
+    SiblingInvalidationSet* siblingInvalidationSet() const { return m_siblingInvalidationSet.get(); }
+    SiblingInvalidationSet& ensureSiblingInvalidationSet();
 
     void trace(Visitor*);
 
@@ -100,6 +106,8 @@ private:
     OwnPtrWillBeMember<WillBeHeapHashSet<AtomicString> > m_tagNames;
     OwnPtrWillBeMember<WillBeHeapHashSet<AtomicString> > m_attributes;
 
+    RefPtrWillBeMember<SiblingInvalidationSet> m_siblingInvalidationSet;
+
     // If true, all descendants might be invalidated, so a full subtree recalc is required.
     unsigned m_allDescendantsMightBeInvalid : 1;
 
@@ -61,6 +61,36 @@ TEST(DescendantInvalidationSetTest, SubtreeInvalid_Combine_2)
     ASSERT_TRUE(set1->isEmpty());
 }
 
+// Sibling invalidation sets survive combining with a wholeSubtreeInvalid set.
+TEST(DescendantInvalidationSetTest, SiblingInvalidation_Combine_SubtreeInvalid)
+{
+    RefPtrWillBeRawPtr<DescendantInvalidationSet> set1 = DescendantInvalidationSet::create();
+    RefPtrWillBeRawPtr<DescendantInvalidationSet> set2 = DescendantInvalidationSet::create();
+
+    set1->setWholeSubtreeInvalid();
+    set2->ensureSiblingInvalidationSet().siblingFeatures().addClass("a");
+
+    set1->combine(*set2);
+
+    ASSERT_TRUE(set1->wholeSubtreeInvalid());
+    ASSERT_TRUE(set1->siblingInvalidationSet());
+    ASSERT_FALSE(set1->siblingInvalidationSet()->siblingFeatures().isEmpty());
+}
+
+// Combining sibling invalidation sets keeps the largest sibling distance.
+TEST(DescendantInvalidationSetTest, SiblingInvalidation_Combine_MaxDirectAdjacentSelectors)
+{
+    RefPtrWillBeRawPtr<DescendantInvalidationSet> set1 = DescendantInvalidationSet::create();
+    RefPtrWillBeRawPtr<DescendantInvalidationSet> set2 = DescendantInvalidationSet::create();
+
+    set1->ensureSiblingInvalidationSet().updateMaxDirectAdjacentSelectors(1);
+    set2->ensureSiblingInvalidationSet().updateMaxDirectAdjacentSelectors(SiblingInvalidationSet::DirectAdjacentMax);
+
+    set1->combine(*set2);
+
+    ASSERT_EQ(SiblingInvalidationSet::DirectAdjacentMax, set1->siblingInvalidationSet()->maxDirectAdjacentSelectors());
+}
+
 #ifndef NDEBUG
 TEST(DescendantInvalidationSetTest, ShowDebug)
 {
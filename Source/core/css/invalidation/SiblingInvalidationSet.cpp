@@ -0,0 +1,50 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/css/invalidation/SiblingInvalidationSet.h"
+
+#include "core/css/invalidation/DescendantInvalidationSet.h"
+#include "platform/TracedValue.h"
+
+namespace blink {
+
+SiblingInvalidationSet::SiblingInvalidationSet()
+    : m_siblingFeatures(DescendantInvalidationSet::create())
+    , m_maxDirectAdjacentSelectors(1)
+{
+}
+
+bool SiblingInvalidationSet::invalidatesElement(Element& element) const
+{
+    return m_siblingFeatures->invalidatesElement(element);
+}
+
+void SiblingInvalidationSet::combine(const SiblingInvalidationSet& other)
+{
+    m_siblingFeatures->combine(*other.m_siblingFeatures);
+    updateMaxDirectAdjacentSelectors(other.m_maxDirectAdjacentSelectors);
+}
+
+void SiblingInvalidationSet::trace(Visitor* visitor)
+{
+#if ENABLE(OILPAN)
+    visitor->trace(m_siblingFeatures);
+#endif
+}
+
+void SiblingInvalidationSet::toTracedValue(TracedValue* value) const
+{
+    value->beginDictionary();
+    if (m_maxDirectAdjacentSelectors == DirectAdjacentMax)
+        value->setBoolean("indirectAdjacent", true);
+    else
+        value->setInteger("maxDirectAdjacentSelectors", m_maxDirectAdjacentSelectors);
+    value->beginArray("siblingFeatures");
+    m_siblingFeatures->toTracedValue(value);
+    value->endArray();
+    value->endDictionary();
+}
+
+} // namespace blink
@@ -0,0 +1,58 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SiblingInvalidationSet_h
+#define SiblingInvalidationSet_h
+
+#include "platform/heap/Handle.h"
+#include "wtf/RefCounted.h"
+#include "wtf/RefPtr.h"
+
+namespace blink {
+
+class DescendantInvalidationSet;
+class Element;
+class TracedValue;
+
+// Tracks data to determine which of the following siblings of an element need
+// to have style recalculated when a feature of that element changes, as in
+// ".a + .b" or ".a ~ .b" when the class "a" is toggled.
+//
+// The features of the siblings which may be affected are collected in a
+// DescendantInvalidationSet. If that set is wholeSubtreeInvalid(), every
+// sibling within reach is invalidated.
+class SiblingInvalidationSet final : public RefCountedWillBeGarbageCollected<SiblingInvalidationSet> {
+public:
+    static PassRefPtrWillBeRawPtr<SiblingInvalidationSet> create()
+    {
+        return adoptRefWillBeNoop(new SiblingInvalidationSet);
+    }
+
+    static const unsigned DirectAdjacentMax = UINT_MAX;
+
+    bool invalidatesElement(Element&) const;
+
+    void combine(const SiblingInvalidationSet& other);
+
+    DescendantInvalidationSet& siblingFeatures() { return *m_siblingFeatures; }
+
+    // The number of following siblings which need to be checked. For indirect
+    // adjacent combinators this is DirectAdjacentMax.
+    unsigned maxDirectAdjacentSelectors() const { return m_maxDirectAdjacentSelectors; }
+    void updateMaxDirectAdjacentSelectors(unsigned value) { m_maxDirectAdjacentSelectors = std::max(value, m_maxDirectAdjacentSelectors); }
+
+    void trace(Visitor*);
+
+    void toTracedValue(TracedValue*) const;
+
+private:
+    SiblingInvalidationSet();
+
+    RefPtrWillBeMember<DescendantInvalidationSet> m_siblingFeatures;
+    unsigned m_maxDirectAdjacentSelectors;
+};
+
+} // namespace blink
+
+#endif // SiblingInvalidationSet_h
@@ -8,6 +8,7 @@
 #include "core/css/invalidation/StyleInvalidator.h"
 
 #include "core/css/invalidation/DescendantInvalidationSet.h"
+#include "core/css/invalidation/SiblingInvalidationSet.h"
 #include "core/dom/Document.h"
 #include "core/dom/Element.h"
 #include "core/dom/ElementTraversal.h"
@@ -33,8 +34,9 @@ static const unsigned char* s_tracingEnabled = nullptr;
 void StyleInvalidator::invalidate(Document& document)
 {
     RecursionData recursionData;
+    SiblingData siblingData;
     if (Element* documentElement = document.documentElement())
-        invalidate(*documentElement, recursionData);
+        invalidate(*documentElement, recursionData, siblingData);
     document.clearChildNeedsStyleInvalidation();
     document.clearNeedsStyleInvalidation();
     clearPendingInvalidations();
@@ -119,7 +121,36 @@ ALWAYS_INLINE bool StyleInvalidator::RecursionData::matchesCurrentInvalidationSe
     return false;
 }
 
-ALWAYS_INLINE bool StyleInvalidator::checkInvalidationSetsAgainstElement(Element& element, StyleInvalidator::RecursionData& recursionData)
+void StyleInvalidator::SiblingData::pushInvalidationSet(const SiblingInvalidationSet& invalidationSet)
+{
+    unsigned invalidationLimit;
+    if (invalidationSet.maxDirectAdjacentSelectors() == SiblingInvalidationSet::DirectAdjacentMax)
+        invalidationLimit = UINT_MAX;
+    else
+        invalidationLimit = m_elementIndex + invalidationSet.maxDirectAdjacentSelectors();
+    m_invalidationEntries.append(Entry(&invalidationSet, invalidationLimit));
+}
+
+ALWAYS_INLINE bool StyleInvalidator::SiblingData::matchCurrentInvalidationSets(Element& element)
+{
+    bool thisElementNeedsStyleRecalc = false;
+    size_t index = 0;
+    while (index < m_invalidationEntries.size()) {
+        if (m_elementIndex > m_invalidationEntries[index].m_invalidationLimit) {
+            // This entry no longer reaches the current sibling. Order is irrelevant,
+            // so move the last entry into its place.
+            m_invalidationEntries[index] = m_invalidationEntries.last();
+            m_invalidationEntries.removeLast();
+            continue;
+        }
+        if (!thisElementNeedsStyleRecalc && m_invalidationEntries[index].m_invalidationSet->invalidatesElement(element))
+            thisElementNeedsStyleRecalc = true;
+        ++index;
+    }
+    return thisElementNeedsStyleRecalc;
+}
+
+ALWAYS_INLINE bool StyleInvalidator::checkInvalidationSetsAgainstElement(Element& element, StyleInvalidator::RecursionData& recursionData, StyleInvalidator::SiblingData& siblingData)
 {
     if (element.styleChangeType() >= SubtreeStyleChange || recursionData.wholeSubtreeInvalid()) {
         recursionData.setWholeSubtreeInvalid();
@@ -127,8 +158,11 @@ ALWAYS_INLINE bool StyleInvalidator::checkInvalidationSetsAgainstElement(Element
     }
     if (element.needsStyleInvalidation()) {
         if (InvalidationList* invalidationList = m_pendingInvalidationMap.get(&element)) {
-            for (const auto& invalidationSet : *invalidationList)
+            for (const auto& invalidationSet : *invalidationList) {
                 recursionData.pushInvalidationSet(*invalidationSet);
+                if (SiblingInvalidationSet* siblingInvalidationSet = invalidationSet->siblingInvalidationSet())
+                    siblingData.pushInvalidationSet(*siblingInvalidationSet);
+            }
             if (UNLIKELY(*s_tracingEnabled)) {
                 TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("devtools.timeline.invalidationTracking"),
                     "StyleInvalidatorInvalidationTracking",
@@ -138,6 +172,9 @@ ALWAYS_INLINE bool StyleInvalidator::checkInvalidationSetsAgainstElement(Element
         }
     }
 
+    if (siblingData.hasInvalidationSets() && siblingData.matchCurrentInvalidationSets(element))
+        return true;
+
     return recursionData.matchesCurrentInvalidationSets(element);
 }
 
@@ -147,25 +184,27 @@ bool StyleInvalidator::invalidateChildren(Element& element, StyleInvalidator::Re
     for (ShadowRoot* root = element.youngestShadowRoot(); root; root = root->olderShadowRoot()) {
         if (!recursionData.treeBoundaryCrossing() && !root->childNeedsStyleInvalidation() && !root->needsStyleInvalidation())
             continue;
+        SiblingData siblingData;
         for (Element* child = ElementTraversal::firstChild(*root); child; child = ElementTraversal::nextSibling(*child)) {
-            bool childRecalced = invalidate(*child, recursionData);
+            bool childRecalced = invalidate(*child, recursionData, siblingData);
             someChildrenNeedStyleRecalc = someChildrenNeedStyleRecalc || childRecalced;
         }
         root->clearChildNeedsStyleInvalidation();
         root->clearNeedsStyleInvalidation();
     }
+    SiblingData siblingData;
     for (Element* child = ElementTraversal::firstChild(element); child; child = ElementTraversal::nextSibling(*child)) {
-        bool childRecalced = invalidate(*child, recursionData);
+        bool childRecalced = invalidate(*child, recursionData, siblingData);
         someChildrenNeedStyleRecalc = someChildrenNeedStyleRecalc || childRecalced;
     }
     return someChildrenNeedStyleRecalc;
 }
 
-bool StyleInvalidator::invalidate(Element& element, StyleInvalidator::RecursionData& recursionData)
+bool StyleInvalidator::invalidate(Element& element, StyleInvalidator::RecursionData& recursionData, StyleInvalidator::SiblingData& siblingData)
 {
     RecursionCheckpoint checkpoint(&recursionData);
 
-    bool thisElementNeedsStyleRecalc = checkInvalidationSetsAgainstElement(element, recursionData);
+    bool thisElementNeedsStyleRecalc = checkInvalidationSetsAgainstElement(element, recursionData, siblingData);
 
     bool someChildrenNeedStyleRecalc = false;
     if (recursionData.hasInvalidationSets() || element.childNeedsStyleInvalidation())
@@ -188,6 +227,7 @@ bool StyleInvalidator::invalidate(Element& element, StyleInvalidator::RecursionD
 
     element.clearChildNeedsStyleInvalidation();
     element.clearNeedsStyleInvalidation();
+    siblingData.advance();
 
     return thisElementNeedsStyleRecalc;
 }
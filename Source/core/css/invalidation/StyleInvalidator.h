@@ -12,6 +12,7 @@ namespace blink {
 class DescendantInvalidationSet;
 class Document;
 class Element;
+class SiblingInvalidationSet;
 
 class StyleInvalidator {
     DISALLOW_ALLOCATION();
@@ -55,9 +56,39 @@ private:
         bool m_insertionPointCrossing;
     };
 
-    bool invalidate(Element&, RecursionData&);
+    // Tracks the sibling invalidation sets scheduled on preceding siblings
+    // while the children of an element are traversed.
+    class SiblingData {
+        STACK_ALLOCATED();
+    public:
+        SiblingData()
+            : m_elementIndex(0)
+        { }
+
+        void pushInvalidationSet(const SiblingInvalidationSet&);
+        bool matchCurrentInvalidationSets(Element&);
+        bool hasInvalidationSets() const { return !m_invalidationEntries.isEmpty(); }
+
+        void advance() { m_elementIndex++; }
+
+    private:
+        struct Entry {
+            Entry(const SiblingInvalidationSet* invalidationSet, unsigned invalidationLimit)
+                : m_invalidationSet(invalidationSet)
+                , m_invalidationLimit(invalidationLimit)
+            { }
+
+            const SiblingInvalidationSet* m_invalidationSet;
+            unsigned m_invalidationLimit;
+        };
+
+        Vector<Entry, 16> m_invalidationEntries;
+        unsigned m_elementIndex;
+    };
+
+    bool invalidate(Element&, RecursionData&, SiblingData&);
     bool invalidateChildren(Element&, RecursionData&);
-    bool checkInvalidationSetsAgainstElement(Element&, RecursionData&);
+    bool checkInvalidationSetsAgainstElement(Element&, RecursionData&, SiblingData&);
 
     class RecursionCheckpoint {
     public:
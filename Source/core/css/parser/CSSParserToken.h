@@ -77,34 +77,38 @@ public:
     // Converts NumberToken to PercentageToken.
     void convertToPercentage();
 
-    CSSParserTokenType type() const { return m_type; }
+    CSSParserTokenType type() const { return static_cast<CSSParserTokenType>(m_type); }
     String value() const { return m_value; }
 
     UChar delimiter() const;
     NumericValueType numericValueType() const;
     double numericValue() const;
-    HashTokenType hashTokenType() const { ASSERT(m_type == HashToken); return m_hashTokenType; }
-    BlockType blockType() const { return m_blockType; }
-    CSSPrimitiveValue::UnitType unitType() const { return m_unit; }
-    UChar32 unicodeRangeStart() const { ASSERT(m_type == UnicodeRangeToken); return m_unicodeRangeStart; }
-    UChar32 unicodeRangeEnd() const { ASSERT(m_type == UnicodeRangeToken); return m_unicodeRangeEnd; }
+    HashTokenType hashTokenType() const { ASSERT(m_type == HashToken); return static_cast<HashTokenType>(m_hashTokenType); }
+    BlockType blockType() const { return static_cast<BlockType>(m_blockType); }
+    CSSPrimitiveValue::UnitType unitType() const { return static_cast<CSSPrimitiveValue::UnitType>(m_unit); }
+    UChar32 unicodeRangeStart() const { ASSERT(m_type == UnicodeRangeToken); return m_unicodeRange.start; }
+    UChar32 unicodeRangeEnd() const { ASSERT(m_type == UnicodeRangeToken); return m_unicodeRange.end; }
 
     CSSPropertyID parseAsCSSPropertyID() const;
 
 private:
-    CSSParserTokenType m_type;
-    String m_value;
+    // Whole stylesheets are tokenized up front, so keep tokens small.
+    unsigned m_type : 5; // CSSParserTokenType
+    unsigned m_blockType : 2; // BlockType
+    unsigned m_numericValueType : 1; // NumericValueType
+    unsigned m_hashTokenType : 1; // HashTokenType
+    unsigned m_unit : 7; // CSSPrimitiveValue::UnitType
 
-    // This could be a union to save space
-    UChar m_delimiter;
-    HashTokenType m_hashTokenType;
-    NumericValueType m_numericValueType;
-    double m_numericValue;
-    CSSPrimitiveValue::UnitType m_unit;
-    UChar32 m_unicodeRangeStart;
-    UChar32 m_unicodeRangeEnd;
+    String m_value;
 
-    BlockType m_blockType;
+    union {
+        UChar m_delimiter;
+        double m_numericValue;
+        struct {
+            UChar32 start;
+            UChar32 end;
+        } m_unicodeRange;
+    };
 };
 
 } // namespace
@@ -437,6 +437,19 @@ CSSParserToken CSSTokenizer::consumeIdentLikeToken()
 // http://dev.w3.org/csswg/css-syntax/#consume-a-string-token
 CSSParserToken CSSTokenizer::consumeStringTokenUntil(UChar endingCodePoint)
 {
+    // Strings without escapes or newlines are taken from the input in one go.
+    for (unsigned size = 0; ; ++size) {
+        UChar cc = m_input.peek(size);
+        if (cc == endingCodePoint || cc == kEndOfFileMarker) {
+            CSSParserToken token(StringToken, m_input.rangeAsString(0, size));
+            // As below, don't consume past the EOF.
+            m_input.advance(cc == kEndOfFileMarker ? size : size + 1);
+            return token;
+        }
+        if (isNewLine(cc) || cc == '\\')
+            break;
+    }
+
     StringBuilder output;
     while (true) {
         UChar cc = consume();
@@ -601,8 +614,14 @@ bool CSSTokenizer::consumeIfNext(UChar character)
 // http://www.w3.org/TR/css3-syntax/#consume-a-name
 String CSSTokenizer::consumeName()
 {
-    // FIXME: Is this as efficient as it can be?
-    // The possibility of escape chars mandates a copy AFAICT.
+    // Names without escapes are taken from the input in one go.
+    unsigned size = m_input.skipWhilePredicate<isNameChar>(0);
+    if (m_input.peek(size) != '\\') {
+        String name = m_input.rangeAsString(0, size);
+        m_input.advance(size);
+        return name;
+    }
+
     StringBuilder result;
     while (true) {
         UChar cc = consume();
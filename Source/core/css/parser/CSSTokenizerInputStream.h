@@ -35,6 +35,14 @@ public:
 
     }
 
+    // Returns the characters in [m_offset + start, m_offset + start + length)
+    // without going through a StringBuilder.
+    String rangeAsString(unsigned start, unsigned length)
+    {
+        ASSERT(m_offset + start + length <= m_string.length());
+        return m_string.substring(m_offset + start, length);
+    }
+
     unsigned long long getUInt(unsigned start, unsigned end);
     double getDouble(unsigned start, unsigned end);
 
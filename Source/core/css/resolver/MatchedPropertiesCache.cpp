@@ -61,10 +61,25 @@ bool CachedMatchedPropertiesHashTraits::traceInCollection(Visitor* visitor, Memb
 }
 #endif
 
-void CachedMatchedProperties::set(const RenderStyle* style, const RenderStyle* parentStyle, const MatchResult& matchResult)
+bool CachedMatchedProperties::containsImportantProperties(const MatchResult& matchResult, unsigned matchedPropertiesSize)
 {
-    matchedProperties.appendVector(matchResult.matchedProperties);
-    ranges = matchResult.ranges;
+    for (unsigned i = 0; i < matchedPropertiesSize; ++i) {
+        const StylePropertySet* properties = matchResult.matchedProperties[i].properties.get();
+        unsigned propertyCount = properties->propertyCount();
+        for (unsigned j = 0; j < propertyCount; ++j) {
+            if (properties->propertyAt(j).isImportant())
+                return true;
+        }
+    }
+    return false;
+}
+
+void CachedMatchedProperties::set(const RenderStyle* style, const RenderStyle* parentStyle, const MatchResult& matchResult, unsigned matchedPropertiesSize, const MatchRanges& matchRanges)
+{
+    ASSERT(matchedPropertiesSize <= matchResult.matchedProperties.size());
+    matchedProperties.append(matchResult.matchedProperties.data(), matchedPropertiesSize);
+    ranges = matchRanges;
+    hasImportantProperties = containsImportantProperties(matchResult, matchedPropertiesSize);
 
     // Note that we don't cache the original RenderStyle instance. It may be further modified.
     // The RenderStyle in the cache is really just a holder for the substructures and never used as-is.
@@ -87,7 +102,7 @@ MatchedPropertiesCache::MatchedPropertiesCache()
 {
 }
 
-const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const StyleResolverState& styleResolverState, const MatchResult& matchResult)
+const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const StyleResolverState& styleResolverState, const MatchResult& matchResult, unsigned matchedPropertiesSize, const MatchRanges& ranges)
 {
     ASSERT(hash);
 
@@ -97,7 +112,7 @@ const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const
     CachedMatchedProperties* cacheItem = it->value.get();
     ASSERT(cacheItem);
 
-    size_t size = matchResult.matchedProperties.size();
+    size_t size = matchedPropertiesSize;
     if (size != cacheItem->matchedProperties.size())
         return 0;
     if (cacheItem->renderStyle->insideLink() != styleResolverState.style()->insideLink())
@@ -106,12 +121,12 @@ const CachedMatchedProperties* MatchedPropertiesCache::find(unsigned hash, const
         if (matchResult.matchedProperties[i] != cacheItem->matchedProperties[i])
             return 0;
     }
-    if (cacheItem->ranges != matchResult.ranges)
+    if (cacheItem->ranges != ranges)
         return 0;
     return cacheItem;
 }
 
-void MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* parentStyle, unsigned hash, const MatchResult& matchResult)
+void MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* parentStyle, unsigned hash, const MatchResult& matchResult, unsigned matchedPropertiesSize, const MatchRanges& ranges)
 {
 #if !ENABLE(OILPAN)
     static const unsigned maxAdditionsBetweenSweeps = 100;
@@ -131,7 +146,7 @@ void MatchedPropertiesCache::add(const RenderStyle* style, const RenderStyle* pa
     if (!addResult.isNewEntry)
         cacheItem->clear();
 
-    cacheItem->set(style, parentStyle, matchResult);
+    cacheItem->set(style, parentStyle, matchResult, matchedPropertiesSize, ranges);
 }
 
 void MatchedPropertiesCache::clear()
@@ -39,12 +39,18 @@ class StyleResolverState;
 class CachedMatchedProperties final : public NoBaseWillBeGarbageCollectedFinalized<CachedMatchedProperties> {
 
 public:
+    CachedMatchedProperties() : hasImportantProperties(false) { }
+
     WillBeHeapVector<MatchedProperties> matchedProperties;
     MatchRanges ranges;
     RefPtr<RenderStyle> renderStyle;
     RefPtr<RenderStyle> parentRenderStyle;
+    // Whether any of the matchedProperties contain !important declarations.
+    bool hasImportantProperties;
+
+    static bool containsImportantProperties(const MatchResult&, unsigned matchedPropertiesSize);
 
-    void set(const RenderStyle*, const RenderStyle* parentStyle, const MatchResult&);
+    void set(const RenderStyle*, const RenderStyle* parentStyle, const MatchResult&, unsigned matchedPropertiesSize, const MatchRanges&);
     void clear();
     void trace(Visitor* visitor) { visitor->trace(matchedProperties); }
 };
@@ -64,8 +70,10 @@ class MatchedPropertiesCache {
 public:
     MatchedPropertiesCache();
 
-    const CachedMatchedProperties* find(unsigned hash, const StyleResolverState&, const MatchResult&);
-    void add(const RenderStyle*, const RenderStyle* parentStyle, unsigned hash, const MatchResult&);
+    // Entries are keyed by the first matchedPropertiesSize declaration blocks of a MatchResult,
+    // and the ranges of those blocks.
+    const CachedMatchedProperties* find(unsigned hash, const StyleResolverState&, const MatchResult&, unsigned matchedPropertiesSize, const MatchRanges&);
+    void add(const RenderStyle*, const RenderStyle* parentStyle, unsigned hash, const MatchResult&, unsigned matchedPropertiesSize, const MatchRanges&);
 
     void clear();
     void clearViewportDependent();
@@ -124,6 +124,15 @@ void StyleBuilder::applyProperty(CSSPropertyID id, StyleResolverState& state, CS
     if (isInherit && !state.parentStyle()->hasExplicitlyInheritedProperties() && !CSSPropertyMetadata::isInheritedProperty(id))
         state.parentStyle()->setHasExplicitlyInheritedProperties();
 
+    // An explicit inherit still tracks the parent, any other value means the
+    // property can't be propagated independently of a full recalc.
+    if (!isInherit) {
+        if (id == CSSPropertyVisibility)
+            state.style()->setVisibilityIsInherited(false);
+        else if (id == CSSPropertyPointerEvents)
+            state.style()->setPointerEventsIsInherited(false);
+    }
+
     StyleBuilder::applyProperty(id, state, value, isInitial, isInherit);
 }
 
@@ -85,6 +85,7 @@
 #include "core/svg/SVGElement.h"
 #include "platform/RuntimeEnabledFeatures.h"
 #include "wtf/StdLibExtras.h"
+#include "wtf/text/StringBuilder.h"
 
 namespace {
 
@@ -1411,16 +1412,83 @@ void StyleResolver::notifyResizeForViewportUnits()
     m_matchedPropertiesCache.clearViewportDependent();
 }
 
-void StyleResolver::applyMatchedProperties(StyleResolverState& state, const MatchResult& matchResult)
+// The inline style of an element is rarely shared with other elements and is uncacheable once it has
+// a CSSOM wrapper, so including it in the MatchedPropertiesCache key makes most elements with inline
+// style miss the cache. If it only contains normal priority, non-important declarations, applying it
+// after all other declaration blocks gives the same result as applying it in cascade order, so the
+// other blocks can be cached on their own.
+static bool canApplyInlineStyleSeparately(const StyleResolverState& state, const MatchResult& matchResult)
 {
+    size_t size = matchResult.matchedProperties.size();
+    if (size < 2 || matchResult.ranges.lastAuthorRule != static_cast<int>(size - 1))
+        return false;
+
     const Element* element = state.element();
-    ASSERT(element);
+    if (!element->isStyledElement() || !element->inlineStyle() || matchResult.matchedProperties[size - 1].properties != element->inlineStyle())
+        return false;
+
+    const StylePropertySet* inlineStyle = element->inlineStyle();
+    unsigned propertyCount = inlineStyle->propertyCount();
+    for (unsigned i = 0; i < propertyCount; ++i) {
+        StylePropertySet::PropertyReference property = inlineStyle->propertyAt(i);
+        if (property.isImportant())
+            return false;
+        // The 'all' shorthand also applies high priority properties.
+        CSSPropertyID id = property.id();
+        if (id == CSSPropertyAll || id == CSSPropertyWebkitAppearance || id < CSSPropertyAlignContent || id > lastCSSProperty)
+            return false;
+    }
+    return true;
+}
+
+void StyleResolver::applyMatchedProperties(StyleResolverState& state, const MatchResult& matchResult)
+{
+    ASSERT(state.element());
 
     INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyApply);
 
-    unsigned cacheHash = matchResult.isCacheable ? computeMatchedPropertiesHash(matchResult.matchedProperties.data(), matchResult.matchedProperties.size()) : 0;
+    if (!canApplyInlineStyleSeparately(state, matchResult)) {
+        applyMatchedPropertiesUsingCache(state, matchResult, matchResult.matchedProperties.size(), matchResult.ranges, matchResult.isCacheable);
+        return;
+    }
+
+    // All declaration blocks but the inline style are cacheable, see ElementRuleCollector::addElementStyleProperties.
+    int inlineStyleIndex = matchResult.matchedProperties.size() - 1;
+    MatchRanges ranges = matchResult.ranges;
+    if (ranges.firstAuthorRule == inlineStyleIndex)
+        ranges.firstAuthorRule = ranges.lastAuthorRule = -1;
+    else
+        --ranges.lastAuthorRule;
+
+    bool hasImportantProperties;
+    if (const CachedMatchedProperties* cachedMatchedProperties = applyMatchedPropertiesUsingCache(state, matchResult, inlineStyleIndex, ranges, true)) {
+        INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCachePartialHit);
+        hasImportantProperties = cachedMatchedProperties->hasImportantProperties;
+    } else {
+        hasImportantProperties = CachedMatchedProperties::containsImportantProperties(matchResult, inlineStyleIndex);
+    }
+
+    applyMatchedProperties<LowPriorityProperties>(state, matchResult, false, inlineStyleIndex, inlineStyleIndex, false);
+
+    // !important declarations in the other blocks take precedence over the inline style.
+    if (hasImportantProperties) {
+        applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, ranges.firstAuthorRule, ranges.lastAuthorRule, false);
+        applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, ranges.firstUARule, ranges.lastUARule, false);
+    }
+
+    loadPendingResources(state);
+}
+
+// Applies the first matchedPropertiesSize declaration blocks of the MatchResult, using the
+// MatchedPropertiesCache when possible. Returns the cache entry if there was a cache hit.
+const CachedMatchedProperties* StyleResolver::applyMatchedPropertiesUsingCache(StyleResolverState& state, const MatchResult& matchResult, unsigned matchedPropertiesSize, const MatchRanges& ranges, bool isCacheable)
+{
+    const Element* element = state.element();
+    ASSERT(element);
+
+    unsigned cacheHash = isCacheable ? computeMatchedPropertiesHash(matchResult.matchedProperties.data(), matchedPropertiesSize) : 0;
     bool applyInheritedOnly = false;
-    const CachedMatchedProperties* cachedMatchedProperties = cacheHash ? m_matchedPropertiesCache.find(cacheHash, state, matchResult) : 0;
+    const CachedMatchedProperties* cachedMatchedProperties = cacheHash ? m_matchedPropertiesCache.find(cacheHash, state, matchResult, matchedPropertiesSize, ranges) : 0;
 
     if (cachedMatchedProperties && MatchedPropertiesCache::isCacheable(element, state.style(), state.parentStyle())) {
         INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheHit);
@@ -1444,18 +1512,22 @@ void StyleResolver::applyMatchedProperties(StyleResolverState& state, const Matc
 
             updateFont(state);
 
-            return;
+            return cachedMatchedProperties;
         }
         applyInheritedOnly = true;
+    } else {
+        INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheMiss);
     }
 
+    int lastIndex = static_cast<int>(matchedPropertiesSize) - 1;
+
     // Now we have all of the matched rules in the appropriate order. Walk the rules and apply
     // high-priority properties first, i.e., those properties that other properties depend on.
     // The order is (1) high-priority not important, (2) high-priority important, (3) normal not important
     // and (4) normal important.
-    applyMatchedProperties<HighPriorityProperties>(state, matchResult, false, 0, matchResult.matchedProperties.size() - 1, applyInheritedOnly);
-    applyMatchedProperties<HighPriorityProperties>(state, matchResult, true, matchResult.ranges.firstAuthorRule, matchResult.ranges.lastAuthorRule, applyInheritedOnly);
-    applyMatchedProperties<HighPriorityProperties>(state, matchResult, true, matchResult.ranges.firstUARule, matchResult.ranges.lastUARule, applyInheritedOnly);
+    applyMatchedProperties<HighPriorityProperties>(state, matchResult, false, 0, lastIndex, applyInheritedOnly);
+    applyMatchedProperties<HighPriorityProperties>(state, matchResult, true, ranges.firstAuthorRule, ranges.lastAuthorRule, applyInheritedOnly);
+    applyMatchedProperties<HighPriorityProperties>(state, matchResult, true, ranges.firstUARule, ranges.lastUARule, applyInheritedOnly);
 
     if (UNLIKELY(isSVGForeignObjectElement(element))) {
         // RenderSVGRoot handles zooming for the whole SVG subtree, so foreignObject content should not be scaled again.
@@ -1481,24 +1553,25 @@ void StyleResolver::applyMatchedProperties(StyleResolverState& state, const Matc
         applyInheritedOnly = false;
 
     // Now do the normal priority UA properties.
-    applyMatchedProperties<LowPriorityProperties>(state, matchResult, false, matchResult.ranges.firstUARule, matchResult.ranges.lastUARule, applyInheritedOnly);
+    applyMatchedProperties<LowPriorityProperties>(state, matchResult, false, ranges.firstUARule, ranges.lastUARule, applyInheritedOnly);
 
     // Cache the UA properties to pass them to RenderTheme in adjustRenderStyle.
     state.cacheUserAgentBorderAndBackground();
 
     // Now do the author and user normal priority properties and all the !important properties.
-    applyMatchedProperties<LowPriorityProperties>(state, matchResult, false, matchResult.ranges.lastUARule + 1, matchResult.matchedProperties.size() - 1, applyInheritedOnly);
-    applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, matchResult.ranges.firstAuthorRule, matchResult.ranges.lastAuthorRule, applyInheritedOnly);
-    applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, matchResult.ranges.firstUARule, matchResult.ranges.lastUARule, applyInheritedOnly);
+    applyMatchedProperties<LowPriorityProperties>(state, matchResult, false, ranges.lastUARule + 1, lastIndex, applyInheritedOnly);
+    applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, ranges.firstAuthorRule, ranges.lastAuthorRule, applyInheritedOnly);
+    applyMatchedProperties<LowPriorityProperties>(state, matchResult, true, ranges.firstUARule, ranges.lastUARule, applyInheritedOnly);
 
     loadPendingResources(state);
 
     if (!cachedMatchedProperties && cacheHash && MatchedPropertiesCache::isCacheable(element, state.style(), state.parentStyle())) {
         INCREMENT_STYLE_STATS_COUNTER(*this, matchedPropertyCacheAdded);
-        m_matchedPropertiesCache.add(state.style(), state.parentStyle(), cacheHash, matchResult);
+        m_matchedPropertiesCache.add(state.style(), state.parentStyle(), cacheHash, matchResult, matchedPropertiesSize, ranges);
     }
 
     ASSERT(!state.fontBuilder().fontDirty());
+    return cachedMatchedProperties;
 }
 
 void StyleResolver::applyCallbackSelectors(StyleResolverState& state)
@@ -1552,6 +1625,54 @@ void StyleResolver::printStats()
     fprintf(stderr, "%s\n", m_styleResolverStats->report().utf8().data());
     fprintf(stderr, "== Totals ==\n");
     fprintf(stderr, "%s\n", m_styleResolverStatsTotals->report().utf8().data());
+    fprintf(stderr, "== RenderStyle data sharing ==\n");
+    fprintf(stderr, "%s\n", styleDataSharingReport().utf8().data());
+}
+
+// Counts, for each copy-on-write group of RenderStyle, how many distinct
+// instances the styles of the render tree refer to. A group with as many
+// instances as there are styles is cloned for every style.
+String StyleResolver::styleDataSharingReport()
+{
+    HashSet<const RenderStyle*> styles;
+    HashSet<const void*> box, visual, background, surround, rareNonInherited, rareInherited, inherited, svg;
+
+    for (RenderObject* renderer = document().renderView(); renderer; renderer = renderer->nextInPreOrder()) {
+        const RenderStyle* style = renderer->style();
+        if (!style || !styles.add(style).isNewEntry)
+            continue;
+        box.add(style->m_box.get());
+        visual.add(style->visual.get());
+        background.add(style->m_background.get());
+        surround.add(style->surround.get());
+        rareNonInherited.add(style->rareNonInheritedData.get());
+        rareInherited.add(style->rareInheritedData.get());
+        inherited.add(style->inherited.get());
+        svg.add(style->m_svgStyle.get());
+    }
+
+    StringBuilder output;
+    output.append(String::format("  %u distinct styles in the render tree.\n", styles.size()));
+    const struct {
+        const char* name;
+        const HashSet<const void*>& instances;
+        unsigned instanceSize;
+    } groups[] = {
+        { "box", box, sizeof(StyleBoxData) },
+        { "visual", visual, sizeof(StyleVisualData) },
+        { "background", background, sizeof(StyleBackgroundData) },
+        { "surround", surround, sizeof(StyleSurroundData) },
+        { "rareNonInheritedData", rareNonInherited, sizeof(StyleRareNonInheritedData) },
+        { "rareInheritedData", rareInherited, sizeof(StyleRareInheritedData) },
+        { "inherited", inherited, sizeof(StyleInheritedData) },
+        { "svgStyle", svg, sizeof(SVGRenderStyle) },
+    };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(groups); ++i) {
+        unsigned instances = groups[i].instances.size();
+        double sharing = styles.size() ? 100.0 - instances * 100.0 / styles.size() : 0;
+        output.append(String::format("  %s: %u instances of %u bytes, %.2f%% shared.\n", groups[i].name, instances, groups[i].instanceSize, sharing));
+    }
+    return output.toString();
 }
 
 void StyleResolver::applyPropertiesToStyle(const CSSPropertyValue* properties, size_t count, RenderStyle* style)
@@ -200,6 +200,8 @@ public:
     void trace(Visitor*);
 
 private:
+    String styleDataSharingReport();
+
     void initWatchedSelectorRules(const WillBeHeapVector<RefPtrWillBeMember<StyleRule> >& watchedSelectors);
 
     // FIXME: This should probably go away, folded into FontBuilder.
@@ -224,6 +226,7 @@ private:
     bool fastRejectSelector(const RuleData&) const;
 
     void applyMatchedProperties(StyleResolverState&, const MatchResult&);
+    const CachedMatchedProperties* applyMatchedPropertiesUsingCache(StyleResolverState&, const MatchResult&, unsigned matchedPropertiesSize, const MatchRanges&, bool isCacheable);
     bool applyAnimatedProperties(StyleResolverState&, const Element* animatingElement);
     void applyCallbackSelectors(StyleResolverState&);
 
@@ -49,8 +49,11 @@ void StyleResolverStats::reset()
     sharedStyleRejectedByParent = 0;
     matchedPropertyApply = 0;
     matchedPropertyCacheHit = 0;
+    matchedPropertyCacheMiss = 0;
     matchedPropertyCacheInheritedHit = 0;
+    matchedPropertyCachePartialHit = 0;
     matchedPropertyCacheAdded = 0;
+    independentInheritedPropertiesPropagated = 0;
 }
 
 String StyleResolverStats::report() const
@@ -78,9 +81,16 @@ String StyleResolverStats::report() const
 
     output.appendLiteral("Matched property cache:\n");
     output.append(String::format("  %u calls to applyMatchedProperties, %u hit the cache (%.2f%%).\n", matchedPropertyApply, matchedPropertyCacheHit, PERCENT(matchedPropertyCacheHit, matchedPropertyApply)));
+    output.append(String::format("  %u calls to applyMatchedProperties missed the cache (%.2f%%).\n", matchedPropertyCacheMiss, PERCENT(matchedPropertyCacheMiss, matchedPropertyApply)));
     output.append(String::format("  %u cache hits also shared the inherited style (%.2f%%).\n", matchedPropertyCacheInheritedHit, PERCENT(matchedPropertyCacheInheritedHit, matchedPropertyCacheHit)));
+    output.append(String::format("  %u cache hits were partial, with the inline style applied on top (%.2f%%).\n", matchedPropertyCachePartialHit, PERCENT(matchedPropertyCachePartialHit, matchedPropertyCacheHit)));
     output.append(String::format("  %u styles created in applyMatchedProperties were added to the cache (%.2f%%).\n", matchedPropertyCacheAdded, PERCENT(matchedPropertyCacheAdded, matchedPropertyApply)));
 
+    output.append('\n');
+
+    output.appendLiteral("Style recalc:\n");
+    output.append(String::format("  %u elements took independent inherited properties from their parent without a style resolve.\n", independentInheritedPropertiesPropagated));
+
     return output.toString();
 }
 
@@ -55,8 +55,11 @@ public:
     unsigned sharedStyleRejectedByParent;
     unsigned matchedPropertyApply;
     unsigned matchedPropertyCacheHit;
+    unsigned matchedPropertyCacheMiss;
     unsigned matchedPropertyCacheInheritedHit;
+    unsigned matchedPropertyCachePartialHit;
     unsigned matchedPropertyCacheAdded;
+    unsigned independentInheritedPropertiesPropagated;
 
     // We keep a separate flag for this since crawling the entire document to print
     // the number of missed candidates is very slow.
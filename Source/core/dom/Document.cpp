@@ -1928,6 +1928,9 @@ void Document::updateLayout()
     if (!isActive())
         return;
 
+    if (frameView->hasSkippedLayoutRoots() && !frameView->isLayoutSkippingAllowed())
+        frameView->scheduleSkippedLayoutRoots();
+
     if (frameView->needsLayout())
         frameView->layout();
 
@@ -1991,6 +1994,24 @@ void Document::updateLayoutIgnorePendingStylesheets(Document::RunPostLayoutTasks
         view()->flushAnyPendingPostLayoutTasks();
 }
 
+void Document::updateLayoutIgnorePendingStylesheetsForNode(Node* node)
+{
+    ASSERT(node);
+    RefPtrWillBeRawPtr<FrameView> frameView = view();
+    if (!frameView) {
+        updateLayoutIgnorePendingStylesheets();
+        return;
+    }
+
+    {
+        FrameView::AllowLayoutSkippingScope allowLayoutSkipping(frameView.get());
+        updateLayoutIgnorePendingStylesheets();
+    }
+
+    if (RenderObject* renderer = node->renderer())
+        frameView->layoutSkippedLayoutRootsContaining(*renderer);
+}
+
 PassRefPtr<RenderStyle> Document::styleForElementIgnoringPendingStylesheets(Element* element)
 {
     ASSERT_ARG(element, element->document() == this);
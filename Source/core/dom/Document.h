@@ -474,6 +474,9 @@ public:
         RunPostLayoutTasksSynchronously,
     };
     void updateLayoutIgnorePendingStylesheets(RunPostLayoutTasks = RunPostLayoutTasksAsyhnchronously);
+    // Like updateLayoutIgnorePendingStylesheets(), but offscreen contain: strict
+    // blocks may stay unlaid out unless they contain |node|.
+    void updateLayoutIgnorePendingStylesheetsForNode(Node*);
     PassRefPtr<RenderStyle> styleForElementIgnoringPendingStylesheets(Element*);
     PassRefPtr<RenderStyle> styleForPage(int pageIndex);
 
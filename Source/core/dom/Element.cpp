@@ -46,6 +46,7 @@
 #include "core/css/parser/CSSParser.h"
 #include "core/css/resolver/StyleResolver.h"
 #include "core/css/resolver/StyleResolverParentScope.h"
+#include "core/css/resolver/StyleResolverStats.h"
 #include "core/dom/AXObjectCache.h"
 #include "core/dom/Attr.h"
 #include "core/dom/CSSSelectorWatch.h"
@@ -514,7 +515,7 @@ static double adjustForLocalZoom(LayoutUnit value, RenderObject& renderer)
 
 int Element::offsetLeft()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return lroundf(adjustForLocalZoom(renderer->offsetLeft(), *renderer));
     return 0;
@@ -522,7 +523,7 @@ int Element::offsetLeft()
 
 int Element::offsetTop()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return lroundf(adjustForLocalZoom(renderer->pixelSnappedOffsetTop(), *renderer));
     return 0;
@@ -530,7 +531,7 @@ int Element::offsetTop()
 
 int Element::offsetWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return adjustLayoutUnitForAbsoluteZoom(renderer->pixelSnappedOffsetWidth(), *renderer).round();
     return 0;
@@ -538,7 +539,7 @@ int Element::offsetWidth()
 
 int Element::offsetHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBoxModelObject* renderer = renderBoxModelObject())
         return adjustLayoutUnitForAbsoluteZoom(renderer->pixelSnappedOffsetHeight(), *renderer).round();
     return 0;
@@ -554,7 +555,7 @@ Element* Element::offsetParentForBindings()
 
 Element* Element::offsetParent()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderObject* renderer = this->renderer())
         return renderer->offsetParent();
     return nullptr;
@@ -562,7 +563,7 @@ Element* Element::offsetParent()
 
 int Element::clientLeft()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (RenderBox* renderer = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(roundToInt(renderer->clientLeft()), *renderer);
@@ -571,7 +572,7 @@ int Element::clientLeft()
 
 int Element::clientTop()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     if (RenderBox* renderer = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(roundToInt(renderer->clientTop()), *renderer);
@@ -580,7 +581,7 @@ int Element::clientTop()
 
 int Element::clientWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     // When in strict mode, clientWidth for the document element should return the width of the containing frame.
     // When in quirks mode, clientWidth for the body element should return the width of the containing frame.
@@ -600,7 +601,7 @@ int Element::clientWidth()
 
 int Element::clientHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     // When in strict mode, clientHeight for the document element should return the height of the containing frame.
     // When in quirks mode, clientHeight for the body element should return the height of the containing frame.
@@ -725,7 +726,7 @@ void Element::setScrollTop(double newTop)
 
 int Element::scrollWidth()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBox* rend = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(rend->scrollWidth(), *rend).toDouble();
     return 0;
@@ -733,7 +734,7 @@ int Element::scrollWidth()
 
 int Element::scrollHeight()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
     if (RenderBox* rend = renderBox())
         return adjustLayoutUnitForAbsoluteZoom(rend->scrollHeight(), *rend).toDouble();
     return 0;
@@ -916,7 +917,7 @@ IntRect Element::boundsInRootViewSpace()
 
 PassRefPtrWillBeRawPtr<ClientRectList> Element::getClientRects()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     RenderObject* elementRenderer = renderer();
     if (!elementRenderer || (!elementRenderer->isBoxModelObject() && !elementRenderer->isBR()))
@@ -933,7 +934,7 @@ PassRefPtrWillBeRawPtr<ClientRectList> Element::getClientRects()
 
 PassRefPtrWillBeRawPtr<ClientRect> Element::getBoundingClientRect()
 {
-    document().updateLayoutIgnorePendingStylesheets();
+    document().updateLayoutIgnorePendingStylesheetsForNode(this);
 
     Vector<FloatQuad> quads;
     RenderObject* elementRenderer = renderer();
@@ -1590,12 +1591,16 @@ void Element::recalcStyle(StyleRecalcChange change, Text* nextTextSibling)
     if (hasCustomStyleCallbacks())
         willRecalcStyle(change);
 
-    if (change >= Inherit || needsStyleRecalc()) {
+    if (change == IndependentInherit && !needsStyleRecalc() && canPropagateIndependentInheritedProperties()) {
+        if (hasRareData())
+            elementRareData()->clearComputedStyle();
+        change = propagateIndependentInheritedProperties();
+    } else if (change >= IndependentInherit || needsStyleRecalc()) {
         if (hasRareData()) {
             ElementRareData* data = elementRareData();
             data->clearComputedStyle();
 
-            if (change >= Inherit) {
+            if (change >= IndependentInherit) {
                 if (ActiveAnimations* activeAnimations = data->activeAnimations())
                     activeAnimations->setAnimationStyleChange(false);
             }
@@ -1642,7 +1647,7 @@ StyleRecalcChange Element::recalcOwnStyle(StyleRecalcChange change)
 {
     ASSERT(document().inStyleRecalc());
     ASSERT(!parentOrShadowHostNode()->needsStyleRecalc());
-    ASSERT(change >= Inherit || needsStyleRecalc());
+    ASSERT(change >= IndependentInherit || needsStyleRecalc());
     ASSERT(parentRenderStyle());
 
     RefPtr<RenderStyle> oldStyle = renderStyle();
@@ -1684,12 +1689,43 @@ StyleRecalcChange Element::recalcOwnStyle(StyleRecalcChange change)
     if (change > Inherit || localChange > Inherit)
         return max(localChange, change);
 
-    if (localChange < Inherit && (oldStyle->hasPseudoElementStyle() || newStyle->hasPseudoElementStyle()))
+    if (localChange < UpdatePseudoElements && (oldStyle->hasPseudoElementStyle() || newStyle->hasPseudoElementStyle()))
         return UpdatePseudoElements;
 
     return localChange;
 }
 
+bool Element::canPropagateIndependentInheritedProperties() const
+{
+    if (isPseudoElement() || hasCustomStyleCallbacks() || !renderer() || !parentRenderStyle())
+        return false;
+    if (hasRareData() && elementRareData()->activeAnimations())
+        return false;
+    // Cached pseudo styles, including the :visited style, are not carried over
+    // by RenderStyle::clone().
+    const PseudoStyleCache* cachedPseudoStyles = renderStyle()->cachedPseudoStyles();
+    return !cachedPseudoStyles || cachedPseudoStyles->isEmpty();
+}
+
+// Only the independent inherited properties of the parent changed, so instead
+// of resolving the style again we copy them into a clone of the current style
+// wherever this element inherits them.
+StyleRecalcChange Element::propagateIndependentInheritedProperties()
+{
+    ASSERT(canPropagateIndependentInheritedProperties());
+
+    RenderStyle* oldStyle = renderStyle();
+    RefPtr<RenderStyle> newStyle = RenderStyle::clone(oldStyle);
+    newStyle->propagateIndependentInheritedProperties(*parentRenderStyle());
+    INCREMENT_STYLE_STATS_COUNTER(document().ensureStyleResolver(), independentInheritedPropertiesPropagated);
+
+    if (!oldStyle->independentInheritedPropertiesNotEqual(newStyle.get()))
+        return NoChange;
+
+    renderer()->setStyle(newStyle.release());
+    return IndependentInherit;
+}
+
 void Element::updateCallbackSelectors(RenderStyle* oldStyle, RenderStyle* newStyle)
 {
     Vector<String> emptyVector;
@@ -567,6 +567,8 @@ private:
     void setInlineStyleFromString(const AtomicString&);
 
     StyleRecalcChange recalcOwnStyle(StyleRecalcChange);
+    bool canPropagateIndependentInheritedProperties() const;
+    StyleRecalcChange propagateIndependentInheritedProperties();
 
     inline void checkForEmptyStyleChange();
 
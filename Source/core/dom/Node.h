@@ -857,7 +857,7 @@ inline void Node::lazyReattachIfAttached()
 
 inline bool Node::shouldCallRecalcStyle(StyleRecalcChange change)
 {
-    return change >= Inherit || needsStyleRecalc() || childNeedsStyleRecalc();
+    return change >= IndependentInherit || needsStyleRecalc() || childNeedsStyleRecalc();
 }
 
 inline bool isTreeScopeRoot(const Node* node)
@@ -125,7 +125,7 @@ void InsertionPoint::detach(const AttachContext& context)
 
 void InsertionPoint::willRecalcStyle(StyleRecalcChange change)
 {
-    if (change < Inherit && styleChangeType() < SubtreeStyleChange)
+    if (change < IndependentInherit && styleChangeType() < SubtreeStyleChange)
         return;
     for (size_t i = 0; i < m_distribution.size(); ++i)
         m_distribution.at(i)->setNeedsStyleRecalc(SubtreeStyleChange, StyleChangeReasonForTracing::create(StyleChangeReason::PropagateInheritChangeToDistributedNodes));
@@ -57,6 +57,7 @@
 #include "core/page/Page.h"
 #include "core/page/scrolling/ScrollingCoordinator.h"
 #include "core/paint/FramePainter.h"
+#include "core/rendering/BackingPaintInvalidations.h"
 #include "core/rendering/RenderCounter.h"
 #include "core/rendering/RenderEmbeddedObject.h"
 #include "core/rendering/RenderLayer.h"
@@ -106,6 +107,7 @@ FrameView::FrameView(LocalFrame* frame)
     , m_slowRepaintObjectCount(0)
     , m_hasPendingLayout(false)
     , m_layoutSubtreeRoot(0)
+    , m_layoutSkippingAllowed(false)
     , m_inSynchronousPostLayout(false)
     , m_postLayoutTasksTimer(this, &FrameView::postLayoutTimerFired)
     , m_updateWidgetsTimer(this, &FrameView::updateWidgetsTimerFired)
@@ -118,6 +120,7 @@ FrameView::FrameView(LocalFrame* frame)
     , m_inProgrammaticScroll(false)
     , m_safeToPropagateScrollToParent(true)
     , m_isTrackingPaintInvalidations(false)
+    , m_backingPaintInvalidations(0)
     , m_scrollCorner(nullptr)
     , m_visibleContentScaleFactor(1)
     , m_inputEventsScaleFactorForEmulation(1)
@@ -254,6 +257,7 @@ void FrameView::reset()
     m_firstVisuallyNonEmptyLayoutCallbackPending = true;
     m_maintainScrollPositionAnchor = nullptr;
     m_viewportConstrainedObjects.clear();
+    m_skippedLayoutRoots.clear();
 }
 
 void FrameView::removeFromAXObjectCache()
@@ -934,6 +938,9 @@ void FrameView::layout(bool allowSubtree)
         return;
     }
 
+    if (RenderView* renderView = this->renderView())
+        renderView->checkDeferredCellPreferredLogicalWidths();
+
     FontCachePurgePreventer fontCachePurgePreventer;
     RenderLayer* layer;
     {
@@ -1078,7 +1085,17 @@ void FrameView::invalidateTreeIfNeeded()
     if (m_doFullPaintInvalidation)
         renderView()->compositor()->fullyInvalidatePaint();
 
-    rootForPaintInvalidation.invalidateTreeIfNeeded(rootPaintInvalidationState);
+    // Paint invalidation tracking tests expect each rect as it was issued.
+    if (m_isTrackingPaintInvalidations) {
+        rootForPaintInvalidation.invalidateTreeIfNeeded(rootPaintInvalidationState);
+    } else {
+        BackingPaintInvalidations backingPaintInvalidations;
+        {
+            TemporaryChange<BackingPaintInvalidations*> collectBackingPaintInvalidations(m_backingPaintInvalidations, &backingPaintInvalidations);
+            rootForPaintInvalidation.invalidateTreeIfNeeded(rootPaintInvalidationState);
+        }
+        backingPaintInvalidations.flush();
+    }
 
     // Invalidate the paint of the frameviews scrollbars if needed
     if (hasVerticalBarDamage())
@@ -1782,6 +1799,88 @@ void FrameView::handleLoadCompleted()
         m_autoSizeInfo->autoSizeIfNeeded();
 }
 
+bool FrameView::isLayoutSkippingAllowed() const
+{
+    return m_layoutSkippingAllowed && !m_frame->document()->printing();
+}
+
+bool FrameView::isNearViewport(const LayoutRect& absoluteRect) const
+{
+    // Anything within a viewport's size of the visible content counts, so that
+    // blocks are laid out by the time scrolling brings them into view.
+    IntRect nearViewportRect = visibleContentRect();
+    nearViewportRect.inflateX(nearViewportRect.width());
+    nearViewportRect.inflateY(nearViewportRect.height());
+    return absoluteRect.intersects(LayoutRect(nearViewportRect));
+}
+
+void FrameView::didSkipLayout(RenderBlock& block, bool childrenNeedFullLayout)
+{
+    SkippedLayoutRootMap::AddResult result = m_skippedLayoutRoots.add(&block, false);
+    result.storedValue->value |= childrenNeedFullLayout;
+}
+
+bool FrameView::takeSkippedLayoutRoot(RenderBlock& block)
+{
+    if (m_skippedLayoutRoots.isEmpty())
+        return false;
+    return m_skippedLayoutRoots.take(&block);
+}
+
+void FrameView::removeSkippedLayoutRoot(RenderBlock& block)
+{
+    m_skippedLayoutRoots.remove(&block);
+}
+
+bool FrameView::isSkippedLayoutRoot(const RenderBlock& block) const
+{
+    return !m_skippedLayoutRoots.isEmpty() && m_skippedLayoutRoots.contains(const_cast<RenderBlock*>(&block));
+}
+
+void FrameView::scheduleSkippedLayoutRoot(RenderBlock& block)
+{
+    // The block stays in m_skippedLayoutRoots until its layout takes it out.
+    // It is usually a relayout boundary, so this only schedules its subtree.
+    block.setNeedsLayout();
+}
+
+void FrameView::scheduleSkippedLayoutRoots()
+{
+    Vector<RenderBlock*> roots;
+    copyKeysToVector(m_skippedLayoutRoots, roots);
+    for (RenderBlock* root : roots)
+        scheduleSkippedLayoutRoot(*root);
+}
+
+void FrameView::scheduleSkippedLayoutRootsNearViewport()
+{
+    Vector<RenderBlock*> roots;
+    for (const auto& entry : m_skippedLayoutRoots) {
+        RenderBlock* root = entry.key;
+        // Layers added inside a skipped block would be painted without layout.
+        if ((root->layer() && root->layer()->firstChild()) || isNearViewport(root->absoluteBoundingBoxRect()))
+            roots.append(root);
+    }
+    for (RenderBlock* root : roots)
+        scheduleSkippedLayoutRoot(*root);
+}
+
+void FrameView::layoutSkippedLayoutRootsContaining(RenderObject& renderer)
+{
+    if (m_skippedLayoutRoots.isEmpty())
+        return;
+
+    bool scheduled = false;
+    for (RenderObject* ancestor = &renderer; ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->isRenderBlock() && m_skippedLayoutRoots.contains(toRenderBlock(ancestor))) {
+            scheduleSkippedLayoutRoot(*toRenderBlock(ancestor));
+            scheduled = true;
+        }
+    }
+    if (scheduled)
+        layout();
+}
+
 void FrameView::scheduleRelayout()
 {
     ASSERT(m_frame->view() == this);
@@ -2592,8 +2691,18 @@ void FrameView::updateLayoutAndStyleIfNeededRecursive()
 
     m_frame->document()->updateRenderTreeIfNeeded();
 
-    if (needsLayout())
+    if (needsLayout()) {
+        AllowLayoutSkippingScope allowLayoutSkipping(this);
         layout();
+    }
+
+    // LayoutState doesn't account for scrolled overflow, so check the blocks
+    // that were skipped against their actual position now that layout is done.
+    if (hasSkippedLayoutRoots()) {
+        scheduleSkippedLayoutRootsNearViewport();
+        if (needsLayout())
+            layout();
+    }
 
     // FIXME: Calling layout() shouldn't trigger scripe execution or have any
     // observable effects on the frame tree but we're not quite there yet.
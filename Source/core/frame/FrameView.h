@@ -36,6 +36,7 @@
 #include "platform/scroll/ScrollableArea.h"
 #include "platform/scroll/Scrollbar.h"
 #include "wtf/Forward.h"
+#include "wtf/HashMap.h"
 #include "wtf/HashSet.h"
 #include "wtf/OwnPtr.h"
 #include "wtf/TemporaryChange.h"
@@ -44,6 +45,7 @@
 namespace blink {
 
 class AXObjectCache;
+class BackingPaintInvalidations;
 class DocumentLifecycle;
 class Cursor;
 class Element;
@@ -53,6 +55,7 @@ class LocalFrame;
 class KURL;
 class Node;
 class Page;
+class RenderBlock;
 class RenderBox;
 class RenderEmbeddedObject;
 class RenderObject;
@@ -110,6 +113,30 @@ public:
     bool needsLayout() const;
     void setNeedsLayout();
 
+    // Layout of 'contain: strict' blocks far from the viewport is skipped for
+    // frame updates, until they get near it or script asks for geometry inside
+    // them. See RenderBlockFlow::layoutBlock.
+    bool isLayoutSkippingAllowed() const;
+    bool isNearViewport(const LayoutRect& absoluteRect) const;
+    void didSkipLayout(RenderBlock&, bool childrenNeedFullLayout);
+    // Returns true if the children of a block whose layout was skipped need
+    // a full layout.
+    bool takeSkippedLayoutRoot(RenderBlock&);
+    void removeSkippedLayoutRoot(RenderBlock&);
+    bool isSkippedLayoutRoot(const RenderBlock&) const;
+    bool hasSkippedLayoutRoots() const { return !m_skippedLayoutRoots.isEmpty(); }
+    void scheduleSkippedLayoutRoots();
+    void layoutSkippedLayoutRootsContaining(RenderObject&);
+
+    class AllowLayoutSkippingScope {
+    public:
+        explicit AllowLayoutSkippingScope(FrameView* view)
+            : m_scope(view->m_layoutSkippingAllowed, true)
+        { }
+    private:
+        TemporaryChange<bool> m_scope;
+    };
+
     void setNeedsUpdateWidgetPositions() { m_needsUpdateWidgetPositions = true; }
 
     // Methods for getting/setting the size Blink should use to layout the contents.
@@ -283,6 +310,8 @@ public:
 
     void setTracksPaintInvalidations(bool);
     bool isTrackingPaintInvalidations() const { return m_isTrackingPaintInvalidations; }
+    // Non-null while invalidateTreeIfNeeded() collects backing invalidations.
+    BackingPaintInvalidations* backingPaintInvalidations() const { return m_backingPaintInvalidations; }
     void resetTrackedPaintInvalidations();
 
     String trackedPaintInvalidationRectsAsText() const;
@@ -615,6 +644,9 @@ private:
 
     void invalidateTreeIfNeeded();
 
+    void scheduleSkippedLayoutRoot(RenderBlock&);
+    void scheduleSkippedLayoutRootsNearViewport();
+
     void gatherDebugLayoutRects(RenderObject* layoutRoot);
 
     DocumentLifecycle& lifecycle() const;
@@ -713,6 +745,11 @@ private:
     bool m_hasPendingLayout;
     RenderObject* m_layoutSubtreeRoot;
 
+    // Values are whether the children need a full layout once resumed.
+    typedef HashMap<RenderBlock*, bool> SkippedLayoutRootMap;
+    SkippedLayoutRootMap m_skippedLayoutRoots;
+    bool m_layoutSkippingAllowed;
+
     bool m_layoutSchedulingEnabled;
     bool m_inPerformLayout;
     bool m_canInvalidatePaintDuringPerformLayout;
@@ -744,6 +781,7 @@ private:
     double m_lastPaintTime;
 
     bool m_isTrackingPaintInvalidations; // Used for testing.
+    BackingPaintInvalidations* m_backingPaintInvalidations;
     Vector<IntRect> m_trackedPaintInvalidationRects;
 
     RefPtrWillBeMember<Node> m_nodeToDraw;
@@ -153,6 +153,8 @@ void HTMLCanvasElement::didRecalcStyle(StyleRecalcChange)
         toWebGLRenderingContext(m_context.get())->setFilterLevel(filterLevel);
         setNeedsCompositingUpdate();
     } else if (hasImageBuffer()) {
+        // Batched images are drawn with the filter level they were drawn at.
+        toCanvasRenderingContext2D(m_context.get())->flushDrawBatch();
         m_imageBuffer->setFilterLevel(filterLevel);
     }
 }
@@ -311,6 +313,8 @@ void HTMLCanvasElement::didProcessTask()
         didFinalizeFrame();
     } else {
         ASSERT(hasImageBuffer());
+        if (m_context->is2d())
+            toCanvasRenderingContext2D(m_context.get())->flushDrawBatch();
         m_imageBuffer->finalizeFrame(m_dirtyRect);
     }
     ASSERT(m_dirtyRect.isEmpty());
@@ -723,6 +727,10 @@ ImageBuffer* HTMLCanvasElement::buffer() const
     ASSERT(m_context);
     if (!hasImageBuffer() && !m_didFailToCreateImageBuffer)
         const_cast<HTMLCanvasElement*>(this)->createImageBuffer();
+    // Anything reading or drawing into the buffer has to see the draws the 2D
+    // context has batched.
+    if (m_context->is2d())
+        toCanvasRenderingContext2D(m_context.get())->flushDrawBatch();
     return m_imageBuffer.get();
 }
 
@@ -153,6 +153,7 @@ public:
     virtual PassRefPtr<Image> getSourceImageForCanvas(SourceImageMode, SourceImageStatus*) const override;
     virtual bool wouldTaintOrigin(SecurityOrigin*) const override;
     virtual FloatSize sourceSize() const override;
+    virtual bool isCanvasElement() const override { return true; }
 
     // ImageBufferClient implementation
     virtual void notifySurfaceInvalid() override;
@@ -0,0 +1,114 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/html/canvas/CanvasDrawBatch.h"
+
+#include "platform/TraceEvent.h"
+#include "platform/geometry/IntRect.h"
+#include "platform/graphics/GraphicsContext.h"
+#include "platform/graphics/Path.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+
+namespace blink {
+
+// Bounds the memory a batch holds on to, e.g. when a page draws tens of
+// thousands of sprites per frame.
+static const size_t maxBatchedDraws = 4096;
+
+CanvasDrawBatch::CanvasDrawBatch()
+    : m_type(NoDraws)
+{
+}
+
+bool CanvasDrawBatch::isFull() const
+{
+    return m_fillRects.size() + m_imageDraws.size() >= maxBatchedDraws;
+}
+
+void CanvasDrawBatch::start(Type type, const FloatRect& clipBounds)
+{
+    ASSERT(isEmpty());
+    m_type = type;
+    m_clipBounds = clipBounds;
+}
+
+void CanvasDrawBatch::appendFillRect(const FloatRect& rect, const FloatRect& clipBounds, const FloatRect& dirtyRect)
+{
+    if (isEmpty())
+        start(FillRects, clipBounds);
+    ASSERT(canAppendFillRect());
+    m_fillRects.append(rect);
+    m_dirtyRect.unite(dirtyRect);
+}
+
+void CanvasDrawBatch::appendImage(PassRefPtr<Image> image, const FloatRect& srcRect, const FloatRect& dstRect, const FloatRect& clipBounds, const FloatRect& dirtyRect)
+{
+    if (isEmpty()) {
+        start(Images, clipBounds);
+        m_image = image;
+    }
+    ASSERT(canAppendImage(m_image.get()));
+    m_imageDraws.append(ImageDraw(srcRect, dstRect));
+    m_dirtyRect.unite(dirtyRect);
+}
+
+static bool isPixelAligned(const SkRect& rect)
+{
+    FloatRect floatRect(rect);
+    return floatRect == FloatRect(enclosingIntRect(floatRect));
+}
+
+bool CanvasDrawBatch::fillRectsArePixelAligned(GraphicsContext* context) const
+{
+    SkMatrix matrix = context->getTotalMatrix();
+    if (matrix.getType() & ~SkMatrix::kTranslate_Mask)
+        return false;
+
+    for (const FloatRect& rect : m_fillRects) {
+        SkRect deviceRect;
+        matrix.mapRect(&deviceRect, rect);
+        if (!isPixelAligned(deviceRect))
+            return false;
+    }
+    return true;
+}
+
+void CanvasDrawBatch::draw(GraphicsContext* context, bool canMergeFillRects)
+{
+    TRACE_EVENT1("blink", "CanvasDrawBatch::draw", "draws", m_fillRects.size() + m_imageDraws.size());
+
+    if (m_type == FillRects) {
+        if (canMergeFillRects && m_fillRects.size() > 1 && fillRectsArePixelAligned(context)) {
+            // With the non-zero rule, the path covers the union of the rects.
+            Path path;
+            for (const FloatRect& rect : m_fillRects)
+                path.addRect(rect);
+            WindRule windRule = context->fillRule();
+            context->setFillRule(RULE_NONZERO);
+            context->fillPath(path);
+            context->setFillRule(windRule);
+        } else {
+            for (const FloatRect& rect : m_fillRects)
+                context->fillRect(rect);
+        }
+    } else if (m_type == Images) {
+        for (const ImageDraw& draw : m_imageDraws)
+            context->drawImage(m_image.get(), draw.dstRect, draw.srcRect, context->compositeOperation(), context->blendModeOperation());
+    }
+
+    clear();
+}
+
+void CanvasDrawBatch::clear()
+{
+    m_type = NoDraws;
+    m_clipBounds = FloatRect();
+    m_dirtyRect = FloatRect();
+    m_fillRects.shrink(0);
+    m_image.clear();
+    m_imageDraws.shrink(0);
+}
+
+} // namespace blink
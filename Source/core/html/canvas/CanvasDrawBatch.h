@@ -0,0 +1,82 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CanvasDrawBatch_h
+#define CanvasDrawBatch_h
+
+#include "platform/geometry/FloatRect.h"
+#include "platform/graphics/Image.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/PassRefPtr.h"
+#include "wtf/RefPtr.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class GraphicsContext;
+
+// Consecutive fillRect() calls, or drawImage() calls of the same image, that a
+// CanvasRenderingContext2D makes with the same state. The context skips the
+// per-call state validation for draws that join the batch, and issues them to
+// the GraphicsContext together once anything changes the state or reads the
+// canvas.
+class CanvasDrawBatch {
+    WTF_MAKE_NONCOPYABLE(CanvasDrawBatch);
+public:
+    CanvasDrawBatch();
+
+    bool isEmpty() const { return m_type == NoDraws; }
+    bool canAppendFillRect() const { return m_type == FillRects && !isFull(); }
+    bool canAppendImage(Image* image) const { return m_type == Images && m_image == image && !isFull(); }
+
+    // The transformed clip bounds of the context when the batch was started.
+    const FloatRect& clipBounds() const { ASSERT(!isEmpty()); return m_clipBounds; }
+    // The canvas area the batched draws touch.
+    const FloatRect& dirtyRect() const { return m_dirtyRect; }
+
+    // |clipBounds| starts a new batch and is ignored otherwise.
+    void appendFillRect(const FloatRect&, const FloatRect& clipBounds, const FloatRect& dirtyRect);
+    void appendImage(PassRefPtr<Image>, const FloatRect& srcRect, const FloatRect& dstRect, const FloatRect& clipBounds, const FloatRect& dirtyRect);
+
+    // Issues the batched draws to the context, which must be in the state they
+    // were batched with, and empties the batch. Filled rects are merged into a
+    // single path if |canMergeFillRects| is set, i.e. if the fill is opaque,
+    // and they're aligned to device pixels, where overlaps and anti-aliasing
+    // can't make a difference.
+    void draw(GraphicsContext*, bool canMergeFillRects);
+    void clear();
+
+private:
+    enum Type {
+        NoDraws,
+        FillRects,
+        Images
+    };
+
+    struct ImageDraw {
+        ImageDraw(const FloatRect& srcRect, const FloatRect& dstRect)
+            : srcRect(srcRect)
+            , dstRect(dstRect)
+        {
+        }
+
+        FloatRect srcRect;
+        FloatRect dstRect;
+    };
+
+    bool isFull() const;
+    void start(Type, const FloatRect& clipBounds);
+    bool fillRectsArePixelAligned(GraphicsContext*) const;
+
+    Type m_type;
+    FloatRect m_clipBounds;
+    FloatRect m_dirtyRect;
+    Vector<FloatRect> m_fillRects;
+    RefPtr<Image> m_image;
+    Vector<ImageDraw> m_imageDraws;
+};
+
+} // namespace blink
+
+#endif // CanvasDrawBatch_h
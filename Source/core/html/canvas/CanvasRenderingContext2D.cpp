@@ -72,6 +72,7 @@
 #include "wtf/CheckedArithmetic.h"
 #include "wtf/MathExtras.h"
 #include "wtf/OwnPtr.h"
+#include "wtf/TemporaryChange.h"
 #include "wtf/text/StringBuilder.h"
 
 namespace blink {
@@ -102,6 +103,7 @@ CanvasRenderingContext2D::CanvasRenderingContext2D(HTMLCanvasElement* canvas, co
     , m_dispatchContextLostEventTimer(this, &CanvasRenderingContext2D::dispatchContextLostEvent)
     , m_dispatchContextRestoredEventTimer(this, &CanvasRenderingContext2D::dispatchContextRestoredEvent)
     , m_tryRestoreContextEventTimer(this, &CanvasRenderingContext2D::tryRestoreContextEvent)
+    , m_isFlushingDrawBatch(false)
 {
     if (document.settings() && document.settings()->antialiasedClips2dCanvasEnabled())
         m_clipAntialiasing = AntiAliased;
@@ -148,6 +150,7 @@ void CanvasRenderingContext2D::loseContext()
 {
     if (m_isContextLost)
         return;
+    m_drawBatch.clear();
     m_isContextLost = true;
     m_dispatchContextLostEventTimer.startOneShot(0, FROM_HERE);
 }
@@ -236,6 +239,9 @@ void CanvasRenderingContext2D::dispatchContextRestoredEvent(Timer<CanvasRenderin
 
 void CanvasRenderingContext2D::reset()
 {
+    // The canvas is cleared, and the context state the draws were batched with
+    // is gone already.
+    m_drawBatch.clear();
     validateStateStack();
     unwindStateStack();
     m_stateStack.resize(1);
@@ -1280,6 +1286,17 @@ void CanvasRenderingContext2D::fillRect(float x, float y, float width, float hei
     if (!validateRectForCanvas(x, y, width, height))
         return;
 
+    FloatRect rect(x, y, width, height);
+
+    // The state can't have changed since the batch was started, so the checks
+    // below would come out the same.
+    if (m_drawBatch.canAppendFillRect()) {
+        FloatRect dirtyRect;
+        if (computeDirtyRect(rect, m_drawBatch.clipBounds(), &dirtyRect))
+            m_drawBatch.appendFillRect(rect, m_drawBatch.clipBounds(), dirtyRect);
+        return;
+    }
+
     GraphicsContext* c = drawingContext();
     if (!c)
         return;
@@ -1296,14 +1313,22 @@ void CanvasRenderingContext2D::fillRect(float x, float y, float width, float hei
     if (gradient && gradient->isZeroSize())
         return;
 
-    FloatRect rect(x, y, width, height);
+    // Gradients can change after they were set as the fill style, so draws
+    // with them aren't batched. Neither are draws that composite with the
+    // whole canvas.
+    CompositeOperator op = state().m_globalComposite;
+    bool canBatch = !gradient && !isFullCanvasCompositeMode(op) && op != CompositeCopy;
+
     if (rectContainsTransformedRect(rect, clipBounds)) {
-        c->fillRect(rect);
+        if (!canBatch)
+            c->fillRect(rect);
+        else
+            m_drawBatch.appendFillRect(rect, clipBounds, clipBounds);
         didDraw(clipBounds);
-    } else if (isFullCanvasCompositeMode(state().m_globalComposite)) {
+    } else if (isFullCanvasCompositeMode(op)) {
         fullCanvasCompositedDraw(bind(&fillRectOnContext, c, rect));
         didDraw(clipBounds);
-    } else if (state().m_globalComposite == CompositeCopy) {
+    } else if (op == CompositeCopy) {
         clearCanvas();
         c->clearShadow();
         c->fillRect(rect);
@@ -1312,7 +1337,10 @@ void CanvasRenderingContext2D::fillRect(float x, float y, float width, float hei
     } else {
         FloatRect dirtyRect;
         if (computeDirtyRect(rect, clipBounds, &dirtyRect)) {
-            c->fillRect(rect);
+            if (!canBatch)
+                c->fillRect(rect);
+            else
+                m_drawBatch.appendFillRect(rect, clipBounds, dirtyRect);
             didDraw(dirtyRect);
         }
     }
@@ -1481,22 +1509,11 @@ void CanvasRenderingContext2D::drawImageInternal(CanvasImageSource* imageSource,
             return;
     }
 
-    GraphicsContext* c = drawingContext();
-    if (!c)
-        return;
-
-    if (!state().m_invertibleCTM)
-        return;
-
     if (!std::isfinite(dx) || !std::isfinite(dy) || !std::isfinite(dw) || !std::isfinite(dh)
         || !std::isfinite(sx) || !std::isfinite(sy) || !std::isfinite(sw) || !std::isfinite(sh)
         || !dw || !dh || !sw || !sh)
         return;
 
-    FloatRect clipBounds;
-    if (!c->getTransformedClipBounds(&clipBounds))
-        return;
-
     FloatRect srcRect = normalizeRect(FloatRect(sx, sy, sw, sh));
     FloatRect dstRect = normalizeRect(FloatRect(dx, dy, dw, dh));
 
@@ -1507,12 +1524,43 @@ void CanvasRenderingContext2D::drawImageInternal(CanvasImageSource* imageSource,
     if (srcRect.isEmpty())
         return;
 
+    // Videos and canvases may change before a batch is drawn, so only images
+    // and image bitmaps, e.g. sprite sheets, are batched. Draws that composite
+    // with the whole canvas aren't batched either.
+    CompositeOperator op = state().m_globalComposite;
+    bool canBatch = sourceImageStatus == NormalSourceImageStatus && !imageSource->isVideoElement() && !imageSource->isCanvasElement()
+        && !isFullCanvasCompositeMode(op) && op != CompositeCopy;
+
+    // The state can't have changed since the batch was started, so the checks
+    // below would come out the same.
+    if (canBatch && m_drawBatch.canAppendImage(image.get())) {
+        FloatRect dirtyRect;
+        if (computeDirtyRect(dstRect, m_drawBatch.clipBounds(), &dirtyRect))
+            m_drawBatch.appendImage(image.release(), srcRect, dstRect, m_drawBatch.clipBounds(), dirtyRect);
+        if (canvas()->originClean() && wouldTaintOrigin(imageSource))
+            canvas()->setOriginTainted();
+        return;
+    }
+
+    GraphicsContext* c = drawingContext();
+    if (!c)
+        return;
+
+    if (!state().m_invertibleCTM)
+        return;
+
+    FloatRect clipBounds;
+    if (!c->getTransformedClipBounds(&clipBounds))
+        return;
+
     if (imageSource->isVideoElement())
         canvas()->buffer()->willDrawVideo();
 
-    CompositeOperator op = state().m_globalComposite;
     if (rectContainsTransformedRect(dstRect, clipBounds)) {
-        drawImageOnContext(c, imageSource, image.get(), srcRect, dstRect);
+        if (canBatch)
+            m_drawBatch.appendImage(image, srcRect, dstRect, clipBounds, clipBounds);
+        else
+            drawImageOnContext(c, imageSource, image.get(), srcRect, dstRect);
         didDraw(clipBounds);
     } else if (isFullCanvasCompositeMode(op)) {
         fullCanvasCompositedDraw(bind(&drawImageOnContext, c, imageSource, image.get(), srcRect, dstRect));
@@ -1524,7 +1572,10 @@ void CanvasRenderingContext2D::drawImageInternal(CanvasImageSource* imageSource,
     } else {
         FloatRect dirtyRect;
         if (computeDirtyRect(dstRect, clipBounds, &dirtyRect)) {
-            drawImageOnContext(c, imageSource, image.get(), srcRect, dstRect);
+            if (canBatch)
+                m_drawBatch.appendImage(image, srcRect, dstRect, clipBounds, dirtyRect);
+            else
+                drawImageOnContext(c, imageSource, image.get(), srcRect, dstRect);
             didDraw(dirtyRect);
         }
     }
@@ -1667,6 +1718,34 @@ bool CanvasRenderingContext2D::computeDirtyRect(const FloatRect& localRect, cons
     return true;
 }
 
+bool CanvasRenderingContext2D::canMergeFillRects(GraphicsContext* c) const
+{
+    // Only opaque fills come out the same however the rects overlap. The
+    // GraphicsContext has the state the batch was started with, even while
+    // the context's own state is being changed.
+    return !c->fillGradient() && !c->fillPattern() && !c->drawLooper()
+        && c->fillColor().alpha() == 255 && c->getNormalizedAlpha() == 255
+        && c->compositeOperation() == CompositeSourceOver && c->blendModeOperation() == WebBlendModeNormal;
+}
+
+void CanvasRenderingContext2D::flushDrawBatch()
+{
+    // Getting at the GraphicsContext below flushes the batch again.
+    if (m_drawBatch.isEmpty() || m_isFlushingDrawBatch)
+        return;
+    TemporaryChange<bool> isFlushing(m_isFlushingDrawBatch, true);
+
+    GraphicsContext* c = drawingContext();
+    if (!c) {
+        m_drawBatch.clear();
+        return;
+    }
+
+    FloatRect dirtyRect = m_drawBatch.dirtyRect();
+    m_drawBatch.draw(c, canMergeFillRects(c));
+    didDraw(dirtyRect);
+}
+
 void CanvasRenderingContext2D::didDraw(const FloatRect& dirtyRect)
 {
     if (dirtyRect.isEmpty())
@@ -31,6 +31,7 @@
 #include "core/css/CSSFontSelectorClient.h"
 #include "core/html/canvas/Canvas2DContextAttributes.h"
 #include "core/html/canvas/CanvasContextCreationAttributes.h"
+#include "core/html/canvas/CanvasDrawBatch.h"
 #include "core/html/canvas/CanvasPathMethods.h"
 #include "core/html/canvas/CanvasRenderingContext.h"
 #include "core/html/canvas/ClipList.h"
@@ -217,6 +218,11 @@ public:
 
     void restoreCanvasMatrixClipStack();
 
+    // Issues the draws batched so far to the canvas. Needs to be called before
+    // anything changes the drawing state or reads the canvas, which happens
+    // through HTMLCanvasElement::buffer() for all of them.
+    void flushDrawBatch();
+
     virtual void trace(Visitor*) override;
 
 private:
@@ -328,6 +334,7 @@ private:
     void inflateStrokeRect(FloatRect&) const;
 
     void fullCanvasCompositedDraw(PassOwnPtr<Closure> draw);
+    bool canMergeFillRects(GraphicsContext*) const;
 
     void drawFocusIfNeededInternal(const Path&, Element*);
     bool focusRingCallIsValid(const Path&, Element*);
@@ -360,6 +367,8 @@ private:
     Timer<CanvasRenderingContext2D> m_dispatchContextLostEventTimer;
     Timer<CanvasRenderingContext2D> m_dispatchContextRestoredEventTimer;
     Timer<CanvasRenderingContext2D> m_tryRestoreContextEventTimer;
+    CanvasDrawBatch m_drawBatch;
+    bool m_isFlushingDrawBatch;
 };
 
 DEFINE_TYPE_CASTS(CanvasRenderingContext2D, CanvasRenderingContext, context, context->is2d(), context.is2d());
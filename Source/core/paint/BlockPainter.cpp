@@ -196,7 +196,10 @@ void BlockPainter::paintObject(const PaintInfo& paintInfo, const LayoutPoint& pa
     if (paintPhase == PaintPhaseBlockBackground || paintInfo.paintRootBackgroundOnly())
         return;
 
-    if (paintPhase != PaintPhaseSelfOutline) {
+    // Descendants of a skipped layout root are offscreen and haven't been laid out.
+    bool paintDescendants = !m_renderBlock.isSkippedLayoutRoot();
+
+    if (paintPhase != PaintPhaseSelfOutline && paintDescendants) {
         if (m_renderBlock.hasColumns())
             paintColumnContents(paintInfo, scrolledOffset);
         else
@@ -205,10 +208,10 @@ void BlockPainter::paintObject(const PaintInfo& paintInfo, const LayoutPoint& pa
 
     // FIXME: Make this work with multi column layouts. For now don't fill gaps.
     bool isPrinting = m_renderBlock.document().printing();
-    if (!isPrinting && !m_renderBlock.hasColumns())
+    if (!isPrinting && !m_renderBlock.hasColumns() && paintDescendants)
         m_renderBlock.paintSelection(paintInfo, scrolledOffset); // Fill in gaps in selection on lines and between blocks.
 
-    if (paintPhase == PaintPhaseFloat || paintPhase == PaintPhaseSelection || paintPhase == PaintPhaseTextClip) {
+    if (paintDescendants && (paintPhase == PaintPhaseFloat || paintPhase == PaintPhaseSelection || paintPhase == PaintPhaseTextClip)) {
         if (m_renderBlock.hasColumns())
             paintColumnContents(paintInfo, scrolledOffset, true);
         else
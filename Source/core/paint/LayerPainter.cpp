@@ -19,7 +19,9 @@
 #include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/svg/RenderSVGResourceClipper.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/graphics/GraphicsLayer.h"
+#include "platform/graphics/paint/CachedDisplayItem.h"
 #include "platform/graphics/paint/DisplayItemList.h"
 #include "platform/graphics/paint/TransformDisplayItem.h"
 #include "platform/graphics/paint/TransparencyDisplayItem.h"
@@ -76,6 +78,55 @@ void LayerPainter::paintLayer(GraphicsContext* context, const LayerPaintingInfo&
     if (m_renderLayer.paintsWithTransparency(paintingInfo.paintBehavior))
         paintFlags |= PaintLayerHaveTransparency;
 
+    if (!shouldCreateSubsequence(context, paintingInfo, paintFlags)) {
+        paintLayerOrTransformedLayer(context, paintingInfo, paintFlags);
+        return;
+    }
+
+    DisplayItemList* displayItemList = context->displayItemList();
+    DisplayItemClient displayItemClient = m_renderLayer.renderer()->displayItemClient();
+
+    LayoutPoint offsetFromRoot;
+    m_renderLayer.convertToLayerCoords(paintingInfo.rootLayer, offsetFromRoot);
+    ClipRect clipRect = m_renderLayer.clipper().backgroundClipRect(ClipRectsContext(paintingInfo.rootLayer, PaintingClipRects, IgnoreOverlayScrollbarSize, paintingInfo.subPixelAccumulation));
+    LayerSubsequencePaintingState paintingState(paintingInfo, paintFlags, offsetFromRoot, clipRect);
+
+    // Nothing this layer paints has changed since it was last painted the same
+    // way, so the display items it recorded then can be used without a treewalk.
+    if (!m_renderLayer.needsRepaint() && displayItemList->subsequenceCacheIsValid(displayItemClient)
+        && m_renderLayer.subsequencePaintingState() == paintingState) {
+        displayItemList->add(CachedDisplayItem::create(displayItemClient, DisplayItem::BeginSubsequence));
+        return;
+    }
+
+    displayItemList->add(DisplayItem::create(displayItemClient, DisplayItem::BeginSubsequence));
+    paintLayerOrTransformedLayer(context, paintingInfo, paintFlags);
+    displayItemList->add(DisplayItem::create(displayItemClient, DisplayItem::EndSubsequence));
+
+    m_renderLayer.setSubsequencePaintingState(paintingState);
+    m_renderLayer.clearNeedsRepaint();
+}
+
+bool LayerPainter::shouldCreateSubsequence(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
+{
+    if (!RuntimeEnabledFeatures::slimmingPaintEnabled() || !context->displayItemList())
+        return false;
+
+    // The root of a GraphicsLayer is painted once per phase, reflections paint
+    // a layer twice, and paginated layers once per fragment, so their display
+    // items can't be told apart.
+    if (&m_renderLayer == paintingInfo.rootLayer || m_renderLayer.enclosingPaginationLayer())
+        return false;
+    if (paintFlags & (PaintLayerAppliedTransform | PaintLayerUncachedClipRects | PaintLayerPaintingReflection | PaintLayerPaintingOverlayScrollbars))
+        return false;
+
+    // Painting only part of the layer, e.g. its selection, doesn't record
+    // everything that later paints would reuse.
+    return paintingInfo.paintBehavior == PaintBehaviorNormal && !paintingInfo.paintingRoot;
+}
+
+void LayerPainter::paintLayerOrTransformedLayer(GraphicsContext* context, const LayerPaintingInfo& paintingInfo, PaintLayerFlags paintFlags)
+{
     // PaintLayerAppliedTransform is used in RenderReplica, to avoid applying the transform twice.
     if (m_renderLayer.paintsWithTransform(paintingInfo.paintBehavior) && !(paintFlags & PaintLayerAppliedTransform)) {
         paintLayerWithTransform(context, paintingInfo, paintFlags);
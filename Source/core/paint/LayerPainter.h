@@ -31,6 +31,10 @@ public:
 private:
     enum ClipState { HasNotClipped, HasClipped };
 
+    // Returns whether the display items of this layer and its descendants should be
+    // recorded as a subsequence, which later paints can reuse as a whole.
+    bool shouldCreateSubsequence(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
+    void paintLayerOrTransformedLayer(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerContentsAndReflection(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintLayerWithTransform(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags);
     void paintFragmentByApplyingTransform(GraphicsContext*, const LayerPaintingInfo&, PaintLayerFlags, const LayoutPoint& fragmentTranslation);
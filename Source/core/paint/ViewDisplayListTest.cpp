@@ -4,13 +4,16 @@
 
 #include "config.h"
 
+#include "core/HTMLNames.h"
 #include "core/paint/LayerClipRecorder.h"
+#include "core/paint/LayerPainter.h"
 #include "core/paint/RenderDrawingRecorder.h"
 #include "core/rendering/RenderView.h"
 #include "core/rendering/RenderingTestHelper.h"
 #include "core/rendering/compositing/RenderLayerCompositor.h"
 #include "platform/graphics/GraphicsContext.h"
 #include "platform/graphics/GraphicsLayer.h"
+#include "platform/graphics/paint/CachedDisplayItem.h"
 #include "platform/graphics/paint/DisplayItemList.h"
 #include <gtest/gtest.h>
 
@@ -445,5 +448,99 @@ TEST_F(ViewDisplayListTest, CachedDisplayItems)
     EXPECT_FALSE(rootDisplayItemList().clientCacheIsValid(secondRenderer->displayItemClient()));
 }
 
+TEST_F(ViewDisplayListTest, CachedSubsequence)
+{
+    setBodyInnerHTML("<div id='first'><div id='second'></div></div><div id='third'></div>");
+    RenderObject* first = document().body()->firstChild()->renderer();
+    RenderObject* second = document().body()->firstChild()->firstChild()->renderer();
+    RenderObject* third = document().body()->firstChild()->nextSibling()->renderer();
+    GraphicsContext context(nullptr, &rootDisplayItemList());
+
+    rootDisplayItemList().add(DisplayItem::create(first->displayItemClient(), DisplayItem::BeginSubsequence));
+    drawRect(&context, first, PaintPhaseBlockBackground, FloatRect(100, 100, 150, 150));
+    drawRect(&context, second, PaintPhaseBlockBackground, FloatRect(100, 100, 50, 50));
+    rootDisplayItemList().add(DisplayItem::create(first->displayItemClient(), DisplayItem::EndSubsequence));
+    drawRect(&context, third, PaintPhaseBlockBackground, FloatRect(100, 300, 150, 150));
+
+    EXPECT_DISPLAY_LIST(rootDisplayItemList().paintList(), 5,
+        TestDisplayItem(first, DisplayItem::BeginSubsequence),
+        TestDisplayItem(first, DisplayItem::DrawingPaintPhaseBlockBackground),
+        TestDisplayItem(second, DisplayItem::DrawingPaintPhaseBlockBackground),
+        TestDisplayItem(first, DisplayItem::EndSubsequence),
+        TestDisplayItem(third, DisplayItem::DrawingPaintPhaseBlockBackground));
+    EXPECT_TRUE(rootDisplayItemList().subsequenceCacheIsValid(first->displayItemClient()));
+    EXPECT_EQ(0u, rootDisplayItemList().reusedItemCount());
+    EXPECT_EQ(5u, rootDisplayItemList().repaintedItemCount());
+    DisplayItem* secondDisplayItem = rootDisplayItemList().paintList()[2].get();
+
+    // The cached subsequence stands for everything between its begin and end.
+    rootDisplayItemList().invalidate(third->displayItemClient());
+    rootDisplayItemList().add(CachedDisplayItem::create(first->displayItemClient(), DisplayItem::BeginSubsequence));
+    drawRect(&context, third, PaintPhaseBlockBackground, FloatRect(100, 300, 150, 150));
+
+    EXPECT_DISPLAY_LIST(rootDisplayItemList().paintList(), 5,
+        TestDisplayItem(first, DisplayItem::BeginSubsequence),
+        TestDisplayItem(first, DisplayItem::DrawingPaintPhaseBlockBackground),
+        TestDisplayItem(second, DisplayItem::DrawingPaintPhaseBlockBackground),
+        TestDisplayItem(first, DisplayItem::EndSubsequence),
+        TestDisplayItem(third, DisplayItem::DrawingPaintPhaseBlockBackground));
+    EXPECT_EQ(secondDisplayItem, rootDisplayItemList().paintList()[2].get());
+    EXPECT_EQ(4u, rootDisplayItemList().reusedItemCount());
+    EXPECT_EQ(1u, rootDisplayItemList().repaintedItemCount());
+
+    rootDisplayItemList().invalidate(first->displayItemClient());
+    EXPECT_FALSE(rootDisplayItemList().subsequenceCacheIsValid(first->displayItemClient()));
+}
+
+static size_t findDisplayItem(const PaintList& list, const RenderObject* renderer, DisplayItem::Type type)
+{
+    for (size_t index = 0; index < list.size(); ++index) {
+        if (list[index]->client() == renderer->displayItemClient() && list[index]->type() == type)
+            return index;
+    }
+    return kNotFound;
+}
+
+TEST_F(ViewDisplayListTest, UnchangedLayerReusesSubsequence)
+{
+    setBodyInnerHTML("<div id='unchanged' style='position: relative; width: 100px; height: 100px; background-color: blue'>"
+        "<div style='width: 50px; height: 50px; background-color: green'></div></div>"
+        "<div id='changed' style='position: relative; width: 100px; height: 100px; background-color: blue'>"
+        "<div id='content' style='width: 50px; height: 50px; background-color: green'></div></div>");
+    RenderObject* unchanged = document().getElementById("unchanged")->renderer();
+    RenderObject* changed = document().getElementById("changed")->renderer();
+    RenderLayer* rootLayer = renderView()->layer();
+    LayerPaintingInfo paintingInfo(rootLayer, LayoutRect(0, 0, 800, 600), PaintBehaviorNormal, LayoutSize());
+    GraphicsContext context(nullptr, &rootDisplayItemList());
+
+    LayerPainter(*rootLayer).paintLayer(&context, paintingInfo, PaintLayerPaintingCompositingAllPhases);
+    const PaintList& paintList = rootDisplayItemList().paintList();
+    size_t unchangedBegin = findDisplayItem(paintList, unchanged, DisplayItem::BeginSubsequence);
+    size_t unchangedEnd = findDisplayItem(paintList, unchanged, DisplayItem::EndSubsequence);
+    ASSERT_NE(kNotFound, unchangedBegin);
+    ASSERT_NE(kNotFound, unchangedEnd);
+    ASSERT_NE(kNotFound, findDisplayItem(paintList, changed, DisplayItem::BeginSubsequence));
+    EXPECT_EQ(0u, rootDisplayItemList().reusedItemCount());
+    Vector<DisplayItem*> unchangedDisplayItems;
+    for (size_t index = unchangedBegin; index <= unchangedEnd; ++index)
+        unchangedDisplayItems.append(paintList[index].get());
+    EXPECT_LT(2u, unchangedDisplayItems.size());
+
+    document().getElementById("content")->setAttribute(HTMLNames::styleAttr, "width: 50px; height: 50px; background-color: red");
+    document().view()->updateLayoutAndStyleForPainting();
+    EXPECT_FALSE(unchanged->enclosingLayer()->needsRepaint());
+    EXPECT_TRUE(changed->enclosingLayer()->needsRepaint());
+
+    LayerPainter(*rootLayer).paintLayer(&context, paintingInfo, PaintLayerPaintingCompositingAllPhases);
+    const PaintList& updatedPaintList = rootDisplayItemList().paintList();
+    EXPECT_FALSE(changed->enclosingLayer()->needsRepaint());
+    unchangedBegin = findDisplayItem(updatedPaintList, unchanged, DisplayItem::BeginSubsequence);
+    ASSERT_NE(kNotFound, unchangedBegin);
+    for (size_t index = 0; index < unchangedDisplayItems.size(); ++index)
+        EXPECT_EQ(unchangedDisplayItems[index], updatedPaintList[unchangedBegin + index].get());
+    EXPECT_LT(0u, rootDisplayItemList().repaintedItemCount());
+    EXPECT_LT(rootDisplayItemList().repaintedItemCount(), rootDisplayItemList().reusedItemCount());
+}
+
 } // anonymous namespace
 } // namespace blink
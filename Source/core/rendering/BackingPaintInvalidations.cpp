@@ -0,0 +1,78 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/BackingPaintInvalidations.h"
+
+#include "core/rendering/RenderLayerModelObject.h"
+#include "platform/TraceEvent.h"
+
+namespace blink {
+
+// Past this many rects a partition takes further rects as they are.
+static const size_t maxPendingRectsPerContainer = 64;
+
+static float area(const LayoutRect& rect)
+{
+    return rect.width().toFloat() * rect.height().toFloat();
+}
+
+BackingPaintInvalidations::BackingPaintInvalidations()
+{
+}
+
+BackingPaintInvalidations::~BackingPaintInvalidations()
+{
+    ASSERT(m_containers.isEmpty());
+}
+
+void BackingPaintInvalidations::add(const RenderLayerModelObject& paintInvalidationContainer, const LayoutRect& rect, PaintInvalidationReason reason)
+{
+    HashMap<const RenderLayerModelObject*, OwnPtr<PendingRects> >::AddResult result = m_rects.add(&paintInvalidationContainer, nullptr);
+    if (result.isNewEntry) {
+        result.storedValue->value = adoptPtr(new PendingRects);
+        m_containers.append(&paintInvalidationContainer);
+    }
+    PendingRects& rects = *result.storedValue->value;
+
+    for (size_t i = 0; i < rects.size(); ++i) {
+        LayoutRect& pendingRect = rects[i].rect;
+        if (pendingRect.contains(rect))
+            return;
+        if (!pendingRect.intersects(rect))
+            continue;
+        // Only coalesce rects if that doesn't invalidate more than both do.
+        LayoutRect unitedRect = unionRect(pendingRect, rect);
+        if (area(unitedRect) <= area(pendingRect) + area(rect)) {
+            pendingRect = unitedRect;
+            return;
+        }
+    }
+
+    if (rects.size() >= maxPendingRectsPerContainer) {
+        invalidateBacking(paintInvalidationContainer, rect, reason);
+        return;
+    }
+    rects.append(PendingRect(rect, reason));
+}
+
+void BackingPaintInvalidations::flush()
+{
+    for (size_t i = 0; i < m_containers.size(); ++i) {
+        const RenderLayerModelObject* container = m_containers[i];
+        const PendingRects& rects = *m_rects.get(container);
+        TRACE_EVENT2("blink", "BackingPaintInvalidations::flush", "container", container->debugName().ascii(), "rects", static_cast<unsigned>(rects.size()));
+        for (size_t j = 0; j < rects.size(); ++j)
+            invalidateBacking(*container, rects[j].rect, rects[j].reason);
+    }
+    m_containers.clear();
+    m_rects.clear();
+}
+
+void BackingPaintInvalidations::invalidateBacking(const RenderLayerModelObject& paintInvalidationContainer, const LayoutRect& rect, PaintInvalidationReason reason)
+{
+    paintInvalidationContainer.setBackingNeedsPaintInvalidationInRect(rect, reason);
+}
+
+} // namespace blink
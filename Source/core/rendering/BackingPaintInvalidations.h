@@ -0,0 +1,57 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BackingPaintInvalidations_h
+#define BackingPaintInvalidations_h
+
+#include "platform/geometry/LayoutRect.h"
+#include "platform/graphics/PaintInvalidationReason.h"
+#include "wtf/HashMap.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class RenderLayerModelObject;
+
+// Invalidation rects issued to composited backings during a paint invalidation
+// tree walk. The walk is partitioned by paint invalidation container: rects for
+// the same backing are coalesced as they come in when they overlap enough, and
+// each partition is flushed to its GraphicsLayers once the walk is done rather
+// than once per renderer.
+class BackingPaintInvalidations {
+    WTF_MAKE_NONCOPYABLE(BackingPaintInvalidations);
+public:
+    BackingPaintInvalidations();
+    virtual ~BackingPaintInvalidations();
+
+    void add(const RenderLayerModelObject& paintInvalidationContainer, const LayoutRect&, PaintInvalidationReason);
+    void flush();
+
+protected:
+    // Virtual so that tests can record the rects instead.
+    virtual void invalidateBacking(const RenderLayerModelObject& paintInvalidationContainer, const LayoutRect&, PaintInvalidationReason);
+
+private:
+    struct PendingRect {
+        PendingRect(const LayoutRect& rect, PaintInvalidationReason reason)
+            : rect(rect)
+            , reason(reason)
+        {
+        }
+
+        LayoutRect rect;
+        PaintInvalidationReason reason;
+    };
+    typedef Vector<PendingRect> PendingRects;
+
+    // In the order the partitions got their first rect.
+    Vector<const RenderLayerModelObject*> m_containers;
+    HashMap<const RenderLayerModelObject*, OwnPtr<PendingRects> > m_rects;
+};
+
+} // namespace blink
+
+#endif // BackingPaintInvalidations_h
@@ -0,0 +1,203 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/BackingPaintInvalidations.h"
+
+#include "core/HTMLNames.h"
+#include "core/rendering/RenderBoxModelObject.h"
+#include "core/rendering/RenderLayer.h"
+#include "core/rendering/RenderView.h"
+#include "core/rendering/RenderingTestHelper.h"
+#include "core/rendering/compositing/RenderLayerCompositor.h"
+#include "platform/JSONValues.h"
+#include "platform/graphics/GraphicsLayer.h"
+#include <gtest/gtest.h>
+
+namespace blink {
+
+namespace {
+
+class RecordingBackingPaintInvalidations : public BackingPaintInvalidations {
+public:
+    struct Invalidation {
+        const RenderLayerModelObject* container;
+        LayoutRect rect;
+        PaintInvalidationReason reason;
+    };
+
+    const Vector<Invalidation>& invalidations() const { return m_invalidations; }
+
+private:
+    virtual void invalidateBacking(const RenderLayerModelObject& container, const LayoutRect& rect, PaintInvalidationReason reason) override
+    {
+        Invalidation invalidation = { &container, rect, reason };
+        m_invalidations.append(invalidation);
+    }
+
+    Vector<Invalidation> m_invalidations;
+};
+
+class BackingPaintInvalidationsTest : public RenderingTest {
+protected:
+    virtual void SetUp() override
+    {
+        RenderingTest::SetUp();
+        setBodyInnerHTML("<div id='first'></div><div id='second'></div>");
+    }
+
+    const RenderLayerModelObject& container(const char* id) const
+    {
+        return *toRenderBoxModelObject(document().getElementById(id)->renderer());
+    }
+
+    RecordingBackingPaintInvalidations m_invalidations;
+};
+
+TEST_F(BackingPaintInvalidationsTest, OverlappingRectsAreMerged)
+{
+    m_invalidations.add(container("first"), LayoutRect(0, 0, 100, 100), PaintInvalidationFull);
+    m_invalidations.add(container("first"), LayoutRect(50, 0, 100, 100), PaintInvalidationFull);
+    EXPECT_TRUE(m_invalidations.invalidations().isEmpty());
+
+    m_invalidations.flush();
+    ASSERT_EQ(1u, m_invalidations.invalidations().size());
+    EXPECT_EQ(LayoutRect(0, 0, 150, 100), m_invalidations.invalidations()[0].rect);
+}
+
+TEST_F(BackingPaintInvalidationsTest, ContainedRectIsDropped)
+{
+    m_invalidations.add(container("first"), LayoutRect(0, 0, 100, 100), PaintInvalidationFull);
+    m_invalidations.add(container("first"), LayoutRect(10, 10, 10, 10), PaintInvalidationIncremental);
+    m_invalidations.flush();
+
+    ASSERT_EQ(1u, m_invalidations.invalidations().size());
+    EXPECT_EQ(LayoutRect(0, 0, 100, 100), m_invalidations.invalidations()[0].rect);
+    EXPECT_EQ(PaintInvalidationFull, m_invalidations.invalidations()[0].reason);
+}
+
+TEST_F(BackingPaintInvalidationsTest, RectsAreNotMergedOverTheirArea)
+{
+    // The union of these two overlapping strips is ten times their area.
+    m_invalidations.add(container("first"), LayoutRect(0, 0, 100, 10), PaintInvalidationFull);
+    m_invalidations.add(container("first"), LayoutRect(90, 0, 10, 100), PaintInvalidationFull);
+    // Disjoint rects are never merged.
+    m_invalidations.add(container("first"), LayoutRect(200, 200, 10, 10), PaintInvalidationFull);
+    m_invalidations.flush();
+
+    ASSERT_EQ(3u, m_invalidations.invalidations().size());
+    EXPECT_EQ(LayoutRect(0, 0, 100, 10), m_invalidations.invalidations()[0].rect);
+    EXPECT_EQ(LayoutRect(90, 0, 10, 100), m_invalidations.invalidations()[1].rect);
+    EXPECT_EQ(LayoutRect(200, 200, 10, 10), m_invalidations.invalidations()[2].rect);
+}
+
+TEST_F(BackingPaintInvalidationsTest, RectsForDifferentContainersAreNotMerged)
+{
+    m_invalidations.add(container("first"), LayoutRect(0, 0, 100, 100), PaintInvalidationFull);
+    m_invalidations.add(container("second"), LayoutRect(0, 0, 100, 100), PaintInvalidationFull);
+    m_invalidations.flush();
+
+    ASSERT_EQ(2u, m_invalidations.invalidations().size());
+    EXPECT_EQ(&container("first"), m_invalidations.invalidations()[0].container);
+    EXPECT_EQ(&container("second"), m_invalidations.invalidations()[1].container);
+}
+
+TEST_F(BackingPaintInvalidationsTest, FlushOrder)
+{
+    // Containers are flushed in the order they got their first rect, and each
+    // container's rects in the order they were added.
+    m_invalidations.add(container("second"), LayoutRect(0, 0, 10, 10), PaintInvalidationFull);
+    m_invalidations.add(container("first"), LayoutRect(20, 0, 10, 10), PaintInvalidationFull);
+    m_invalidations.add(container("second"), LayoutRect(40, 0, 10, 10), PaintInvalidationFull);
+    m_invalidations.add(container("first"), LayoutRect(60, 0, 10, 10), PaintInvalidationFull);
+    m_invalidations.flush();
+
+    const Vector<RecordingBackingPaintInvalidations::Invalidation>& invalidations = m_invalidations.invalidations();
+    ASSERT_EQ(4u, invalidations.size());
+    EXPECT_EQ(&container("second"), invalidations[0].container);
+    EXPECT_EQ(LayoutRect(0, 0, 10, 10), invalidations[0].rect);
+    EXPECT_EQ(&container("second"), invalidations[1].container);
+    EXPECT_EQ(LayoutRect(40, 0, 10, 10), invalidations[1].rect);
+    EXPECT_EQ(&container("first"), invalidations[2].container);
+    EXPECT_EQ(LayoutRect(20, 0, 10, 10), invalidations[2].rect);
+    EXPECT_EQ(&container("first"), invalidations[3].container);
+    EXPECT_EQ(LayoutRect(60, 0, 10, 10), invalidations[3].rect);
+
+    // Flushing again issues nothing new.
+    m_invalidations.flush();
+    EXPECT_EQ(4u, invalidations.size());
+}
+
+TEST_F(BackingPaintInvalidationsTest, RectsPastTheLimitAreIssuedImmediately)
+{
+    const int pendingRectLimit = 64;
+    for (int i = 0; i < pendingRectLimit; ++i)
+        m_invalidations.add(container("first"), LayoutRect(i * 20, 0, 10, 10), PaintInvalidationFull);
+    EXPECT_TRUE(m_invalidations.invalidations().isEmpty());
+
+    m_invalidations.add(container("first"), LayoutRect(0, 20, 10, 10), PaintInvalidationIncremental);
+    ASSERT_EQ(1u, m_invalidations.invalidations().size());
+    EXPECT_EQ(LayoutRect(0, 20, 10, 10), m_invalidations.invalidations()[0].rect);
+    EXPECT_EQ(PaintInvalidationIncremental, m_invalidations.invalidations()[0].reason);
+
+    // Rects that merge into a pending one still do.
+    m_invalidations.add(container("first"), LayoutRect(2, 2, 5, 5), PaintInvalidationFull);
+    EXPECT_EQ(1u, m_invalidations.invalidations().size());
+
+    m_invalidations.flush();
+    EXPECT_EQ(static_cast<size_t>(pendingRectLimit + 1), m_invalidations.invalidations().size());
+}
+
+class BackingPaintInvalidationsTreeWalkTest : public RenderingTest {
+protected:
+    virtual void SetUp() override
+    {
+        RenderingTest::SetUp();
+        setBodyInnerHTML(
+            "<div id='container' style='will-change: transform; position: relative; width: 300px; height: 300px; background-color: white'>"
+            "<div id='left' style='position: absolute; left: 0; top: 0; width: 100px; height: 100px; background-color: red'></div>"
+            "<div id='right' style='position: absolute; left: 50px; top: 0; width: 100px; height: 100px; background-color: red'></div>"
+            "</div>");
+        enableCompositing();
+    }
+
+    void changeBackgroundOfBothBoxes()
+    {
+        document().getElementById("left")->setAttribute(HTMLNames::styleAttr, "position: absolute; left: 0; top: 0; width: 100px; height: 100px; background-color: green");
+        document().getElementById("right")->setAttribute(HTMLNames::styleAttr, "position: absolute; left: 50px; top: 0; width: 100px; height: 100px; background-color: green");
+        document().view()->updateLayoutAndStyleForPainting();
+    }
+
+    // The rects the container's GraphicsLayer got invalidated with, as JSON.
+    String containerRepaintRects() const
+    {
+        RenderLayer* layer = toRenderBoxModelObject(document().getElementById("container")->renderer())->layer();
+        GraphicsLayer::RenderingContextMap renderingContextMap;
+        RefPtr<JSONArray> rects = layer->graphicsLayerBacking()->layerTreeAsJSON(LayerTreeIncludesPaintInvalidationRects, renderingContextMap)->getArray("repaintRects");
+        return rects ? rects->toJSONString() : String();
+    }
+};
+
+TEST_F(BackingPaintInvalidationsTreeWalkTest, RectsAreMergedWhenNotTrackingPaintInvalidations)
+{
+    // Only record the rects the GraphicsLayers get. The FrameView isn't
+    // tracking, so the tree walk takes the same path as outside of tests.
+    document().view()->renderView()->compositor()->setTracksPaintInvalidations(true);
+    ASSERT_FALSE(document().view()->isTrackingPaintInvalidations());
+
+    changeBackgroundOfBothBoxes();
+    EXPECT_EQ("[[0,0,150,100]]", containerRepaintRects());
+}
+
+TEST_F(BackingPaintInvalidationsTreeWalkTest, RectsAreIssuedAsTheyComeWhenTrackingPaintInvalidations)
+{
+    document().view()->setTracksPaintInvalidations(true);
+
+    changeBackgroundOfBothBoxes();
+    EXPECT_EQ("[[50,0,100,100],[0,0,100,100]]", containerRepaintRects());
+}
+
+} // namespace
+
+} // namespace blink
@@ -159,6 +159,30 @@ protected:
     virtual bool updateOffsetIfNeeded(const FloatingObject&) override final;
 };
 
+class FindNextFloatLogicalBottomAdapter {
+public:
+    typedef FloatingObjectInterval IntervalType;
+
+    FindNextFloatLogicalBottomAdapter(const RenderBlockFlow* renderer, LayoutUnit belowLogicalHeight, ShapeOutsideFloatOffsetMode offsetMode)
+        : m_renderer(renderer)
+        , m_belowLogicalHeight(belowLogicalHeight)
+        , m_offsetMode(offsetMode)
+    {
+    }
+
+    // Only floats reaching below the given height matter, however far below that they start.
+    int lowValue() const { return m_belowLogicalHeight.floor(); }
+    int highValue() const { return std::numeric_limits<int>::max(); }
+    void collectIfNeeded(const IntervalType&);
+
+    LayoutUnit nextLogicalBottom() const { return m_nextLogicalBottom; }
+
+private:
+    const RenderBlockFlow* m_renderer;
+    LayoutUnit m_belowLogicalHeight;
+    ShapeOutsideFloatOffsetMode m_offsetMode;
+    LayoutUnit m_nextLogicalBottom;
+};
 
 FloatingObjects::~FloatingObjects()
 {
@@ -263,6 +287,23 @@ void FloatingObjects::setCachedLowestFloatLogicalBottom(bool isHorizontal, Float
     m_lowestFloatBottomCache[floatIndex].dirty = false;
 }
 
+void FloatingObjects::updateLowestFloatLogicalBottomCacheForAddedFloat(const FloatingObject* floatingObject)
+{
+    // A new float can only lower the bottom, so there is no need to look at the others again.
+    FloatBottomCachedValue& cachedValue = m_lowestFloatBottomCache[static_cast<int>(floatingObject->type()) - 1];
+    if (cachedValue.dirty || m_cachedHorizontalWritingMode != m_horizontalWritingMode)
+        return;
+    cachedValue.value = std::max(cachedValue.value, m_renderer->logicalBottomForFloat(floatingObject));
+}
+
+void FloatingObjects::updateLowestFloatLogicalBottomCacheForRemovedFloat(const FloatingObject* floatingObject)
+{
+    // Removing a float that doesn't reach the cached bottom leaves it unchanged.
+    FloatBottomCachedValue& cachedValue = m_lowestFloatBottomCache[static_cast<int>(floatingObject->type()) - 1];
+    if (m_renderer->logicalBottomForFloat(floatingObject) >= cachedValue.value)
+        cachedValue.dirty = true;
+}
+
 void FloatingObjects::markLowestFloatLogicalBottomCacheAsDirty()
 {
     for (size_t i = 0; i < sizeof(m_lowestFloatBottomCache) / sizeof(FloatBottomCachedValue); ++i)
@@ -313,7 +354,7 @@ void FloatingObjects::addPlacedObject(FloatingObject* floatingObject)
 #if ENABLE(ASSERT)
     floatingObject->setIsInPlacedTree(true);
 #endif
-    markLowestFloatLogicalBottomCacheAsDirty();
+    updateLowestFloatLogicalBottomCacheForAddedFloat(floatingObject);
 }
 
 void FloatingObjects::removePlacedObject(FloatingObject* floatingObject)
@@ -325,11 +366,11 @@ void FloatingObjects::removePlacedObject(FloatingObject* floatingObject)
         ASSERT_UNUSED(removed, removed);
     }
 
+    updateLowestFloatLogicalBottomCacheForRemovedFloat(floatingObject);
     floatingObject->setIsPlaced(false);
 #if ENABLE(ASSERT)
     floatingObject->setIsInPlacedTree(false);
 #endif
-    markLowestFloatLogicalBottomCacheAsDirty();
 }
 
 FloatingObject* FloatingObjects::add(PassOwnPtr<FloatingObject> floatingObject)
@@ -339,7 +380,6 @@ FloatingObject* FloatingObjects::add(PassOwnPtr<FloatingObject> floatingObject)
     m_set.add(adoptPtr(newObject));
     if (newObject->isPlaced())
         addPlacedObject(newObject);
-    markLowestFloatLogicalBottomCacheAsDirty();
     return newObject;
 }
 
@@ -350,7 +390,6 @@ void FloatingObjects::remove(FloatingObject* toBeRemoved)
     ASSERT(floatingObject->isPlaced() || !floatingObject->isInPlacedTree());
     if (floatingObject->isPlaced())
         removePlacedObject(floatingObject.get());
-    markLowestFloatLogicalBottomCacheAsDirty();
     ASSERT(!floatingObject->originatingLine());
 }
 
@@ -409,6 +448,14 @@ LayoutUnit FloatingObjects::logicalRightOffset(LayoutUnit fixedOffset, LayoutUni
     return std::min(fixedOffset, adapter.offset());
 }
 
+LayoutUnit FloatingObjects::nextLogicalBottomBelow(LayoutUnit logicalHeight, ShapeOutsideFloatOffsetMode offsetMode)
+{
+    FindNextFloatLogicalBottomAdapter adapter(m_renderer, logicalHeight, offsetMode);
+    placedFloatsTree().allOverlapsWithAdapter(adapter);
+
+    return adapter.nextLogicalBottom();
+}
+
 FloatingObjects::FloatBottomCachedValue::FloatBottomCachedValue()
     : value(0)
     , dirty(true)
@@ -480,6 +527,24 @@ inline void ComputeFloatOffsetAdapter<FloatTypeValue>::collectIfNeeded(const Int
         m_outermostFloat = floatingObject;
 }
 
+inline void FindNextFloatLogicalBottomAdapter::collectIfNeeded(const IntervalType& interval)
+{
+    if (interval.high() < lowValue())
+        return;
+
+    const FloatingObject* floatingObject = interval.data();
+    LayoutUnit floatLogicalBottom = m_renderer->logicalBottomForFloat(floatingObject);
+    ShapeOutsideInfo* shapeOutside = floatingObject->renderer()->shapeOutsideInfo();
+    if (shapeOutside && m_offsetMode == ShapeOutsideFloatShapeOffset) {
+        LayoutUnit shapeLogicalBottom = m_renderer->logicalTopForFloat(floatingObject) + m_renderer->marginBeforeForChild(*floatingObject->renderer()) + shapeOutside->shapeLogicalBottom();
+        // Use the shapeLogicalBottom unless it extends outside of the margin box, in which case it is clipped.
+        if (shapeLogicalBottom < floatLogicalBottom)
+            floatLogicalBottom = shapeLogicalBottom;
+    }
+    if (floatLogicalBottom > m_belowLogicalHeight)
+        m_nextLogicalBottom = m_nextLogicalBottom ? std::min(floatLogicalBottom, m_nextLogicalBottom) : floatLogicalBottom;
+}
+
 template<>
 inline bool ComputeFloatOffsetForLineLayoutAdapter<FloatingObject::FloatLeft>::updateOffsetIfNeeded(const FloatingObject& floatingObject)
 {
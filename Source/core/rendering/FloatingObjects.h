@@ -158,11 +158,15 @@ public:
     LayoutUnit logicalRightOffsetForPositioningFloat(LayoutUnit fixedOffset, LayoutUnit logicalTop, LayoutUnit* heightRemaining);
 
     LayoutUnit lowestFloatLogicalBottom(FloatingObject::Type);
+    // Returns the closest logical bottom of a placed float below the given height, or 0 if there is none.
+    LayoutUnit nextLogicalBottomBelow(LayoutUnit logicalHeight, ShapeOutsideFloatOffsetMode);
 
 private:
     bool hasLowestFloatLogicalBottomCached(bool isHorizontal, FloatingObject::Type floatType) const;
     LayoutUnit getCachedlowestFloatLogicalBottom(FloatingObject::Type floatType) const;
     void setCachedLowestFloatLogicalBottom(bool isHorizontal, FloatingObject::Type floatType, LayoutUnit value);
+    void updateLowestFloatLogicalBottomCacheForAddedFloat(const FloatingObject*);
+    void updateLowestFloatLogicalBottomCacheForRemovedFloat(const FloatingObject*);
     void markLowestFloatLogicalBottomCacheAsDirty();
 
     void computePlacedFloatsTree();
@@ -45,6 +45,7 @@
 #ifndef LayerPaintingInfo_h
 #define LayerPaintingInfo_h
 
+#include "core/rendering/ClipRect.h"
 #include "core/rendering/PaintInfo.h"
 #include "platform/geometry/LayoutRect.h"
 
@@ -90,6 +91,35 @@ struct LayerPaintingInfo {
     bool clipToDirtyRect;
 };
 
+// What a layer was painted with when it last recorded a display item subsequence.
+// The subsequence can only stand in for painting the layer again if none of this
+// changed, e.g. an ancestor's clip or the layer's position in its backing.
+struct LayerSubsequencePaintingState {
+    LayerSubsequencePaintingState()
+        : paintFlags(0)
+    { }
+    LayerSubsequencePaintingState(const LayerPaintingInfo& paintingInfo, PaintLayerFlags inPaintFlags, const LayoutPoint& inOffsetFromRoot, const ClipRect& inClipRect)
+        : paintDirtyRect(paintingInfo.paintDirtyRect)
+        , subPixelAccumulation(paintingInfo.subPixelAccumulation)
+        , offsetFromRoot(inOffsetFromRoot)
+        , clipRect(inClipRect)
+        , paintFlags(inPaintFlags)
+    { }
+
+    bool operator==(const LayerSubsequencePaintingState& other) const
+    {
+        return paintDirtyRect == other.paintDirtyRect && subPixelAccumulation == other.subPixelAccumulation
+            && offsetFromRoot == other.offsetFromRoot && clipRect == other.clipRect && paintFlags == other.paintFlags;
+    }
+    bool operator!=(const LayerSubsequencePaintingState& other) const { return !(*this == other); }
+
+    LayoutRect paintDirtyRect;
+    LayoutSize subPixelAccumulation;
+    LayoutPoint offsetFromRoot;
+    ClipRect clipRect;
+    PaintLayerFlags paintFlags;
+};
+
 } // namespace blink
 
 #endif // LayerPaintingInfo_h
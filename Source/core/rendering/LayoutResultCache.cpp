@@ -0,0 +1,47 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/LayoutResultCache.h"
+
+namespace blink {
+
+bool LayoutResultCache::find(const RenderBox& child, LayoutUnit containingBlockLogicalWidth, Result& result) const
+{
+    HashMap<const RenderBox*, Entries>::const_iterator it = m_entries.find(&child);
+    if (it == m_entries.end())
+        return false;
+    for (size_t i = 0; i < it->value.size(); ++i) {
+        if (it->value[i].containingBlockLogicalWidth == containingBlockLogicalWidth) {
+            result = it->value[i].result;
+            return true;
+        }
+    }
+    return false;
+}
+
+void LayoutResultCache::add(const RenderBox& child, LayoutUnit containingBlockLogicalWidth, const Result& result)
+{
+    Entries& entries = m_entries.add(&child, Entries()).storedValue->value;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].containingBlockLogicalWidth == containingBlockLogicalWidth) {
+            entries.remove(i);
+            break;
+        }
+    }
+    // Keep the most recent results at the end.
+    if (entries.size() == maxEntriesPerChild)
+        entries.remove(0);
+    Entry entry;
+    entry.containingBlockLogicalWidth = containingBlockLogicalWidth;
+    entry.result = result;
+    entries.append(entry);
+}
+
+void LayoutResultCache::remove(const RenderBox& child)
+{
+    m_entries.remove(&child);
+}
+
+} // namespace blink
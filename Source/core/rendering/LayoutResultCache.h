@@ -0,0 +1,51 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LayoutResultCache_h
+#define LayoutResultCache_h
+
+#include "platform/LayoutUnit.h"
+#include "wtf/HashMap.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class RenderBox;
+
+// Containers such as grid lay their children out once with a provisional
+// containing block size only to measure them, then again with the final one.
+// When the container is laid out again and a child hasn't changed, laying it
+// out with the provisional size again would give the same result, so the last
+// few results for each child are kept here, keyed by the containing block
+// size they were laid out with.
+//
+// The cache doesn't track changes to the children: the container must remove
+// a child's results whenever the child needs layout before it is measured.
+class LayoutResultCache {
+public:
+    struct Result {
+        LayoutUnit logicalHeight;
+        // Percentage margins depend on the containing block width too.
+        LayoutUnit marginLogicalHeight;
+    };
+
+    bool find(const RenderBox&, LayoutUnit containingBlockLogicalWidth, Result&) const;
+    void add(const RenderBox&, LayoutUnit containingBlockLogicalWidth, const Result&);
+    void remove(const RenderBox&);
+    void clear() { m_entries.clear(); }
+
+private:
+    struct Entry {
+        LayoutUnit containingBlockLogicalWidth;
+        Result result;
+    };
+
+    static const size_t maxEntriesPerChild = 2;
+    typedef Vector<Entry, maxEntriesPerChild> Entries;
+    HashMap<const RenderBox*, Entries> m_entries;
+};
+
+} // namespace blink
+
+#endif // LayoutResultCache_h
@@ -284,6 +284,11 @@ void RenderBlock::willBeDestroyed()
     if (UNLIKELY(gDelayedUpdateScrollInfoSet != 0))
         gDelayedUpdateScrollInfoSet->remove(this);
 
+    if (FrameView* frameView = this->frameView()) {
+        if (frameView->hasSkippedLayoutRoots())
+            frameView->removeSkippedLayoutRoot(*this);
+    }
+
     if (TextAutosizer* textAutosizer = document().textAutosizer())
         textAutosizer->destroy(this);
 
@@ -366,6 +371,16 @@ void RenderBlock::styleDidChange(StyleDifference diff, const RenderStyle* oldSty
     // end up being the same. We keep track of this change so in layoutBlock, we can know to set relayoutChildren=true.
     m_widthAvailableToChildrenChanged |= oldStyle && diff.needsFullLayout() && needsLayout() && borderOrPaddingLogicalWidthChanged(oldStyle, newStyle);
 
+    // A block that loses strict containment is painted and hit tested like any
+    // other, so lay out the descendants its skipped layout left dirty.
+    if (oldStyle && oldStyle->hasStrictContainment() && !newStyle->hasStrictContainment()) {
+        FrameView* frameView = this->frameView();
+        if (frameView && frameView->isSkippedLayoutRoot(*this)) {
+            m_widthAvailableToChildrenChanged |= frameView->takeSkippedLayoutRoot(*this);
+            setNeedsLayoutAndFullPaintInvalidation();
+        }
+    }
+
     // If the style has unloaded images, want to notify the ResourceLoadPriorityOptimizer so that
     // network priorities can be set.
     Vector<ImageResource*> images;
@@ -378,6 +393,10 @@ void RenderBlock::styleDidChange(StyleDifference diff, const RenderStyle* oldSty
 
 void RenderBlock::invalidatePaintOfSubtreesIfNeeded(const PaintInvalidationState& childPaintInvalidationState)
 {
+    // Descendants of a skipped layout root have no valid geometry to invalidate.
+    if (isSkippedLayoutRoot())
+        return;
+
     RenderBox::invalidatePaintOfSubtreesIfNeeded(childPaintInvalidationState);
 
     // Take care of positioned objects. This is required as PaintInvalidationState keeps a single clip rect.
@@ -2217,7 +2236,7 @@ bool RenderBlock::nodeAtPoint(const HitTestRequest& request, HitTestResult& resu
                 checkChildren = locationInContainer.intersects(clipRect);
         }
     }
-    if (checkChildren) {
+    if (checkChildren && !isSkippedLayoutRoot()) {
         // Hit test descendants first.
         LayoutSize scrolledOffset(localOffset);
         if (hasOverflowClip())
@@ -350,6 +350,19 @@ void RenderBlockFlow::layoutBlock(bool relayoutChildren)
     // at least once and so that it always gives a reliable result reflecting the latest layout.
     m_hasOnlySelfCollapsingChildren = false;
 
+    if (style()->hasStrictContainment() && canSkipLayout()) {
+        skipLayout(relayoutChildren);
+        return;
+    }
+    // Take the block out of the skipped roots whatever its current style, so
+    // that no stale entry outlives its layout.
+    FrameView* frameView = this->frameView();
+    if (frameView && frameView->isSkippedLayoutRoot(*this)) {
+        // Nothing inside was painted while layout was skipped.
+        relayoutChildren |= frameView->takeSkippedLayoutRoot(*this);
+        setShouldDoFullPaintInvalidation();
+    }
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
@@ -391,6 +404,61 @@ void RenderBlockFlow::layoutBlock(bool relayoutChildren)
     clearNeedsLayout();
 }
 
+bool RenderBlockFlow::canSkipLayout() const
+{
+    ASSERT(style()->hasStrictContainment());
+    FrameView* frameView = this->frameView();
+    if (!frameView || !frameView->isLayoutSkippingAllowed())
+        return false;
+
+    // Only blocks whose size and overflow don't depend on their contents, and
+    // with nothing inside that paints or gets positioned through a layer.
+    if (!hasOverflowClip() || !hasLayer() || layer()->firstChild())
+        return false;
+    if (isTableCell() || isFloatingOrOutOfFlowPositioned() || isInline() || !parent() || !parent()->isRenderBlockFlow())
+        return false;
+    if (hasColumns() || multiColumnFlowThread() || flowThreadContainingBlock())
+        return false;
+    if (!style()->logicalHeight().isFixed() || style()->logicalWidth().isIntrinsic())
+        return false;
+
+    LayoutState* layoutState = view()->layoutState();
+    if (layoutState->isPaginated())
+        return false;
+
+    LogicalExtentComputedValues computedWidth;
+    computeLogicalWidth(computedWidth);
+    LogicalExtentComputedValues computedHeight;
+    computeLogicalHeight(LayoutUnit(), logicalTop(), computedHeight);
+    LayoutSize size = isHorizontalWritingMode() ? LayoutSize(computedWidth.m_extent, computedHeight.m_extent) : LayoutSize(computedHeight.m_extent, computedWidth.m_extent);
+    LayoutRect absoluteRect(toLayoutPoint(layoutState->layoutOffset()) + locationOffset(), size);
+    return !frameView->isNearViewport(absoluteRect);
+}
+
+void RenderBlockFlow::skipLayout(bool relayoutChildren)
+{
+    // Size the block like a normal layout would, but leave its descendants
+    // dirty. FrameView lays them out once the block gets near the viewport,
+    // or when script asks for geometry inside it.
+    relayoutChildren |= updateLogicalWidthAndColumnWidth();
+    updateLogicalHeight();
+
+    if (!isTableCell()) {
+        initMaxMarginValues();
+        setHasMarginBeforeQuirk(style()->hasMarginBeforeQuirk());
+        setHasMarginAfterQuirk(style()->hasMarginAfterQuirk());
+        setPaginationStrut(0);
+    }
+
+    m_overflow.clear();
+    addVisualEffectOverflow();
+    updateLayerTransformAfterLayout();
+    setShouldDoFullPaintInvalidation();
+
+    frameView()->didSkipLayout(*this, relayoutChildren);
+    clearNeedsLayout();
+}
+
 inline bool RenderBlockFlow::layoutBlockFlow(bool relayoutChildren, LayoutUnit &pageLogicalHeight, SubtreeLayoutScope& layoutScope)
 {
     LayoutUnit oldLeft = logicalLeft();
@@ -2615,24 +2683,7 @@ LayoutUnit RenderBlockFlow::nextFloatLogicalBottomBelow(LayoutUnit logicalHeight
     if (!m_floatingObjects)
         return logicalHeight;
 
-    LayoutUnit logicalBottom;
-    const FloatingObjectSet& floatingObjectSet = m_floatingObjects->set();
-    FloatingObjectSetIterator end = floatingObjectSet.end();
-    for (FloatingObjectSetIterator it = floatingObjectSet.begin(); it != end; ++it) {
-        FloatingObject* floatingObject = it->get();
-        LayoutUnit floatLogicalBottom = logicalBottomForFloat(floatingObject);
-        ShapeOutsideInfo* shapeOutside = floatingObject->renderer()->shapeOutsideInfo();
-        if (shapeOutside && (offsetMode == ShapeOutsideFloatShapeOffset)) {
-            LayoutUnit shapeLogicalBottom = logicalTopForFloat(floatingObject) + marginBeforeForChild(*(floatingObject->renderer())) + shapeOutside->shapeLogicalBottom();
-            // Use the shapeLogicalBottom unless it extends outside of the margin box, in which case it is clipped.
-            if (shapeLogicalBottom < floatLogicalBottom)
-                floatLogicalBottom = shapeLogicalBottom;
-        }
-        if (floatLogicalBottom > logicalHeight)
-            logicalBottom = logicalBottom ? std::min(floatLogicalBottom, logicalBottom) : floatLogicalBottom;
-    }
-
-    return logicalBottom;
+    return m_floatingObjects->nextLogicalBottomBelow(logicalHeight, offsetMode);
 }
 
 bool RenderBlockFlow::hitTestFloats(const HitTestRequest& request, HitTestResult& result, const HitTestLocation& locationInContainer, const LayoutPoint& accumulatedOffset)
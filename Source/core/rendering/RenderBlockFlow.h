@@ -266,6 +266,8 @@ protected:
     void determineLogicalLeftPositionForChild(RenderBox& child);
 
 private:
+    bool canSkipLayout() const;
+    void skipLayout(bool relayoutChildren);
     bool layoutBlockFlow(bool relayoutChildren, LayoutUnit& pageLogicalHeight, SubtreeLayoutScope&);
     void layoutBlockChildren(bool relayoutChildren, SubtreeLayoutScope&, LayoutUnit beforeEdge, LayoutUnit afterEdge);
 
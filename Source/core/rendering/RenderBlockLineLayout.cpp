@@ -745,6 +745,11 @@ void RenderBlockFlow::layoutRunsAndFloats(LineLayoutState& layoutState)
     if (!layoutState.isFullLayout() && startLine)
         determineEndPosition(layoutState, startLine, cleanLineStart, cleanLineBidiStatus);
 
+    if (!layoutState.isFullLayout()) {
+        for (RootInlineBox* line = firstRootBox(); line && line != startLine; line = line->nextRootBox())
+            layoutState.didReuseLine();
+    }
+
     if (startLine) {
         if (!layoutState.usesPaintInvalidationBounds())
             layoutState.setPaintInvalidationRange(logicalHeight());
@@ -793,6 +798,11 @@ void RenderBlockFlow::layoutRunsAndFloatsInRange(LineLayoutState& layoutState,
     RenderTextInfo renderTextInfo;
     VerticalPositionCache verticalPositionCache;
 
+    // On a full layout every line gets broken again, so shape the words of
+    // the block in one go rather than one at a time from the line breaker.
+    if (layoutState.isFullLayout())
+        renderTextInfo.m_wordMeasurementCache.measureWords(*this);
+
     LineBreaker lineBreaker(this);
 
     while (!endOfLine.atEnd()) {
@@ -863,6 +873,7 @@ void RenderBlockFlow::layoutRunsAndFloatsInRange(LineLayoutState& layoutState,
             resolver.markCurrentRunEmpty(); // FIXME: This can probably be replaced by an ASSERT (or just removed).
 
             if (lineBox) {
+                layoutState.didRebuildLine();
                 lineBox->setLineBreakInfo(endOfLine.object(), endOfLine.offset(), resolver.status());
                 if (layoutState.usesPaintInvalidationBounds())
                     layoutState.updatePaintInvalidationRangeFromBox(lineBox);
@@ -997,6 +1008,7 @@ void RenderBlockFlow::linkToEndLineIfNeeded(LineLayoutState& layoutState)
             LayoutUnit delta = logicalHeight() - layoutState.endLineLogicalTop();
             for (RootInlineBox* line = layoutState.endLine(); line; line = line->nextRootBox()) {
                 line->attachLine();
+                layoutState.didReuseLine();
                 if (paginated) {
                     delta -= line->paginationStrut();
                     adjustLinePositionForPagination(*line, delta, layoutState.flowThread());
@@ -1611,6 +1623,8 @@ void RenderBlockFlow::layoutInlineChildren(bool relayoutChildren, LayoutUnit& pa
     // Ensure the new line boxes will be painted.
     if (isFullLayout && firstLineBox())
         setShouldDoFullPaintInvalidation();
+
+    view()->didLayoutLines(layoutState.reusedLineCount(), layoutState.rebuiltLineCount());
 }
 
 void RenderBlockFlow::checkFloatsInCleanLine(RootInlineBox* line, Vector<FloatWithRect>& floats, size_t& floatIndex, bool& encounteredNewFloat, bool& dirtiedByFloat)
@@ -1880,6 +1894,20 @@ bool RenderBlockFlow::matchedEndLine(LineLayoutState& layoutState, const InlineB
         }
     }
 
+    // Clean lines that end before the current position can't be matched any
+    // more. Drop them so that the lines we try to match against keep moving
+    // along with the new lines, instead of giving up on the rest of the block
+    // once the new lines have reflowed past the first few clean ones.
+    line = originalEndLine;
+    while (line && line->lineBreakObj() && line->lineBreakObj() == resolver.position().object() && line->lineBreakPos() < resolver.position().offset())
+        line = line->nextRootBox();
+    if (line != originalEndLine) {
+        if (line)
+            layoutState.setEndLineLogicalTop(line->prevRootBox()->lineBottomWithLeading());
+        deleteLineRange(layoutState, originalEndLine, line);
+        layoutState.setEndLine(line);
+    }
+
     return false;
 }
 
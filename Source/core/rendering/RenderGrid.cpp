@@ -278,6 +278,9 @@ void RenderGrid::removeChild(RenderObject* child)
 {
     RenderBlock::removeChild(child);
 
+    if (child->isBox())
+        m_layoutResultCache.remove(*toRenderBox(child));
+
     if (gridIsDirty())
         return;
 
@@ -356,6 +359,9 @@ void RenderGrid::layoutBlock(bool relayoutChildren)
 
         TextAutosizer::LayoutScope textAutosizerLayoutScope(this);
 
+        if (relayoutChildren)
+            m_layoutResultCache.clear();
+
         layoutGridItems();
 
         LayoutUnit oldClientAfterEdge = clientLogicalBottom();
@@ -634,7 +640,22 @@ LayoutUnit RenderGrid::logicalHeightForChild(RenderBox& child, Vector<GridTrack>
     SubtreeLayoutScope layoutScope(child);
     LayoutUnit oldOverrideContainingBlockContentLogicalWidth = child.hasOverrideContainingBlockLogicalWidth() ? child.overrideContainingBlockContentLogicalWidth() : LayoutUnit();
     LayoutUnit overrideContainingBlockContentLogicalWidth = gridAreaBreadthForChild(child, ForColumns, columnTracks);
-    if (child.style()->logicalHeight().isPercent() || oldOverrideContainingBlockContentLogicalWidth != overrideContainingBlockContentLogicalWidth)
+    bool needsMeasuringLayout = child.style()->logicalHeight().isPercent() || oldOverrideContainingBlockContentLogicalWidth != overrideContainingBlockContentLogicalWidth;
+
+    // A clean child that was measured with this width before gives the same
+    // result. Leaving its overrides alone also spares layoutGridItems() from
+    // laying it out again with its final size.
+    if (child.needsLayout()) {
+        m_layoutResultCache.remove(child);
+    } else if (needsMeasuringLayout) {
+        LayoutResultCache::Result result;
+        if (m_layoutResultCache.find(child, overrideContainingBlockContentLogicalWidth, result)) {
+            view()->didAvoidLayout();
+            return result.logicalHeight + result.marginLogicalHeight;
+        }
+    }
+
+    if (needsMeasuringLayout)
         layoutScope.setNeedsLayout(&child);
 
     child.clearOverrideLogicalContentHeight();
@@ -643,7 +664,15 @@ LayoutUnit RenderGrid::logicalHeightForChild(RenderBox& child, Vector<GridTrack>
     // If |child| has a percentage logical height, we shouldn't let it override its intrinsic height, which is
     // what we are interested in here. Thus we need to set the override logical height to -1 (no possible resolution).
     child.setOverrideContainingBlockContentLogicalHeight(-1);
+    bool measuredChild = child.needsLayout();
     child.layoutIfNeeded();
+
+    if (measuredChild) {
+        LayoutResultCache::Result result;
+        result.logicalHeight = child.logicalHeight();
+        result.marginLogicalHeight = child.marginLogicalHeight();
+        m_layoutResultCache.add(child, overrideContainingBlockContentLogicalWidth, result);
+    }
     return child.logicalHeight() + child.marginLogicalHeight();
 }
 
@@ -690,6 +719,8 @@ public:
     GridItemWithSpan(RenderBox& gridItem, const GridCoordinate& coordinate, GridTrackSizingDirection direction)
         : m_gridItem(gridItem)
         , m_coordinate(coordinate)
+        , m_hasMinContentContribution(false)
+        , m_hasMaxContentContribution(false)
     {
         const GridSpan& span = (direction == ForRows) ? coordinate.rows : coordinate.columns;
         m_span = span.resolvedFinalPosition.toInt() - span.resolvedInitialPosition.toInt() + 1;
@@ -698,6 +729,24 @@ public:
     RenderBox& gridItem() const { return *m_gridItem; }
     GridCoordinate coordinate() const { return m_coordinate; }
 
+    // The contributions of an item don't change while the tracks of one direction are sized, so they are only
+    // computed the first time one of the track sizing steps asks for them.
+    bool hasMinContentContribution() const { return m_hasMinContentContribution; }
+    LayoutUnit minContentContribution() const { ASSERT(m_hasMinContentContribution); return m_minContentContribution; }
+    void setMinContentContribution(LayoutUnit contribution)
+    {
+        m_minContentContribution = contribution;
+        m_hasMinContentContribution = true;
+    }
+
+    bool hasMaxContentContribution() const { return m_hasMaxContentContribution; }
+    LayoutUnit maxContentContribution() const { ASSERT(m_hasMaxContentContribution); return m_maxContentContribution; }
+    void setMaxContentContribution(LayoutUnit contribution)
+    {
+        m_maxContentContribution = contribution;
+        m_hasMaxContentContribution = true;
+    }
+
     bool operator<(const GridItemWithSpan other) const { return m_span < other.m_span; }
 
     void trace(Visitor* visitor)
@@ -709,8 +758,35 @@ private:
     RawPtrWillBeMember<RenderBox> m_gridItem;
     GridCoordinate m_coordinate;
     size_t m_span;
+    LayoutUnit m_minContentContribution;
+    LayoutUnit m_maxContentContribution;
+    bool m_hasMinContentContribution;
+    bool m_hasMaxContentContribution;
 };
 
+LayoutUnit RenderGrid::minContentContributionForItem(GridItemWithSpan& gridItemWithSpan, GridTrackSizingDirection direction, Vector<GridTrack>& columnTracks)
+{
+    if (!gridItemWithSpan.hasMinContentContribution()) {
+        LayoutUnit contribution = minContentForChild(gridItemWithSpan.gridItem(), direction, columnTracks);
+        gridItemWithSpan.setMinContentContribution(contribution);
+        // Both contributions come from the same layout in the block axis.
+        if (direction == ForRows)
+            gridItemWithSpan.setMaxContentContribution(contribution);
+    }
+    return gridItemWithSpan.minContentContribution();
+}
+
+LayoutUnit RenderGrid::maxContentContributionForItem(GridItemWithSpan& gridItemWithSpan, GridTrackSizingDirection direction, Vector<GridTrack>& columnTracks)
+{
+    if (!gridItemWithSpan.hasMaxContentContribution()) {
+        LayoutUnit contribution = maxContentForChild(gridItemWithSpan.gridItem(), direction, columnTracks);
+        gridItemWithSpan.setMaxContentContribution(contribution);
+        if (direction == ForRows)
+            gridItemWithSpan.setMinContentContribution(contribution);
+    }
+    return gridItemWithSpan.maxContentContribution();
+}
+
 bool RenderGrid::spanningItemCrossesFlexibleSizedTracks(const GridCoordinate& coordinate, GridTrackSizingDirection direction) const
 {
     const GridResolvedPosition initialTrackPosition = (direction == ForColumns) ? coordinate.columns.resolvedInitialPosition : coordinate.rows.resolvedInitialPosition;
@@ -749,11 +825,11 @@ void RenderGrid::resolveContentBasedTrackSizingFunctions(GridTrackSizingDirectio
 
     Vector<GridItemWithSpan>::iterator end = sizingData.itemsSortedByIncreasingSpan.end();
     for (Vector<GridItemWithSpan>::iterator it = sizingData.itemsSortedByIncreasingSpan.begin(); it != end; ++it) {
-        GridItemWithSpan itemWithSpan = *it;
-        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMinOrMaxContentMinTrackBreadth, &RenderGrid::minContentForChild, &GridTrack::usedBreadth, &GridTrack::growUsedBreadth, &GridTrackSize::hasMinContentMinTrackBreadthAndMinOrMaxContentMaxTrackBreadth);
-        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMaxContentMinTrackBreadth, &RenderGrid::maxContentForChild, &GridTrack::usedBreadth, &GridTrack::growUsedBreadth, &GridTrackSize::hasMaxContentMinTrackBreadthAndMaxContentMaxTrackBreadth);
-        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMinOrMaxContentMaxTrackBreadth, &RenderGrid::minContentForChild, &GridTrack::maxBreadthIfNotInfinite, &GridTrack::growMaxBreadth);
-        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMaxContentMaxTrackBreadth, &RenderGrid::maxContentForChild, &GridTrack::maxBreadthIfNotInfinite, &GridTrack::growMaxBreadth);
+        GridItemWithSpan& itemWithSpan = *it;
+        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMinOrMaxContentMinTrackBreadth, &RenderGrid::minContentContributionForItem, &GridTrack::usedBreadth, &GridTrack::growUsedBreadth, &GridTrackSize::hasMinContentMinTrackBreadthAndMinOrMaxContentMaxTrackBreadth);
+        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMaxContentMinTrackBreadth, &RenderGrid::maxContentContributionForItem, &GridTrack::usedBreadth, &GridTrack::growUsedBreadth, &GridTrackSize::hasMaxContentMinTrackBreadthAndMaxContentMaxTrackBreadth);
+        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMinOrMaxContentMaxTrackBreadth, &RenderGrid::minContentContributionForItem, &GridTrack::maxBreadthIfNotInfinite, &GridTrack::growMaxBreadth);
+        resolveContentBasedTrackSizingFunctionsForItems(direction, sizingData, itemWithSpan, &GridTrackSize::hasMaxContentMaxTrackBreadth, &RenderGrid::maxContentContributionForItem, &GridTrack::maxBreadthIfNotInfinite, &GridTrack::growMaxBreadth);
     }
 
     for (const auto& trackIndex : sizingData.contentSizedTracksIndex) {
@@ -786,7 +862,7 @@ void RenderGrid::resolveContentBasedTrackSizingFunctionsForItems(GridTrackSizing
     if (sizingData.filteredTracks.isEmpty())
         return;
 
-    LayoutUnit additionalBreadthSpace = (this->*sizingFunction)(gridItemWithSpan.gridItem(), direction, sizingData.columnTracks);
+    LayoutUnit additionalBreadthSpace = (this->*sizingFunction)(gridItemWithSpan, direction, sizingData.columnTracks);
     for (GridResolvedPosition trackIndexForSpace = initialTrackPosition; trackIndexForSpace <= finalTrackPosition; ++trackIndexForSpace) {
         GridTrack& track = (direction == ForColumns) ? sizingData.columnTracks[trackIndexForSpace.toInt()] : sizingData.rowTracks[trackIndexForSpace.toInt()];
         additionalBreadthSpace -= (track.*trackGetter)();
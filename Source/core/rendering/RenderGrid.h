@@ -26,6 +26,7 @@
 #ifndef RenderGrid_h
 #define RenderGrid_h
 
+#include "core/rendering/LayoutResultCache.h"
 #include "core/rendering/OrderIterator.h"
 #include "core/rendering/RenderBlock.h"
 #include "core/rendering/style/GridResolvedPosition.h"
@@ -100,7 +101,7 @@ private:
     void offsetAndBreadthForPositionedChild(const RenderBox&, GridTrackSizingDirection, bool startIsAuto, bool endIsAuto, LayoutUnit& offset, LayoutUnit& breadth);
     void populateGridPositions(const GridSizingData&, LayoutUnit availableSpaceForColumns, LayoutUnit availableSpaceForRows);
 
-    typedef LayoutUnit (RenderGrid::* SizingFunction)(RenderBox&, GridTrackSizingDirection, Vector<GridTrack>&);
+    typedef LayoutUnit (RenderGrid::* SizingFunction)(GridItemWithSpan&, GridTrackSizingDirection, Vector<GridTrack>&);
     typedef LayoutUnit (GridTrack::* AccumulatorGetter)() const;
     typedef void (GridTrack::* AccumulatorGrowFunction)(LayoutUnit);
     typedef bool (GridTrackSize::* FilterFunction)() const;
@@ -114,6 +115,8 @@ private:
     LayoutUnit logicalHeightForChild(RenderBox&, Vector<GridTrack>&);
     LayoutUnit minContentForChild(RenderBox&, GridTrackSizingDirection, Vector<GridTrack>& columnTracks);
     LayoutUnit maxContentForChild(RenderBox&, GridTrackSizingDirection, Vector<GridTrack>& columnTracks);
+    LayoutUnit minContentContributionForItem(GridItemWithSpan&, GridTrackSizingDirection, Vector<GridTrack>& columnTracks);
+    LayoutUnit maxContentContributionForItem(GridItemWithSpan&, GridTrackSizingDirection, Vector<GridTrack>& columnTracks);
     LayoutUnit startOfColumnForChild(const RenderBox& child) const;
     LayoutUnit endOfColumnForChild(const RenderBox& child) const;
     LayoutUnit columnPositionLeft(const RenderBox&) const;
@@ -166,6 +169,7 @@ private:
     OrderIterator m_orderIterator;
     Vector<RenderBox*> m_gridItemsOverflowingGridArea;
     HashMap<const RenderBox*, size_t> m_gridItemsIndexesMap;
+    LayoutResultCache m_layoutResultCache;
 };
 
 DEFINE_RENDER_OBJECT_TYPE_CASTS(RenderGrid, isRenderGrid());
@@ -324,14 +324,34 @@ void RenderImage::layout()
     updateInnerContentRect();
 }
 
+static unsigned distanceBetween(const LayoutRect& viewBounds, const LayoutRect& objectBounds)
+{
+    LayoutUnit dx = std::max(LayoutUnit(), std::max(viewBounds.x() - objectBounds.maxX(), objectBounds.x() - viewBounds.maxX()));
+    LayoutUnit dy = std::max(LayoutUnit(), std::max(viewBounds.y() - objectBounds.maxY(), objectBounds.y() - viewBounds.maxY()));
+    return std::max(dx, dy).toUnsigned();
+}
+
 bool RenderImage::updateImageLoadingPriorities()
 {
-    if (!m_imageResource || !m_imageResource->cachedImage() || m_imageResource->cachedImage()->isLoaded())
+    if (!m_imageResource || !m_imageResource->cachedImage())
         return false;
 
     LayoutRect viewBounds = viewRect();
     LayoutRect objectBounds = absoluteContentBox();
 
+    // Once loaded, keep track of the image until it gets within a viewport of
+    // the visible area, and then have it decoded ahead of painting.
+    ImageResource* cachedImage = m_imageResource->cachedImage();
+    if (cachedImage->isLoaded()) {
+        if (cachedImage->errorOccurred() || !cachedImage->hasImage())
+            return false;
+        unsigned distance = distanceBetween(viewBounds, objectBounds);
+        if (distance > static_cast<unsigned>(viewBounds.height().toInt()))
+            return true;
+        cachedImage->image()->scheduleDecodeAhead(distance);
+        return false;
+    }
+
     // The object bounds might be empty right now, so intersects will fail since it doesn't deal
     // with empty rects. Use LayoutRect::contains in that case.
     bool isVisible;
@@ -125,6 +125,7 @@ RenderLayer::RenderLayer(RenderLayerModelObject* renderer, LayerType type)
     , m_hasNonCompositedChild(false)
     , m_shouldIsolateCompositedDescendants(false)
     , m_lostGroupedMapping(false)
+    , m_needsRepaint(true)
     , m_renderer(renderer)
     , m_parent(0)
     , m_previous(0)
@@ -1014,6 +1015,29 @@ RenderLayer* RenderLayer::enclosingLayerForPaintInvalidationCrossingFrameBoundar
     return compositedLayer;
 }
 
+void RenderLayer::setNeedsRepaint()
+{
+    ASSERT(RuntimeEnabledFeatures::slimmingPaintEnabled());
+
+    // Every layer up to the one owning the backing paints this layer as part of
+    // its subsequence, including layers of the frames this one is nested in.
+    // There's no stopping early at a layer that is already marked: painting clears
+    // the flag of each layer on its own, so its ancestors may have been cleared.
+    RenderLayer* layer = this;
+    while (layer) {
+        layer->m_needsRepaint = true;
+        if (layer->hasCompositedLayerMapping() || layer->groupedMapping())
+            break;
+        if (layer->parent()) {
+            layer = layer->parent();
+            continue;
+        }
+        LocalFrame* frame = layer->renderer()->frame();
+        RenderObject* owner = frame ? frame->ownerRenderer() : 0;
+        layer = owner ? owner->enclosingLayer() : 0;
+    }
+}
+
 RenderLayer* RenderLayer::enclosingLayerForPaintInvalidation() const
 {
     ASSERT(isAllowedToQueryCompositingState());
@@ -1221,6 +1245,9 @@ void RenderLayer::addChild(RenderLayer* child, RenderLayer* beforeChild)
 
     setNeedsCompositingInputsUpdate();
 
+    if (RuntimeEnabledFeatures::slimmingPaintEnabled())
+        setNeedsRepaint();
+
     if (child->stackingNode()->isNormalFlowOnly())
         m_stackingNode->dirtyNormalFlowList();
 
@@ -1266,6 +1293,9 @@ RenderLayer* RenderLayer::removeChild(RenderLayer* oldChild)
     oldChild->setNextSibling(0);
     oldChild->m_parent = 0;
 
+    if (RuntimeEnabledFeatures::slimmingPaintEnabled())
+        setNeedsRepaint();
+
     dirtyAncestorChainHasSelfPaintingLayerDescendantStatus();
 
     oldChild->updateDescendantDependentFlags();
@@ -490,6 +490,16 @@ public:
 
     void setShouldDoFullPaintInvalidationIncludingNonCompositingDescendants();
 
+    // Whether something this layer paints, itself or through its descendants, was
+    // invalidated since the layer last recorded a display item subsequence. Only
+    // used with slimming paint, see LayerPainter::paintLayer().
+    bool needsRepaint() const { return m_needsRepaint; }
+    void setNeedsRepaint();
+    void clearNeedsRepaint() { m_needsRepaint = false; }
+
+    const LayerSubsequencePaintingState& subsequencePaintingState() const { return m_subsequencePaintingState; }
+    void setSubsequencePaintingState(const LayerSubsequencePaintingState& state) { m_subsequencePaintingState = state; }
+
     bool hasSelfPaintingLayerDescendant() const
     {
         if (m_hasSelfPaintingLayerDescendantDirty)
@@ -652,6 +662,8 @@ private:
     // and we don't yet know to what graphics layer this RenderLayer will be assigned.
     unsigned m_lostGroupedMapping : 1;
 
+    unsigned m_needsRepaint : 1;
+
     RenderLayerModelObject* m_renderer;
 
     RenderLayer* m_parent;
@@ -700,6 +712,8 @@ private:
     OwnPtrWillBePersistent<RenderLayerReflectionInfo> m_reflectionInfo;
 
     LayoutSize m_subpixelAccumulation; // The accumulated subpixel offset of a composited layer's composited bounds compared to absolute coordinates.
+
+    LayerSubsequencePaintingState m_subsequencePaintingState;
 };
 
 } // namespace blink
@@ -52,6 +52,7 @@
 #include "core/page/EventHandler.h"
 #include "core/page/Page.h"
 #include "core/paint/ObjectPainter.h"
+#include "core/rendering/BackingPaintInvalidations.h"
 #include "core/rendering/HitTestResult.h"
 #include "core/rendering/RenderCounter.h"
 #include "core/rendering/RenderDeprecatedFlexibleBox.h"
@@ -766,6 +767,17 @@ void RenderObject::clearPreferredLogicalWidthsDirty()
     m_bitfields.setPreferredLogicalWidthsDirty(false);
 }
 
+static bool canDeferCellPreferredLogicalWidthsCheck(const RenderObject& invalidatedObject, const RenderTableCell& cell)
+{
+    // Inserting a child may make an empty cell non-empty, which matters to the
+    // table even if the cell's widths stay the same.
+    if (invalidatedObject.parent() == &cell && !invalidatedObject.everHadLayout())
+        return false;
+    // Invalidations during layout have to reach the table right away.
+    FrameView* frameView = cell.frameView();
+    return frameView && !frameView->isInPerformLayout() && cell.view();
+}
+
 void RenderObject::invalidateContainerPreferredLogicalWidths()
 {
     // In order to avoid pathological behavior when inlines are deeply nested, we do include them
@@ -779,6 +791,11 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             break;
 
         o->m_bitfields.setPreferredLogicalWidthsDirty(true);
+        if (o->isTableCell() && canDeferCellPreferredLogicalWidthsCheck(*this, *toRenderTableCell(o))) {
+            // Recomputing the table's columns is expensive, so only do it if the cell's widths change.
+            o->view()->deferCellPreferredLogicalWidthsCheck(*toRenderTableCell(o));
+            break;
+        }
         if (o->style()->hasOutOfFlowPosition())
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
@@ -1118,6 +1135,7 @@ void RenderObject::invalidatePaintUsingContainer(const RenderLayerModelObject* p
     if (RuntimeEnabledFeatures::slimmingPaintEnabled()) {
         if (RenderLayer* container = enclosingLayer()->enclosingLayerForPaintInvalidationCrossingFrameBoundaries())
             container->graphicsLayerBacking()->displayItemList()->invalidate(displayItemClient());
+        enclosingLayer()->setNeedsRepaint();
     }
 
     if (r.isEmpty())
@@ -1140,7 +1158,11 @@ void RenderObject::invalidatePaintUsingContainer(const RenderLayerModelObject* p
 
     if (paintInvalidationContainer->view()->usesCompositing()) {
         ASSERT(paintInvalidationContainer->isPaintInvalidationContainer());
-        paintInvalidationContainer->setBackingNeedsPaintInvalidationInRect(r, invalidationReason);
+        FrameView* frameView = this->frameView();
+        if (BackingPaintInvalidations* backingPaintInvalidations = frameView ? frameView->backingPaintInvalidations() : 0)
+            backingPaintInvalidations->add(*paintInvalidationContainer, r, invalidationReason);
+        else
+            paintInvalidationContainer->setBackingNeedsPaintInvalidationInRect(r, invalidationReason);
     }
 }
 
@@ -2258,6 +2280,14 @@ RenderObject* RenderObject::container(const RenderLayerModelObject* paintInvalid
     return o;
 }
 
+bool RenderObject::isSkippedLayoutRoot() const
+{
+    if (!isRenderBlock() || !style()->hasStrictContainment())
+        return false;
+    FrameView* frameView = this->frameView();
+    return frameView && frameView->isSkippedLayoutRoot(toRenderBlock(*this));
+}
+
 bool RenderObject::isSelectionBorder() const
 {
     SelectionState st = selectionState();
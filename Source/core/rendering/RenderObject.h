@@ -227,8 +227,10 @@ public:
 
     void assertSubtreeIsLaidOut() const
     {
-        for (const RenderObject* renderer = this; renderer; renderer = renderer->nextInPreOrder())
+        for (const RenderObject* renderer = this; renderer; ) {
             renderer->assertRendererLaidOut();
+            renderer = renderer->isSkippedLayoutRoot() ? renderer->nextInPreOrderAfterChildren() : renderer->nextInPreOrder();
+        }
     }
 
     void assertRendererClearedPaintInvalidationState() const
@@ -243,8 +245,10 @@ public:
 
     void assertSubtreeClearedPaintInvalidationState() const
     {
-        for (const RenderObject* renderer = this; renderer; renderer = renderer->nextInPreOrder())
+        for (const RenderObject* renderer = this; renderer; ) {
             renderer->assertRendererClearedPaintInvalidationState();
+            renderer = renderer->isSkippedLayoutRoot() ? renderer->nextInPreOrderAfterChildren() : renderer->nextInPreOrder();
+        }
     }
 
 #endif
@@ -407,6 +411,9 @@ public:
     bool hasCounterNodeMap() const { return m_bitfields.hasCounterNodeMap(); }
     void setHasCounterNodeMap(bool hasCounterNodeMap) { m_bitfields.setHasCounterNodeMap(hasCounterNodeMap); }
     bool everHadLayout() const { return m_bitfields.everHadLayout(); }
+    // True for contain: strict blocks whose descendants were left dirty, see
+    // FrameView::didSkipLayout().
+    bool isSkippedLayoutRoot() const;
 
     bool childrenInline() const { return m_bitfields.childrenInline(); }
     void setChildrenInline(bool b) { m_bitfields.setChildrenInline(b); }
@@ -68,6 +68,7 @@ void RenderTableCell::willBeRemovedFromTree()
 
     section()->setNeedsCellRecalc();
     section()->removeCachedCollapsedBorders(this);
+    view()->cancelCellPreferredLogicalWidthsCheck(*this);
 }
 
 unsigned RenderTableCell::parseColSpanFromDOM() const
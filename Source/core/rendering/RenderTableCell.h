@@ -141,6 +141,11 @@ public:
     int intrinsicPaddingBefore() const { return m_intrinsicPaddingBefore; }
     int intrinsicPaddingAfter() const { return m_intrinsicPaddingAfter; }
 
+    // The preferred logical widths as last computed, even if they have been
+    // marked dirty since.
+    LayoutUnit lastMinPreferredLogicalWidth() const { return m_minPreferredLogicalWidth; }
+    LayoutUnit lastMaxPreferredLogicalWidth() const { return m_maxPreferredLogicalWidth; }
+
     virtual LayoutUnit paddingTop() const override;
     virtual LayoutUnit paddingBottom() const override;
     virtual LayoutUnit paddingLeft() const override;
@@ -97,6 +97,7 @@ RenderTableSection::RenderTableSection(Element* element)
     , m_outerBorderEnd(0)
     , m_outerBorderBefore(0)
     , m_outerBorderAfter(0)
+    , m_rowPosIsReusable(false)
     , m_needsCellRecalc(false)
     , m_forceSlowPaintPathWithOverflowingCell(false)
     , m_hasMultipleCellLevels(false)
@@ -721,6 +722,10 @@ int RenderTableSection::calcRowLogicalHeight()
     // coordinate transform, that's not necessary.
     LayoutState state(*this, locationOffset());
 
+    // Rows whose cells didn't change keep the height they had, so only their position needs updating.
+    bool reuseRowHeights = m_rowPosIsReusable && canSkipUnchangedRows() && !m_rowPos.isEmpty();
+    int oldRowLogicalTop = reuseRowHeights ? m_rowPos[0] : 0;
+
     m_rowPos.resize(m_grid.size() + 1);
 
     // We ignore the border-spacing on any non-top section as it is already included in the previous section's last row position.
@@ -735,6 +740,16 @@ int RenderTableSection::calcRowLogicalHeight()
 #endif
 
     for (unsigned r = 0; r < m_grid.size(); r++) {
+        if (reuseRowHeights) {
+            int oldRowLogicalBottom = m_rowPos[r + 1];
+            if (!m_grid[r].cellsChanged) {
+                m_rowPos[r + 1] = m_rowPos[r] + oldRowLogicalBottom - oldRowLogicalTop;
+                oldRowLogicalTop = oldRowLogicalBottom;
+                continue;
+            }
+            oldRowLogicalTop = oldRowLogicalBottom;
+        }
+
         m_grid[r].baseline = 0;
         LayoutUnit baselineDescent = 0;
 
@@ -775,6 +790,7 @@ int RenderTableSection::calcRowLogicalHeight()
                     cell->clearIntrinsicPadding();
                     cell->clearOverrideSize();
                     cell->forceChildLayout();
+                    m_grid[r].cellsChanged = true;
                 }
 
                 m_rowPos[r + 1] = std::max(m_rowPos[r + 1], m_rowPos[r] + cell->logicalHeightForRowSizing());
@@ -791,6 +807,7 @@ int RenderTableSection::calcRowLogicalHeight()
 
     if (!rowSpanCells.isEmpty())
         distributeRowSpanHeightToRows(rowSpanCells);
+    m_rowPosIsReusable = rowSpanCells.isEmpty();
 
     ASSERT(!needsLayout());
 
@@ -811,8 +828,16 @@ void RenderTableSection::layout()
 
     const Vector<int>& columnPos = table()->columnPositions();
 
+    // Unless the columns changed, only the cells of the rows that need layout can need a new width.
+    bool cellWidthsAreUpToDate = canSkipUnchangedRows() && columnPos == m_cellColumnPositions;
+
     SubtreeLayoutScope layouter(*this);
     for (unsigned r = 0; r < m_grid.size(); ++r) {
+        RenderTableRow* rowRenderer = m_grid[r].rowRenderer;
+        if (cellWidthsAreUpToDate && rowRenderer && !rowRenderer->needsLayout())
+            continue;
+        m_grid[r].cellsChanged = true;
+
         Row& row = m_grid[r].row;
         unsigned cols = row.size();
         // First, propagate our table layout's information to the cells. This will mark the row as needing layout
@@ -834,12 +859,13 @@ void RenderTableSection::layout()
             cell->setCellLogicalWidth(tableLayoutLogicalWidth, layouter);
         }
 
-        if (RenderTableRow* rowRenderer = m_grid[r].rowRenderer) {
+        if (rowRenderer) {
             if (!rowRenderer->needsLayout())
                 rowRenderer->markForPaginationRelayoutIfNeeded(layouter);
             rowRenderer->layoutIfNeeded();
         }
     }
+    m_cellColumnPositions = columnPos;
 
     clearNeedsLayout();
 }
@@ -922,6 +948,8 @@ int RenderTableSection::distributeExtraLogicalHeightToRows(int extraLogicalHeigh
     if (!m_rowPos[totalRows] && nextSibling())
         return extraLogicalHeight;
 
+    m_rowPosIsReusable = false;
+
     unsigned autoRowsCount = 0;
     int totalPercent = 0;
     for (unsigned r = 0; r < totalRows; r++) {
@@ -966,7 +994,14 @@ void RenderTableSection::layoutRows()
 
     LayoutState state(*this, locationOffset());
 
+    // Rows whose cells weren't laid out again and that keep their position and size can be left alone.
+    bool skipUnchangedRows = m_rowPosIsReusable && canSkipUnchangedRows();
+
     for (unsigned r = 0; r < totalRows; r++) {
+        if (skipUnchangedRows && rowLayoutIsUpToDate(r, vspacing))
+            continue;
+        m_grid[r].cellsChanged = true;
+
         // Set the row's x/y position and width/height.
         RenderTableRow* rowRenderer = m_grid[r].rowRenderer;
         if (rowRenderer) {
@@ -1032,6 +1067,7 @@ void RenderTableSection::layoutRows()
                 // Alignment within a cell is based off the calculated
                 // height, which becomes irrelevant once the cell has
                 // been resized based off its percentage.
+                m_rowPosIsReusable = false;
                 cell->setOverrideLogicalContentHeightFromRowHeight(rHeight);
                 cell->forceChildLayout();
 
@@ -1080,6 +1116,7 @@ void RenderTableSection::layoutRows()
             }
         }
         if (rowHeightIncreaseForPagination) {
+            m_rowPosIsReusable = false;
             for (unsigned rowIndex = r + 1; rowIndex <= totalRows; rowIndex++)
                 m_rowPos[rowIndex] += rowHeightIncreaseForPagination;
             for (unsigned c = 0; c < nEffCols; ++c) {
@@ -1100,6 +1137,32 @@ void RenderTableSection::layoutRows()
     computeOverflowFromCells(totalRows, nEffCols);
 }
 
+bool RenderTableSection::canSkipUnchangedRows() const
+{
+    // The cells of a fixed layout table only depend on their own content, so rows whose cells didn't change
+    // can be left alone, unless the table itself changed. This makes small changes to tables with many rows
+    // cheap.
+    RenderTable* table = this->table();
+    return table->style()->isFixedTableLayout() && table->style()->logicalHeight().isAuto()
+        && !table->selfNeedsLayout() && !view()->layoutState()->isPaginated();
+}
+
+bool RenderTableSection::rowLayoutIsUpToDate(unsigned row, int vspacing) const
+{
+    // The cells can only have moved if the row did, as the columns are the same as at the cells' last layout.
+    RenderTableRow* rowRenderer = m_grid[row].rowRenderer;
+    return !m_grid[row].cellsChanged && rowRenderer
+        && rowRenderer->location() == LayoutPoint(0, m_rowPos[row])
+        && rowRenderer->logicalWidth() == logicalWidth()
+        && rowRenderer->logicalHeight() == m_rowPos[row + 1] - m_rowPos[row] - vspacing;
+}
+
+static inline bool cellMayAddOverflow(const RenderTableCell* cell)
+{
+    // Otherwise the cell stays within its row, and the section.
+    return cell->hasRenderOverflow() || cell->hasTransformRelatedProperty() || cell->isRelPositioned();
+}
+
 void RenderTableSection::computeOverflowFromCells()
 {
     unsigned totalRows = m_grid.size();
@@ -1115,8 +1178,16 @@ void RenderTableSection::computeOverflowFromCells(unsigned totalRows, unsigned n
 #if ENABLE(ASSERT)
     bool hasOverflowingCell = false;
 #endif
+    // Rows whose cells neither changed nor added overflow the last time add none now either.
+    bool skipUnchangedRows = m_rowPosIsReusable && canSkipUnchangedRows();
+
     // Now that our height has been determined, add in overflow from cells.
     for (unsigned r = 0; r < totalRows; r++) {
+        if (skipUnchangedRows && !m_grid[r].cellsChanged && !m_grid[r].cellsHaveOverflow)
+            continue;
+        m_grid[r].cellsChanged = false;
+        m_grid[r].cellsHaveOverflow = false;
+
         for (unsigned c = 0; c < nEffCols; c++) {
             CellStruct& cs = cellAt(r, c);
             RenderTableCell* cell = cs.primaryCell();
@@ -1125,6 +1196,8 @@ void RenderTableSection::computeOverflowFromCells(unsigned totalRows, unsigned n
             if (r < totalRows - 1 && cell == primaryCellAt(r + 1, c))
                 continue;
             addOverflowFromChild(cell);
+            if (cellMayAddOverflow(cell))
+                m_grid[r].cellsHaveOverflow = true;
 #if ENABLE(ASSERT)
             hasOverflowingCell |= cell->hasVisualOverflow();
 #endif
@@ -1424,6 +1497,8 @@ void RenderTableSection::recalcCells()
     }
 
     m_grid.shrinkToFit();
+    m_cellColumnPositions.clear();
+    m_rowPosIsReusable = false;
     setNeedsLayoutAndFullPaintInvalidation();
 }
 
@@ -1435,6 +1510,7 @@ void RenderTableSection::rowLogicalHeightChanged(RenderTableRow* row)
 
     unsigned rowIndex = row->rowIndex();
     setRowLogicalHeightToRowStyleLogicalHeight(m_grid[rowIndex]);
+    m_grid[rowIndex].cellsChanged = true;
 
     for (RenderTableCell* cell = m_grid[rowIndex].rowRenderer->firstCell(); cell; cell = cell->nextCell())
         updateLogicalHeightForCell(m_grid[rowIndex], cell);
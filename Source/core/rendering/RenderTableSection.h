@@ -122,6 +122,8 @@ public:
         RowStruct()
             : rowRenderer(nullptr)
             , baseline()
+            , cellsChanged(true)
+            , cellsHaveOverflow(false)
         {
         }
         void trace(Visitor*);
@@ -130,6 +132,10 @@ public:
         RawPtrWillBeMember<RenderTableRow> rowRenderer;
         LayoutUnit baseline;
         Length logicalHeight;
+        // Whether any cell of the row may have been laid out since the overflow was last computed from the cells.
+        bool cellsChanged;
+        // Whether any cell of the row added overflow to the section the last time it was computed.
+        bool cellsHaveOverflow;
     };
 
     struct SpanningRowsHeight {
@@ -290,11 +296,21 @@ private:
 
     void setLogicalPositionForCell(RenderTableCell*, unsigned effectiveColumn) const;
 
+    bool canSkipUnchangedRows() const;
+    bool rowLayoutIsUpToDate(unsigned row, int vspacing) const;
+
     RenderObjectChildList m_children;
 
     WillBeHeapVector<RowStruct> m_grid;
     Vector<int> m_rowPos;
 
+    // The column positions the cells were last given their widths for.
+    Vector<int> m_cellColumnPositions;
+    // Whether m_rowPos holds the heights the rows got from their own cells, which the rows whose cells
+    // didn't change can keep. Row spanning cells, extra table height, pagination and flexed cell children
+    // all change the row heights after the fact.
+    bool m_rowPosIsReusable;
+
     // the current insertion position
     unsigned m_cCol;
     unsigned m_cRow;
@@ -38,6 +38,7 @@
 #include "core/rendering/RenderLayer.h"
 #include "core/rendering/RenderPart.h"
 #include "core/rendering/RenderQuote.h"
+#include "core/rendering/RenderTableCell.h"
 #include "core/rendering/compositing/CompositedLayerMapping.h"
 #include "core/rendering/compositing/RenderLayerCompositor.h"
 #include "core/svg/SVGDocumentExtensions.h"
@@ -60,6 +61,9 @@ RenderView::RenderView(Document* document)
     , m_renderQuoteHead(nullptr)
     , m_renderCounterCount(0)
     , m_hitTestCount(0)
+    , m_reusedLineBoxCount(0)
+    , m_rebuiltLineBoxCount(0)
+    , m_avoidedLayoutCount(0)
 {
     // init RenderObject attributes
     setInline(false);
@@ -76,6 +80,43 @@ RenderView::~RenderView()
 {
 }
 
+void RenderView::deferCellPreferredLogicalWidthsCheck(RenderTableCell& cell)
+{
+    CellPreferredLogicalWidths widths;
+    widths.minLogicalWidth = cell.lastMinPreferredLogicalWidth();
+    widths.maxLogicalWidth = cell.lastMaxPreferredLogicalWidth();
+    widths.hadChildren = cell.slowFirstChild();
+    m_deferredCellPreferredLogicalWidthsChecks.add(&cell, widths);
+}
+
+void RenderView::cancelCellPreferredLogicalWidthsCheck(RenderTableCell& cell)
+{
+    m_deferredCellPreferredLogicalWidthsChecks.remove(&cell);
+}
+
+void RenderView::checkDeferredCellPreferredLogicalWidths()
+{
+    // Invalidating a nested table can defer a check of a cell of the table
+    // that contains it, so keep going until nothing is left.
+    while (!m_deferredCellPreferredLogicalWidthsChecks.isEmpty()) {
+        HashMap<RenderTableCell*, CellPreferredLogicalWidths> checks;
+        checks.swap(m_deferredCellPreferredLogicalWidthsChecks);
+        for (HashMap<RenderTableCell*, CellPreferredLogicalWidths>::const_iterator it = checks.begin(); it != checks.end(); ++it) {
+            RenderTableCell* cell = it->key;
+            const CellPreferredLogicalWidths& widths = it->value;
+            // A cell in a detached subtree can't compute its widths, so its
+            // table has to recompute them once the subtree is attached.
+            // Whether a column only has empty cells also depends on whether
+            // its cells have children.
+            if (!cell->isRooted()
+                || widths.hadChildren != !!cell->slowFirstChild()
+                || cell->minPreferredLogicalWidth() != widths.minLogicalWidth
+                || cell->maxPreferredLogicalWidth() != widths.maxLogicalWidth)
+                cell->invalidateContainerPreferredLogicalWidths();
+        }
+    }
+}
+
 void RenderView::trace(Visitor* visitor)
 {
     visitor->trace(m_selectionStart);
@@ -36,6 +36,7 @@ namespace blink {
 
 class RenderLayerCompositor;
 class RenderQuote;
+class RenderTableCell;
 
 // The root of the render tree, corresponding to the CSS initial containing block.
 // It's dimensions match that of the logical viewport (which may be different from
@@ -53,6 +54,28 @@ public:
     // Returns the total count of calls to HitTest, for testing.
     unsigned hitTestCount() const { return m_hitTestCount; }
 
+    // Returns the total counts of root line boxes kept and rebuilt by line
+    // layout, for testing.
+    unsigned reusedLineBoxCount() const { return m_reusedLineBoxCount; }
+    unsigned rebuiltLineBoxCount() const { return m_rebuiltLineBoxCount; }
+    void didLayoutLines(unsigned reused, unsigned rebuilt)
+    {
+        m_reusedLineBoxCount += reused;
+        m_rebuiltLineBoxCount += rebuilt;
+    }
+
+    // Returns the total count of child layouts skipped because a cached
+    // result for the same constraints was used instead, for testing.
+    unsigned avoidedLayoutCount() const { return m_avoidedLayoutCount; }
+    void didAvoidLayout() { ++m_avoidedLayoutCount; }
+
+    // Preferred width changes inside a table cell stop at the cell instead of
+    // dirtying the whole table. Before the next layout the cell's widths are
+    // recomputed, and the table is only invalidated if they actually changed.
+    void deferCellPreferredLogicalWidthsCheck(RenderTableCell&);
+    void cancelCellPreferredLogicalWidthsCheck(RenderTableCell&);
+    void checkDeferredCellPreferredLogicalWidths();
+
     virtual const char* renderName() const override { return "RenderView"; }
 
     virtual bool isOfType(RenderObjectType type) const override { return type == RenderObjectRenderView || RenderBlockFlow::isOfType(type); }
@@ -203,6 +226,16 @@ private:
     unsigned m_renderCounterCount;
 
     unsigned m_hitTestCount;
+    unsigned m_reusedLineBoxCount;
+    unsigned m_rebuiltLineBoxCount;
+    unsigned m_avoidedLayoutCount;
+
+    struct CellPreferredLogicalWidths {
+        LayoutUnit minLogicalWidth;
+        LayoutUnit maxLogicalWidth;
+        bool hadChildren;
+    };
+    HashMap<RenderTableCell*, CellPreferredLogicalWidths> m_deferredCellPreferredLogicalWidthsChecks;
 
     class PendingSelection final {
         DISALLOW_ALLOCATION();
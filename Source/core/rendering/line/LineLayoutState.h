@@ -47,6 +47,8 @@ public:
         , m_adjustedLogicalLineTop(0)
         , m_usesPaintInvalidationBounds(false)
         , m_flowThread(flowThread)
+        , m_reusedLineCount(0)
+        , m_rebuiltLineCount(0)
     { }
 
     void markForFullLayout() { m_isFullLayout = true; }
@@ -99,6 +101,12 @@ public:
     RenderFlowThread* flowThread() const { return m_flowThread; }
     void setFlowThread(RenderFlowThread* thread) { m_flowThread = thread; }
 
+    // Root line boxes kept from the previous layout and built by this one.
+    unsigned reusedLineCount() const { return m_reusedLineCount; }
+    void didReuseLine() { ++m_reusedLineCount; }
+    unsigned rebuiltLineCount() const { return m_rebuiltLineCount; }
+    void didRebuildLine() { ++m_rebuiltLineCount; }
+
 private:
     Vector<RenderBlockFlow::FloatWithRect> m_floats;
     FloatingObject* m_lastFloat;
@@ -123,6 +131,9 @@ private:
     bool m_usesPaintInvalidationBounds;
 
     RenderFlowThread* m_flowThread;
+
+    unsigned m_reusedLineCount;
+    unsigned m_rebuiltLineCount;
 };
 
 }
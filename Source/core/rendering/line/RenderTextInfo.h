@@ -23,6 +23,7 @@
 #ifndef RenderTextInfo_h
 #define RenderTextInfo_h
 
+#include "core/rendering/line/WordMeasurementCache.h"
 #include "platform/text/TextBreakIterator.h"
 
 namespace blink {
@@ -40,6 +41,7 @@ struct RenderTextInfo {
     RenderText* m_text;
     LazyLineBreakIterator m_lineBreakIterator;
     const Font* m_font;
+    WordMeasurementCache m_wordMeasurementCache;
 };
 
 } // namespace blink
@@ -0,0 +1,166 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "core/rendering/line/WordMeasurementCache.h"
+
+#include "core/rendering/InlineIterator.h"
+#include "core/rendering/RenderBlockFlow.h"
+#include "core/rendering/RenderText.h"
+#include "core/rendering/TextRunConstructor.h"
+#include "core/rendering/break_lines.h"
+#include "platform/fonts/Font.h"
+#include "platform/text/TextBreakIterator.h"
+
+namespace blink {
+
+static inline uint64_t wordKey(unsigned from, unsigned length)
+{
+    return (static_cast<uint64_t>(from) << 32) | length;
+}
+
+static bool canMeasureWordsAhead(RenderText* text)
+{
+    if (text->isBR() || text->isSVGInlineText() || text->isCombineText())
+        return false;
+    // Simple path text is cheap enough to measure on demand.
+    if (text->canUseSimpleFontCodePath())
+        return false;
+
+    RenderStyle* style = text->style();
+    // Only white-space: normal, where the breaker never measures tabs and
+    // its word boundaries depend on the text alone.
+    if (style->whiteSpace() != NORMAL || style->wordBreak() == BreakAllWordBreak)
+        return false;
+    if (style->rtlOrdering() == VisualOrder || style->hasTextCombine())
+        return false;
+
+    const Font& font = style->font();
+    return !font.isFixedPitch() && !font.loadingCustomFonts();
+}
+
+WordMeasurementCache::WordMeasurementCache()
+{
+}
+
+WordMeasurementCache::~WordMeasurementCache()
+{
+}
+
+void WordMeasurementCache::measureWords(RenderBlockFlow& block)
+{
+    clear();
+
+    // Words are shaped once per font and direction, however often they occur
+    // in the block. The same word can shape differently in LTR and RTL text.
+    typedef std::pair<const Font*, unsigned> FontAndDirection;
+    HashMap<FontAndDirection, OwnPtr<WordIndexMap> > wordsByFont;
+    for (RenderObject* o = bidiNextSkippingEmptyInlines(&block, &block); o; o = bidiNextSkippingEmptyInlines(&block, o)) {
+        if (!o->isText())
+            continue;
+        RenderText* text = toRenderText(o);
+        if (!canMeasureWordsAhead(text))
+            continue;
+        RenderStyle* style = text->style();
+        HashMap<FontAndDirection, OwnPtr<WordIndexMap> >::AddResult result = wordsByFont.add(std::make_pair(&style->font(), static_cast<unsigned>(style->direction())), nullptr);
+        if (result.isNewEntry)
+            result.storedValue->value = adoptPtr(new WordIndexMap);
+        measureText(text, *result.storedValue->value);
+    }
+}
+
+void WordMeasurementCache::measureText(RenderText* text, WordIndexMap& wordIndices)
+{
+    RenderStyle* style = text->style();
+    const Font& font = style->font();
+    unsigned length = text->textLength();
+    OwnPtr<TextWords> textWords = adoptPtr(new TextWords(&font));
+
+    // With kerning the breaker measures words followed by a space together
+    // with that space, and subtracts its width afterwards.
+    bool includeTrailingSpace = font.fontDescription().typesettingFeatures() & Kerning;
+
+    Vector<std::pair<unsigned, unsigned> > ranges;
+    LazyLineBreakIterator breakIterator(text->text(), style->locale());
+    int nextBreakable = -1;
+    unsigned lastSpace = 0;
+    bool ignoringSpaces = false;
+    bool previousCharacterIsSpace = false;
+    for (unsigned i = 0; i < length; ++i) {
+        UChar c = text->characterAt(i);
+        bool currentCharacterIsSpace = c == ' ' || c == '\t' || c == '\n';
+        if (i && isBreakable(breakIterator, i, nextBreakable)) {
+            if (ignoringSpaces) {
+                if (!currentCharacterIsSpace) {
+                    ignoringSpaces = false;
+                    lastSpace = i;
+                }
+            } else {
+                if (i > lastSpace)
+                    ranges.append(std::make_pair(lastSpace, i - lastSpace + (includeTrailingSpace && c == ' ' ? 1 : 0)));
+                lastSpace = i;
+                if (currentCharacterIsSpace && previousCharacterIsSpace)
+                    ignoringSpaces = true;
+            }
+        } else if (ignoringSpaces) {
+            ignoringSpaces = false;
+            lastSpace = i;
+        }
+        previousCharacterIsSpace = currentCharacterIsSpace;
+    }
+    if (!ignoringSpaces && lastSpace < length)
+        ranges.append(std::make_pair(lastSpace, length - lastSpace));
+
+    // The breaker measures a whole text through RenderText::width() instead.
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        unsigned from = ranges[i].first;
+        unsigned wordLength = ranges[i].second;
+        if (!from && wordLength == length)
+            continue;
+        WordIndexMap::AddResult result = wordIndices.add(text->text().substring(from, wordLength), m_words.size());
+        if (result.isNewEntry) {
+            TextRun run = constructTextRun(text, font, text, from, wordLength, style);
+            run.setCharacterScanForCodePath(true);
+            run.setUseComplexCodePath(true);
+            run.setTabSize(false, style->tabSize());
+
+            HashSet<const SimpleFontData*> fallbackFonts;
+            GlyphOverflow glyphOverflow;
+            m_words.grow(m_words.size() + 1);
+            MeasuredWord& word = m_words.last();
+            word.width = font.width(run, &fallbackFonts, &glyphOverflow);
+            copyToVector(fallbackFonts, word.fallbackFonts);
+        }
+        textWords->words.set(wordKey(from, wordLength), result.storedValue->value);
+    }
+
+    if (!textWords->words.isEmpty())
+        m_texts.set(text, textWords.release());
+}
+
+bool WordMeasurementCache::lookup(RenderText* text, const Font& font, unsigned from, unsigned length, float& width, HashSet<const SimpleFontData*>* fallbackFonts) const
+{
+    HashMap<RenderText*, OwnPtr<TextWords> >::const_iterator textIt = m_texts.find(text);
+    if (textIt == m_texts.end() || textIt->value->font != &font)
+        return false;
+    HashMap<uint64_t, unsigned>::const_iterator wordIt = textIt->value->words.find(wordKey(from, length));
+    if (wordIt == textIt->value->words.end())
+        return false;
+
+    const MeasuredWord& word = m_words[wordIt->value];
+    width = word.width;
+    if (fallbackFonts) {
+        for (size_t i = 0; i < word.fallbackFonts.size(); ++i)
+            fallbackFonts->add(word.fallbackFonts[i]);
+    }
+    return true;
+}
+
+void WordMeasurementCache::clear()
+{
+    m_texts.clear();
+    m_words.clear();
+}
+
+} // namespace blink
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef WordMeasurementCache_h
+#define WordMeasurementCache_h
+
+#include "wtf/HashMap.h"
+#include "wtf/HashSet.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/Vector.h"
+#include "wtf/text/StringHash.h"
+#include "wtf/text/WTFString.h"
+
+namespace blink {
+
+class Font;
+class RenderBlockFlow;
+class RenderText;
+class SimpleFontData;
+
+// Widths of the words of a block's complex-path text, measured up front in
+// one pass before the line breaker runs. The pre-pass finds the same word
+// boundaries as BreakingContext::handleText does for white-space: normal
+// text, shapes every distinct word of a given font and direction only once,
+// and lets the breaker look the widths up instead of shaping each word as it
+// reaches it.
+// Words the pre-pass didn't predict (e.g. the first word of a line, or text
+// with a different first-line font) are simply misses.
+class WordMeasurementCache {
+public:
+    WordMeasurementCache();
+    ~WordMeasurementCache();
+
+    void measureWords(RenderBlockFlow&);
+    void clear();
+
+    // Returns false if the word wasn't measured up front. Otherwise sets its
+    // width and adds the fonts used besides the primary font to fallbackFonts.
+    bool lookup(RenderText*, const Font&, unsigned from, unsigned length, float& width, HashSet<const SimpleFontData*>* fallbackFonts) const;
+
+    bool isEmpty() const { return m_texts.isEmpty(); }
+
+private:
+    struct MeasuredWord {
+        MeasuredWord()
+            : width(0)
+        {
+        }
+
+        float width;
+        Vector<const SimpleFontData*> fallbackFonts;
+    };
+
+    struct TextWords {
+        explicit TextWords(const Font* font)
+            : font(font)
+        {
+        }
+
+        const Font* font;
+        // Keyed by (from << 32) | length, values index into m_words.
+        HashMap<uint64_t, unsigned> words;
+    };
+
+    typedef HashMap<String, unsigned> WordIndexMap;
+    void measureText(RenderText*, WordIndexMap&);
+
+    HashMap<RenderText*, OwnPtr<TextWords> > m_texts;
+    Vector<MeasuredWord> m_words;
+};
+
+} // namespace blink
+
+#endif // WordMeasurementCache_h
@@ -187,11 +187,14 @@ StyleRecalcChange RenderStyle::stylePropagationDiff(const RenderStyle* oldStyle,
         || oldStyle->alignItems() != newStyle->alignItems())
         return Reattach;
 
-    if (oldStyle->inheritedNotEqual(newStyle)
+    if (oldStyle->inheritedNotEqualIgnoringIndependentProperties(newStyle)
         || oldStyle->hasExplicitlyInheritedProperties()
         || newStyle->hasExplicitlyInheritedProperties())
         return Inherit;
 
+    if (oldStyle->independentInheritedPropertiesNotEqual(newStyle))
+        return IndependentInherit;
+
     if (*oldStyle == *newStyle)
         return diffPseudoStyles(oldStyle, newStyle);
 
@@ -251,6 +254,8 @@ void RenderStyle::copyNonInheritedFrom(const RenderStyle* other)
     noninherited_flags.pageBreakInside = other->noninherited_flags.pageBreakInside;
     noninherited_flags.explicitInheritance = other->noninherited_flags.explicitInheritance;
     noninherited_flags.hasViewportUnits = other->noninherited_flags.hasViewportUnits;
+    noninherited_flags.visibilityIsInherited = other->noninherited_flags.visibilityIsInherited;
+    noninherited_flags.pointerEventsIsInherited = other->noninherited_flags.pointerEventsIsInherited;
     if (m_svgStyle != other->m_svgStyle)
         m_svgStyle.access()->copyNonInheritedFrom(other->m_svgStyle.get());
     ASSERT(zoom() == initialZoom());
@@ -346,6 +351,32 @@ bool RenderStyle::inheritedNotEqual(const RenderStyle* other) const
         || rareInheritedData != other->rareInheritedData;
 }
 
+bool RenderStyle::inheritedNotEqualIgnoringIndependentProperties(const RenderStyle* other) const
+{
+    InheritedFlags flags = inherited_flags;
+    flags._visibility = other->inherited_flags._visibility;
+    flags._pointerEvents = other->inherited_flags._pointerEvents;
+    return flags != other->inherited_flags
+        || inherited != other->inherited
+        || font().loadingCustomFonts() != other->font().loadingCustomFonts()
+        || m_svgStyle->inheritedNotEqual(other->m_svgStyle.get())
+        || rareInheritedData != other->rareInheritedData;
+}
+
+bool RenderStyle::independentInheritedPropertiesNotEqual(const RenderStyle* other) const
+{
+    return inherited_flags._visibility != other->inherited_flags._visibility
+        || inherited_flags._pointerEvents != other->inherited_flags._pointerEvents;
+}
+
+void RenderStyle::propagateIndependentInheritedProperties(const RenderStyle& parentStyle)
+{
+    if (noninherited_flags.visibilityIsInherited)
+        inherited_flags._visibility = parentStyle.inherited_flags._visibility;
+    if (noninherited_flags.pointerEventsIsInherited)
+        inherited_flags._pointerEvents = parentStyle.inherited_flags._pointerEvents;
+}
+
 bool RenderStyle::inheritedDataShared(const RenderStyle* other) const
 {
     // This is a fast check that only looks if the data structures are shared.
@@ -433,6 +464,7 @@ bool RenderStyle::diffNeedsFullLayoutAndPaintInvalidation(const RenderStyle& oth
             || rareNonInheritedData->m_grid.get() != other.rareNonInheritedData->m_grid.get()
             || rareNonInheritedData->m_gridItem.get() != other.rareNonInheritedData->m_gridItem.get()
             || rareNonInheritedData->m_textCombine != other.rareNonInheritedData->m_textCombine
+            || rareNonInheritedData->m_contain != other.rareNonInheritedData->m_contain
             || rareNonInheritedData->hasFilters() != other.rareNonInheritedData->hasFilters())
             return true;
 
@@ -592,6 +624,9 @@ bool RenderStyle::diffNeedsFullLayout(const RenderStyle& other) const
 
         if (m_box->boxSizing() != other.m_box->boxSizing())
             return true;
+
+        if (m_box->alignSelf() != other.m_box->alignSelf())
+            return true;
     }
 
     if (noninherited_flags.verticalAlign != other.noninherited_flags.verticalAlign
@@ -605,8 +640,7 @@ bool RenderStyle::diffNeedsFullLayout(const RenderStyle& other) const
 
     if (rareNonInheritedData.get() != other.rareNonInheritedData.get()) {
         if (rareNonInheritedData->m_alignContent != other.rareNonInheritedData->m_alignContent
-            || rareNonInheritedData->m_alignItems != other.rareNonInheritedData->m_alignItems
-            || rareNonInheritedData->m_alignSelf != other.rareNonInheritedData->m_alignSelf)
+            || rareNonInheritedData->m_alignItems != other.rareNonInheritedData->m_alignItems)
             return true;
     }
 
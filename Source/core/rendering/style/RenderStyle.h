@@ -229,7 +229,9 @@ protected:
                 && explicitInheritance == other.explicitInheritance
                 && unique == other.unique
                 && emptyState == other.emptyState
-                && isLink == other.isLink;
+                && isLink == other.isLink
+                && visibilityIsInherited == other.visibilityIsInherited
+                && pointerEventsIsInherited == other.pointerEventsIsInherited;
         }
 
         bool operator!=(const NonInheritedFlags& other) const { return !(*this == other); }
@@ -268,6 +270,12 @@ protected:
         unsigned affectedByDrag : 1;
 
         unsigned isLink : 1;
+
+        // Set unless the cascade applied a value for the corresponding
+        // independent inherited property, in which case the element can't
+        // just take the value from its parent when only that property changes.
+        unsigned visibilityIsInherited : 1;
+        unsigned pointerEventsIsInherited : 1;
         // If you add more style bits here, you will also need to update RenderStyle::copyNonInheritedFrom()
         // 62 bits
     } noninherited_flags;
@@ -319,6 +327,8 @@ protected:
         noninherited_flags.affectedByActive = false;
         noninherited_flags.affectedByDrag = false;
         noninherited_flags.isLink = false;
+        noninherited_flags.visibilityIsInherited = true;
+        noninherited_flags.pointerEventsIsInherited = true;
     }
 
 private:
@@ -728,8 +738,8 @@ public:
     EAlignContent alignContent() const { return static_cast<EAlignContent>(rareNonInheritedData->m_alignContent); }
     ItemPosition alignItems() const { return static_cast<ItemPosition>(rareNonInheritedData->m_alignItems); }
     OverflowAlignment alignItemsOverflowAlignment() const { return static_cast<OverflowAlignment>(rareNonInheritedData->m_alignItemsOverflowAlignment); }
-    ItemPosition alignSelf() const { return static_cast<ItemPosition>(rareNonInheritedData->m_alignSelf); }
-    OverflowAlignment alignSelfOverflowAlignment() const { return static_cast<OverflowAlignment>(rareNonInheritedData->m_alignSelfOverflowAlignment); }
+    ItemPosition alignSelf() const { return m_box->alignSelf(); }
+    OverflowAlignment alignSelfOverflowAlignment() const { return m_box->alignSelfOverflowAlignment(); }
     EFlexDirection flexDirection() const { return static_cast<EFlexDirection>(rareNonInheritedData->m_flexibleBox->m_flexDirection); }
     bool isColumnFlexDirection() const { return flexDirection() == FlowColumn || flexDirection() == FlowColumnReverse; }
     bool isReverseFlexDirection() const { return flexDirection() == FlowRowReverse || flexDirection() == FlowColumnReverse; }
@@ -740,8 +750,8 @@ public:
     ItemPosition justifyItems() const { return static_cast<ItemPosition>(rareNonInheritedData->m_justifyItems); }
     OverflowAlignment justifyItemsOverflowAlignment() const { return static_cast<OverflowAlignment>(rareNonInheritedData->m_justifyItemsOverflowAlignment); }
     ItemPositionType justifyItemsPositionType() const { return static_cast<ItemPositionType>(rareNonInheritedData->m_justifyItemsPositionType); }
-    ItemPosition justifySelf() const { return static_cast<ItemPosition>(rareNonInheritedData->m_justifySelf); }
-    OverflowAlignment justifySelfOverflowAlignment() const { return static_cast<OverflowAlignment>(rareNonInheritedData->m_justifySelfOverflowAlignment); }
+    ItemPosition justifySelf() const { return m_box->justifySelf(); }
+    OverflowAlignment justifySelfOverflowAlignment() const { return m_box->justifySelfOverflowAlignment(); }
 
     const Vector<GridTrackSize>& gridTemplateColumns() const { return rareNonInheritedData->m_grid->m_gridTemplateColumns; }
     const Vector<GridTrackSize>& gridTemplateRows() const { return rareNonInheritedData->m_grid->m_gridTemplateRows; }
@@ -919,6 +929,10 @@ public:
     void setIsolation(EIsolation v) { rareNonInheritedData.access()->m_isolation = v; }
     bool hasIsolation() const { return isolation() != IsolationAuto; }
 
+    EContain contain() const { return static_cast<EContain>(rareNonInheritedData->m_contain); }
+    void setContain(EContain v) { SET_VAR(rareNonInheritedData, m_contain, v); }
+    bool hasStrictContainment() const { return contain() == ContainStrict; }
+
     bool shouldPlaceBlockDirectionScrollbarOnLogicalLeft() const { return !isLeftToRightDirection() && isHorizontalWritingMode(); }
 
     TouchAction touchAction() const { return static_cast<TouchAction>(rareNonInheritedData->m_touchAction); }
@@ -1217,8 +1231,8 @@ public:
     void setAlignContent(EAlignContent p) { SET_VAR(rareNonInheritedData, m_alignContent, p); }
     void setAlignItems(ItemPosition a) { SET_VAR(rareNonInheritedData, m_alignItems, a); }
     void setAlignItemsOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(rareNonInheritedData, m_alignItemsOverflowAlignment, overflowAlignment); }
-    void setAlignSelf(ItemPosition a) { SET_VAR(rareNonInheritedData, m_alignSelf, a); }
-    void setAlignSelfOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(rareNonInheritedData, m_alignSelfOverflowAlignment, overflowAlignment); }
+    void setAlignSelf(ItemPosition a) { SET_VAR(m_box, m_alignSelf, a); }
+    void setAlignSelfOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(m_box, m_alignSelfOverflowAlignment, overflowAlignment); }
     void setFlexDirection(EFlexDirection direction) { SET_VAR(rareNonInheritedData.access()->m_flexibleBox, m_flexDirection, direction); }
     void setFlexWrap(EFlexWrap w) { SET_VAR(rareNonInheritedData.access()->m_flexibleBox, m_flexWrap, w); }
     void setJustifyContent(ContentPosition p) { SET_VAR(rareNonInheritedData, m_justifyContent, p); }
@@ -1227,8 +1241,8 @@ public:
     void setJustifyItems(ItemPosition justifyItems) { SET_VAR(rareNonInheritedData, m_justifyItems, justifyItems); }
     void setJustifyItemsOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(rareNonInheritedData, m_justifyItemsOverflowAlignment, overflowAlignment); }
     void setJustifyItemsPositionType(ItemPositionType positionType) { SET_VAR(rareNonInheritedData, m_justifyItemsPositionType, positionType); }
-    void setJustifySelf(ItemPosition justifySelf) { SET_VAR(rareNonInheritedData, m_justifySelf, justifySelf); }
-    void setJustifySelfOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(rareNonInheritedData, m_justifySelfOverflowAlignment, overflowAlignment); }
+    void setJustifySelf(ItemPosition justifySelf) { SET_VAR(m_box, m_justifySelf, justifySelf); }
+    void setJustifySelfOverflowAlignment(OverflowAlignment overflowAlignment) { SET_VAR(m_box, m_justifySelfOverflowAlignment, overflowAlignment); }
     void setGridAutoColumns(const GridTrackSize& length) { SET_VAR(rareNonInheritedData.access()->m_grid, m_gridAutoColumns, length); }
     void setGridAutoRows(const GridTrackSize& length) { SET_VAR(rareNonInheritedData.access()->m_grid, m_gridAutoRows, length); }
     void setGridTemplateColumns(const Vector<GridTrackSize>& lengths) { SET_VAR(rareNonInheritedData.access()->m_grid, m_gridTemplateColumns, lengths); }
@@ -1434,6 +1448,8 @@ public:
     const AtomicString& hyphenString() const;
 
     bool inheritedNotEqual(const RenderStyle*) const;
+    bool inheritedNotEqualIgnoringIndependentProperties(const RenderStyle*) const;
+    bool independentInheritedPropertiesNotEqual(const RenderStyle*) const;
     bool inheritedDataShared(const RenderStyle*) const;
 
     bool isDisplayReplacedType() const { return isDisplayReplacedType(display()); }
@@ -1466,6 +1482,13 @@ public:
     void setHasExplicitlyInheritedProperties() { noninherited_flags.explicitInheritance = true; }
     bool hasExplicitlyInheritedProperties() const { return noninherited_flags.explicitInheritance; }
 
+    // Visibility and pointer-events are independent inherited properties: no other computed value
+    // depends on them, so a change to them can be propagated to descendants without a full
+    // style recalc (see StyleRecalcChange IndependentInherit).
+    void setVisibilityIsInherited(bool isInherited) { noninherited_flags.visibilityIsInherited = isInherited; }
+    void setPointerEventsIsInherited(bool isInherited) { noninherited_flags.pointerEventsIsInherited = isInherited; }
+    void propagateIndependentInheritedProperties(const RenderStyle& parentStyle);
+
     bool hasBoxDecorations() const { return hasBorder() || hasBorderRadius() || hasOutline() || hasAppearance() || boxShadow() || hasFilter() || resize() != RESIZE_NONE; }
 
     bool borderObscuresBackground() const;
@@ -1661,6 +1684,7 @@ public:
 #endif
     static WebBlendMode initialBlendMode() { return WebBlendModeNormal; }
     static EIsolation initialIsolation() { return IsolationAuto; }
+    static EContain initialContain() { return ContainNone; }
 private:
     void setVisitedLinkColor(const Color&);
     void setVisitedLinkBackgroundColor(const StyleColor& v) { SET_VAR(rareNonInheritedData, m_visitedLinkBackgroundColor, v); }
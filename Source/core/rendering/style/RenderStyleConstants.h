@@ -40,6 +40,7 @@ enum StyleRecalcChange {
     NoChange,
     NoInherit,
     UpdatePseudoElements,
+    IndependentInherit,
     Inherit,
     Force,
     Reattach,
@@ -505,6 +506,8 @@ inline TouchAction& operator&= (TouchAction& a, TouchAction b) { return a = a &
 
 enum EIsolation { IsolationAuto, IsolationIsolate };
 
+enum EContain { ContainNone, ContainStrict };
+
 enum ScrollBlocksOn {
     ScrollBlocksOnNone = 0x0,
     ScrollBlocksOnStartTouch = 0x1,
@@ -43,6 +43,10 @@ StyleBoxData::StyleBoxData()
     , m_hasAutoZIndex(true)
     , m_boxSizing(CONTENT_BOX)
     , m_boxDecorationBreak(DSLICE)
+    , m_alignSelf(RenderStyle::initialAlignSelf())
+    , m_alignSelfOverflowAlignment(RenderStyle::initialAlignSelfOverflowAlignment())
+    , m_justifySelf(RenderStyle::initialJustifySelf())
+    , m_justifySelfOverflowAlignment(RenderStyle::initialJustifySelfOverflowAlignment())
 {
 }
 
@@ -59,6 +63,10 @@ StyleBoxData::StyleBoxData(const StyleBoxData& o)
     , m_hasAutoZIndex(o.m_hasAutoZIndex)
     , m_boxSizing(o.m_boxSizing)
     , m_boxDecorationBreak(o.m_boxDecorationBreak)
+    , m_alignSelf(o.m_alignSelf)
+    , m_alignSelfOverflowAlignment(o.m_alignSelfOverflowAlignment)
+    , m_justifySelf(o.m_justifySelf)
+    , m_justifySelfOverflowAlignment(o.m_justifySelfOverflowAlignment)
 {
 }
 
@@ -75,6 +83,10 @@ bool StyleBoxData::operator==(const StyleBoxData& o) const
            && m_hasAutoZIndex == o.m_hasAutoZIndex
            && m_boxSizing == o.m_boxSizing
            && m_boxDecorationBreak == o.m_boxDecorationBreak
+           && m_alignSelf == o.m_alignSelf
+           && m_alignSelfOverflowAlignment == o.m_alignSelfOverflowAlignment
+           && m_justifySelf == o.m_justifySelf
+           && m_justifySelfOverflowAlignment == o.m_justifySelfOverflowAlignment
             ;
 }
 
@@ -60,6 +60,11 @@ public:
     EBoxSizing boxSizing() const { return static_cast<EBoxSizing>(m_boxSizing); }
     EBoxDecorationBreak boxDecorationBreak() const { return static_cast<EBoxDecorationBreak>(m_boxDecorationBreak); }
 
+    ItemPosition alignSelf() const { return static_cast<ItemPosition>(m_alignSelf); }
+    OverflowAlignment alignSelfOverflowAlignment() const { return static_cast<OverflowAlignment>(m_alignSelfOverflowAlignment); }
+    ItemPosition justifySelf() const { return static_cast<ItemPosition>(m_justifySelf); }
+    OverflowAlignment justifySelfOverflowAlignment() const { return static_cast<OverflowAlignment>(m_justifySelfOverflowAlignment); }
+
 private:
     friend class RenderStyle;
 
@@ -81,6 +86,14 @@ private:
     unsigned m_hasAutoZIndex : 1;
     unsigned m_boxSizing : 1; // EBoxSizing
     unsigned m_boxDecorationBreak : 1; // EBoxDecorationBreak
+
+    // Self-alignment is resolved against the parent by StyleAdjuster for every
+    // flex and grid item, so it lives here rather than in the much larger
+    // StyleRareNonInheritedData, which would otherwise be cloned for each item.
+    unsigned m_alignSelf : 4; // ItemPosition
+    unsigned m_alignSelfOverflowAlignment : 2; // OverflowAlignment
+    unsigned m_justifySelf : 4; // ItemPosition
+    unsigned m_justifySelfOverflowAlignment : 2; // OverflowAlignment
 };
 
 } // namespace blink
@@ -60,8 +60,6 @@ StyleRareNonInheritedData::StyleRareNonInheritedData()
     , m_alignContent(RenderStyle::initialAlignContent())
     , m_alignItems(RenderStyle::initialAlignItems())
     , m_alignItemsOverflowAlignment(RenderStyle::initialAlignItemsOverflowAlignment())
-    , m_alignSelf(RenderStyle::initialAlignSelf())
-    , m_alignSelfOverflowAlignment(RenderStyle::initialAlignSelfOverflowAlignment())
     , m_justifyContent(RenderStyle::initialJustifyContent())
     , m_justifyContentDistribution(RenderStyle::initialJustifyContentDistribution())
     , m_justifyContentOverflowAlignment(RenderStyle::initialJustifyContentOverflowAlignment())
@@ -84,11 +82,10 @@ StyleRareNonInheritedData::StyleRareNonInheritedData()
     , m_touchAction(RenderStyle::initialTouchAction())
     , m_objectFit(RenderStyle::initialObjectFit())
     , m_isolation(RenderStyle::initialIsolation())
+    , m_contain(RenderStyle::initialContain())
     , m_justifyItems(RenderStyle::initialJustifyItems())
     , m_justifyItemsOverflowAlignment(RenderStyle::initialJustifyItemsOverflowAlignment())
     , m_justifyItemsPositionType(RenderStyle::initialJustifyItemsPositionType())
-    , m_justifySelf(RenderStyle::initialJustifySelf())
-    , m_justifySelfOverflowAlignment(RenderStyle::initialJustifySelfOverflowAlignment())
     , m_scrollBehavior(RenderStyle::initialScrollBehavior())
     , m_scrollBlocksOn(RenderStyle::initialScrollBlocksOn())
     , m_requiresAcceleratedCompositingForExternalReasons(false)
@@ -142,8 +139,6 @@ StyleRareNonInheritedData::StyleRareNonInheritedData(const StyleRareNonInherited
     , m_alignContent(o.m_alignContent)
     , m_alignItems(o.m_alignItems)
     , m_alignItemsOverflowAlignment(o.m_alignItemsOverflowAlignment)
-    , m_alignSelf(o.m_alignSelf)
-    , m_alignSelfOverflowAlignment(o.m_alignSelfOverflowAlignment)
     , m_justifyContent(o.m_justifyContent)
     , m_justifyContentDistribution(o.m_justifyContentDistribution)
     , m_justifyContentOverflowAlignment(o.m_justifyContentOverflowAlignment)
@@ -166,11 +161,10 @@ StyleRareNonInheritedData::StyleRareNonInheritedData(const StyleRareNonInherited
     , m_touchAction(o.m_touchAction)
     , m_objectFit(o.m_objectFit)
     , m_isolation(o.m_isolation)
+    , m_contain(o.m_contain)
     , m_justifyItems(o.m_justifyItems)
     , m_justifyItemsOverflowAlignment(o.m_justifyItemsOverflowAlignment)
     , m_justifyItemsPositionType(o.m_justifyItemsPositionType)
-    , m_justifySelf(o.m_justifySelf)
-    , m_justifySelfOverflowAlignment(o.m_justifySelfOverflowAlignment)
     , m_scrollBehavior(o.m_scrollBehavior)
     , m_scrollBlocksOn(o.m_scrollBlocksOn)
     , m_requiresAcceleratedCompositingForExternalReasons(o.m_requiresAcceleratedCompositingForExternalReasons)
@@ -231,8 +225,6 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
         && m_alignContent == o.m_alignContent
         && m_alignItems == o.m_alignItems
         && m_alignItemsOverflowAlignment == o.m_alignItemsOverflowAlignment
-        && m_alignSelf == o.m_alignSelf
-        && m_alignSelfOverflowAlignment == o.m_alignSelfOverflowAlignment
         && m_justifyContent == o.m_justifyContent
         && m_justifyContentDistribution == o.m_justifyContentDistribution
         && m_justifyContentOverflowAlignment == o.m_justifyContentOverflowAlignment
@@ -252,11 +244,10 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
         && m_touchAction == o.m_touchAction
         && m_objectFit == o.m_objectFit
         && m_isolation == o.m_isolation
+        && m_contain == o.m_contain
         && m_justifyItems == o.m_justifyItems
         && m_justifyItemsOverflowAlignment == o.m_justifyItemsOverflowAlignment
         && m_justifyItemsPositionType == o.m_justifyItemsPositionType
-        && m_justifySelf == o.m_justifySelf
-        && m_justifySelfOverflowAlignment == o.m_justifySelfOverflowAlignment
         && m_scrollBehavior == o.m_scrollBehavior
         && m_scrollBlocksOn == o.m_scrollBlocksOn
         && m_requiresAcceleratedCompositingForExternalReasons == o.m_requiresAcceleratedCompositingForExternalReasons
@@ -153,8 +153,6 @@ public:
     unsigned m_alignContent : 3; // EAlignContent
     unsigned m_alignItems : 4; // ItemPosition
     unsigned m_alignItemsOverflowAlignment : 2; // OverflowAlignment
-    unsigned m_alignSelf : 4; // ItemPosition
-    unsigned m_alignSelfOverflowAlignment : 2; // OverflowAlignment
     unsigned m_justifyContent : 4; // ContentPosition
     unsigned m_justifyContentDistribution : 3; // ContentDistributionType
     unsigned m_justifyContentOverflowAlignment : 2; // OverflowAlignment
@@ -185,13 +183,12 @@ public:
 
     unsigned m_isolation : 1; // Isolation
 
+    unsigned m_contain : 1; // EContain
+
     unsigned m_justifyItems : 4; // ItemPosition
     unsigned m_justifyItemsOverflowAlignment : 2; // OverflowAlignment
     unsigned m_justifyItemsPositionType: 1; // Whether or not alignment uses the 'legacy' keyword.
 
-    unsigned m_justifySelf : 4; // ItemPosition
-    unsigned m_justifySelfOverflowAlignment : 2; // OverflowAlignment
-
     // ScrollBehavior. 'scroll-behavior' has 2 accepted values, but ScrollBehavior has a third
     // value (that can only be specified using CSSOM scroll APIs) so 2 bits are needed.
     unsigned m_scrollBehavior: 2;
@@ -331,6 +331,36 @@ unsigned Internals::hitTestCount(Document* doc, ExceptionState& exceptionState)
     return doc->renderView()->hitTestCount();
 }
 
+unsigned Internals::reusedLineBoxCount(Document* doc, ExceptionState& exceptionState) const
+{
+    if (!doc || !doc->renderView()) {
+        exceptionState.throwDOMException(InvalidAccessError, "Must supply a document with a renderer to check");
+        return 0;
+    }
+
+    return doc->renderView()->reusedLineBoxCount();
+}
+
+unsigned Internals::rebuiltLineBoxCount(Document* doc, ExceptionState& exceptionState) const
+{
+    if (!doc || !doc->renderView()) {
+        exceptionState.throwDOMException(InvalidAccessError, "Must supply a document with a renderer to check");
+        return 0;
+    }
+
+    return doc->renderView()->rebuiltLineBoxCount();
+}
+
+unsigned Internals::avoidedLayoutCount(Document* doc, ExceptionState& exceptionState) const
+{
+    if (!doc || !doc->renderView()) {
+        exceptionState.throwDOMException(InvalidAccessError, "Must supply a document with a renderer to check");
+        return 0;
+    }
+
+    return doc->renderView()->avoidedLayoutCount();
+}
+
 
 bool Internals::isPreloaded(const String& url)
 {
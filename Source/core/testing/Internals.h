@@ -127,6 +127,9 @@ public:
     unsigned updateStyleAndReturnAffectedElementCount(ExceptionState&) const;
     unsigned needsLayoutCount(ExceptionState&) const;
     unsigned hitTestCount(Document*, ExceptionState&) const;
+    unsigned reusedLineBoxCount(Document*, ExceptionState&) const;
+    unsigned rebuiltLineBoxCount(Document*, ExceptionState&) const;
+    unsigned avoidedLayoutCount(Document*, ExceptionState&) const;
 
     String visiblePlaceholder(Element*);
     void selectColorInColorChooser(Element*, const String& colorValue);
@@ -64,6 +64,7 @@ void FontFallbackList::invalidate(PassRefPtrWillBeRawPtr<FontSelector> fontSelec
     m_fontSelectorVersion = m_fontSelector ? m_fontSelector->version() : 0;
     m_generation = FontCache::fontCache()->generation();
     m_widthCache.clear();
+    m_shapeCache.clear();
 }
 
 void FontFallbackList::releaseFontData()
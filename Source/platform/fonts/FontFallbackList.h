@@ -24,6 +24,7 @@
 #include "platform/fonts/FontSelector.h"
 #include "platform/fonts/SimpleFontData.h"
 #include "platform/fonts/WidthCache.h"
+#include "platform/fonts/shaping/ShapeCache.h"
 #include "wtf/Forward.h"
 #include "wtf/MainThread.h"
 
@@ -82,6 +83,7 @@ public:
     unsigned generation() const { return m_generation; }
 
     WidthCache& widthCache() const { return m_widthCache; }
+    ShapeCache& shapeCache() const { return m_shapeCache; }
 
     const SimpleFontData* primarySimpleFontData(const FontDescription& fontDescription)
     {
@@ -120,6 +122,7 @@ private:
     mutable const SimpleFontData* m_cachedPrimarySimpleFontData;
     RefPtrWillBePersistent<FontSelector> m_fontSelector;
     mutable WidthCache m_widthCache;
+    mutable ShapeCache m_shapeCache;
     unsigned m_fontSelectorVersion;
     mutable int m_familyIndex;
     unsigned short m_generation;
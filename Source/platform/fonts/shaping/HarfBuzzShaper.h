@@ -153,8 +153,6 @@ private:
     float m_totalWidth;
     FloatRect m_glyphBoundingBox;
     HashSet<const SimpleFontData*>* m_fallbackFonts;
-
-    friend struct CachedShapingResults;
 };
 
 } // namespace blink
@@ -0,0 +1,116 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/fonts/shaping/ShapeCache.h"
+
+#include "hb.h"
+#include "platform/fonts/SimpleFontData.h"
+#include "wtf/StdLibExtras.h"
+#include "wtf/StringHasher.h"
+
+namespace blink {
+
+const size_t ShapeCache::maxByteSize;
+
+unsigned ShapeCacheKey::hash() const
+{
+    unsigned hashCodes[4] = {
+        text.impl() ? text.impl()->hash() : 0,
+        PtrHash<const SimpleFontData*>::hash(fontData),
+        direction,
+        script
+    };
+    return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+}
+
+static size_t s_totalByteSize = 0;
+
+ShapeCache::Entry::Entry(ShapeCache* cache, const ShapeCacheKey& key, hb_buffer_t* buffer)
+    : cache(cache)
+    , key(key)
+    , buffer(buffer)
+    , fontData(const_cast<SimpleFontData*>(key.fontData))
+{
+    byteSize = sizeof(Entry) + key.text.length() * sizeof(UChar)
+        + hb_buffer_get_length(buffer) * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t));
+}
+
+ShapeCache::Entry::~Entry()
+{
+    hb_buffer_destroy(buffer);
+}
+
+ShapeCache::ShapeCache()
+{
+}
+
+ShapeCache::~ShapeCache()
+{
+    clear();
+}
+
+ShapeCache::EntryList& ShapeCache::leastRecentlyUsedEntries()
+{
+    DEFINE_STATIC_LOCAL(EntryList, entries, ());
+    return entries;
+}
+
+size_t ShapeCache::totalByteSize()
+{
+    return s_totalByteSize;
+}
+
+hb_buffer_t* ShapeCache::find(const ShapeCacheKey& key)
+{
+    EntryMap::iterator it = m_entries.find(key);
+    if (it == m_entries.end())
+        return 0;
+    leastRecentlyUsedEntries().appendOrMoveToLast(it->value.get());
+    return it->value->buffer;
+}
+
+void ShapeCache::add(const ShapeCacheKey& key, hb_buffer_t* buffer)
+{
+    OwnPtr<Entry> entry = adoptPtr(new Entry(this, key, buffer));
+    // A single run this large would evict everything else.
+    if (entry->byteSize > maxByteSize / 4)
+        return;
+
+    EntryList& entries = leastRecentlyUsedEntries();
+    EntryMap::AddResult result = m_entries.add(key, nullptr);
+    if (!result.isNewEntry) {
+        s_totalByteSize -= result.storedValue->value->byteSize;
+        entries.remove(result.storedValue->value.get());
+    }
+    s_totalByteSize += entry->byteSize;
+    entries.add(entry.get());
+    result.storedValue->value = entry.release();
+
+    while (s_totalByteSize > maxByteSize)
+        removeLeastRecentlyUsed();
+}
+
+void ShapeCache::removeLeastRecentlyUsed()
+{
+    EntryList& entries = leastRecentlyUsedEntries();
+    ASSERT(!entries.isEmpty());
+    Entry* entry = entries.first();
+    entries.removeFirst();
+    s_totalByteSize -= entry->byteSize;
+    ShapeCacheKey key = entry->key;
+    entry->cache->m_entries.remove(key);
+}
+
+void ShapeCache::clear()
+{
+    EntryList& entries = leastRecentlyUsedEntries();
+    for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        entries.remove(it->value.get());
+        s_totalByteSize -= it->value->byteSize;
+    }
+    m_entries.clear();
+}
+
+} // namespace blink
@@ -0,0 +1,129 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ShapeCache_h
+#define ShapeCache_h
+
+#include "platform/PlatformExport.h"
+#include "wtf/HashMap.h"
+#include "wtf/HashTableDeletedValueType.h"
+#include "wtf/ListHashSet.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/RefPtr.h"
+#include "wtf/text/StringHash.h"
+#include "wtf/text/WTFString.h"
+
+struct hb_buffer_t;
+
+namespace blink {
+
+class SimpleFontData;
+
+struct ShapeCacheKey {
+    ShapeCacheKey()
+        : fontData(0)
+        , direction(0)
+        , script(0)
+    {
+    }
+
+    ShapeCacheKey(const String& text, const SimpleFontData* fontData, unsigned direction, unsigned script)
+        : text(text)
+        , fontData(fontData)
+        , direction(direction)
+        , script(script)
+    {
+    }
+
+    ShapeCacheKey(WTF::HashTableDeletedValueType)
+        : fontData(0)
+        , direction(hashTableDeletedDirection())
+        , script(0)
+    {
+    }
+
+    unsigned hash() const;
+
+    bool operator==(const ShapeCacheKey& other) const
+    {
+        return fontData == other.fontData
+            && direction == other.direction
+            && script == other.script
+            && text == other.text;
+    }
+
+    bool isHashTableDeletedValue() const { return direction == hashTableDeletedDirection(); }
+
+    String text;
+    const SimpleFontData* fontData;
+    unsigned direction; // hb_direction_t
+    unsigned script; // hb_script_t
+
+private:
+    static unsigned hashTableDeletedDirection() { return 0xFFFFFFFFU; }
+};
+
+struct ShapeCacheKeyHash {
+    static unsigned hash(const ShapeCacheKey& key) { return key.hash(); }
+    static bool equal(const ShapeCacheKey& a, const ShapeCacheKey& b) { return a == b; }
+    static const bool safeToCompareToEmptyOrDeleted = true;
+};
+
+struct ShapeCacheKeyTraits : WTF::SimpleClassHashTraits<ShapeCacheKey> { };
+
+// Caches the HarfBuzz output for the runs shaped with one FontFallbackList,
+// so that measuring, painting and hit testing the same text don't each shape
+// it again. The buffers are kept before letter-spacing, word-spacing and
+// justification are applied, which are cheap to redo. All caches share one
+// byte budget: once their entries together exceed it, entries are evicted in
+// least recently used order, whichever cache they belong to.
+class PLATFORM_EXPORT ShapeCache {
+    WTF_MAKE_NONCOPYABLE(ShapeCache);
+public:
+    ShapeCache();
+    ~ShapeCache();
+
+    // Returns the cached buffer, which stays owned by the cache, or 0.
+    hb_buffer_t* find(const ShapeCacheKey&);
+
+    // Takes ownership of the buffer.
+    void add(const ShapeCacheKey&, hb_buffer_t*);
+
+    void clear();
+
+    unsigned size() const { return m_entries.size(); }
+
+    // The size of the entries of all caches.
+    static size_t totalByteSize();
+
+    static const size_t maxByteSize = 512 * 1024;
+
+private:
+    struct Entry {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Entry(ShapeCache*, const ShapeCacheKey&, hb_buffer_t*);
+        ~Entry();
+
+        ShapeCache* cache;
+        ShapeCacheKey key;
+        hb_buffer_t* buffer;
+        // Fallback fonts aren't owned by the FontFallbackList, keep them alive
+        // while they are part of a key.
+        RefPtr<SimpleFontData> fontData;
+        size_t byteSize;
+    };
+
+    typedef ListHashSet<Entry*, 16> EntryList;
+    // The entries of all caches, least recently used first.
+    static EntryList& leastRecentlyUsedEntries();
+    static void removeLeastRecentlyUsed();
+
+    typedef HashMap<ShapeCacheKey, OwnPtr<Entry>, ShapeCacheKeyHash, ShapeCacheKeyTraits> EntryMap;
+    EntryMap m_entries;
+};
+
+} // namespace blink
+
+#endif // ShapeCache_h
@@ -0,0 +1,102 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/fonts/shaping/ShapeCache.h"
+
+#include "hb.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+hb_buffer_t* createBuffer(const String& text)
+{
+    hb_buffer_t* buffer = hb_buffer_create();
+    String text16 = text;
+    text16.ensure16Bit();
+    hb_buffer_add_utf16(buffer, reinterpret_cast<const uint16_t*>(text16.characters16()), text16.length(), 0, text16.length());
+    return buffer;
+}
+
+ShapeCacheKey keyForText(const String& text)
+{
+    return ShapeCacheKey(text, 0, HB_DIRECTION_LTR, HB_SCRIPT_LATIN);
+}
+
+TEST(ShapeCacheTest, FindMatchesTheWholeKey)
+{
+    ShapeCache cache;
+    EXPECT_FALSE(cache.find(keyForText("word")));
+
+    hb_buffer_t* buffer = createBuffer("word");
+    cache.add(keyForText("word"), buffer);
+    EXPECT_EQ(buffer, cache.find(keyForText("word")));
+    EXPECT_FALSE(cache.find(ShapeCacheKey("word", 0, HB_DIRECTION_RTL, HB_SCRIPT_LATIN)));
+    EXPECT_FALSE(cache.find(ShapeCacheKey("word", 0, HB_DIRECTION_LTR, HB_SCRIPT_GREEK)));
+}
+
+TEST(ShapeCacheTest, EvictsLeastRecentlyUsedOverBudget)
+{
+    ShapeCache cache;
+    cache.add(keyForText("first"), createBuffer("first"));
+    cache.add(keyForText("second"), createBuffer("second"));
+    EXPECT_TRUE(cache.find(keyForText("first")));
+
+    // Add entries until the first one is evicted.
+    unsigned previousSize;
+    unsigned i = 0;
+    do {
+        previousSize = cache.size();
+        cache.add(keyForText(String::number(i)), createBuffer(String::number(i)));
+        ++i;
+    } while (cache.size() > previousSize);
+
+    EXPECT_LE(ShapeCache::totalByteSize(), ShapeCache::maxByteSize);
+    EXPECT_FALSE(cache.find(keyForText("second")));
+    EXPECT_TRUE(cache.find(keyForText("first")));
+}
+
+TEST(ShapeCacheTest, CachesShareTheBudget)
+{
+    ShapeCache first;
+    ShapeCache second;
+    first.add(keyForText("word"), createBuffer("word"));
+
+    // Filling the second cache evicts the entry of the first one.
+    unsigned i = 0;
+    while (first.size()) {
+        second.add(keyForText(String::number(i)), createBuffer(String::number(i)));
+        ++i;
+    }
+    EXPECT_LE(ShapeCache::totalByteSize(), ShapeCache::maxByteSize);
+    EXPECT_FALSE(first.find(keyForText("word")));
+    EXPECT_TRUE(second.find(keyForText(String::number(i - 1))));
+}
+
+TEST(ShapeCacheTest, ClearRemovesEverything)
+{
+    size_t initialByteSize = ShapeCache::totalByteSize();
+    ShapeCache cache;
+    cache.add(keyForText("word"), createBuffer("word"));
+    EXPECT_LT(initialByteSize, ShapeCache::totalByteSize());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(initialByteSize, ShapeCache::totalByteSize());
+    EXPECT_FALSE(cache.find(keyForText("word")));
+}
+
+TEST(ShapeCacheTest, DestroyingACacheReleasesItsEntries)
+{
+    size_t initialByteSize = ShapeCache::totalByteSize();
+    {
+        ShapeCache cache;
+        cache.add(keyForText("word"), createBuffer("word"));
+    }
+    EXPECT_EQ(initialByteSize, ShapeCache::totalByteSize());
+}
+
+} // namespace
@@ -34,6 +34,8 @@
 #include "platform/graphics/ImageObserver.h"
 #include "platform/graphics/skia/NativeImageSkia.h"
 #include "platform/graphics/skia/SkiaUtils.h"
+#include "platform/image-decoders/ImageDecoder.h"
+#include "wtf/MathExtras.h"
 #include "wtf/PassRefPtr.h"
 #include "wtf/text/WTFString.h"
 
@@ -116,6 +118,14 @@ bool BitmapImage::currentFrameHasSingleSecurityOrigin() const
     return true;
 }
 
+void BitmapImage::scheduleDecodeAhead(unsigned distanceFromViewport)
+{
+    // Animated images decode their frames as they advance.
+    if (!m_allDataReceived || frameCount() > 1)
+        return;
+    m_source.scheduleDecodeAhead(distanceFromViewport);
+}
+
 void BitmapImage::destroyDecodedData(bool destroyAll)
 {
     for (size_t i = 0; i < m_frames.size(); ++i) {
@@ -124,6 +134,7 @@ void BitmapImage::destroyDecodedData(bool destroyAll)
         // the metadata.
         m_frames[i].clear(false);
     }
+    m_scaledFrames.clear();
 
     destroyMetadataAndNotify(m_source.clearCacheExceptFrame(destroyAll ? kNotFound : m_currentFrame));
 }
@@ -265,6 +276,32 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect, const Fl
     draw(ctxt, dstRect, srcRect, compositeOp, blendMode, DoNotRespectImageOrientation);
 }
 
+// Shrinks dstRect to the part of it inside the clip, and srcRect to the part
+// of the image that is drawn there.
+static void clipToVisibleRect(GraphicsContext* ctxt, FloatRect& srcRect, FloatRect& dstRect)
+{
+    FloatRect clipBounds;
+    SkMatrix ctm = ctxt->getTotalMatrix();
+    SkMatrix inverse;
+    if (!ctxt->getTransformedClipBounds(&clipBounds) || ctm.hasPerspective() || !ctm.invert(&inverse))
+        return;
+
+    SkRect localClipBounds;
+    inverse.mapRect(&localClipBounds, clipBounds);
+    FloatRect visibleDstRect = intersection(dstRect, FloatRect(localClipBounds));
+    if (visibleDstRect == dstRect)
+        return;
+
+    float scaleX = srcRect.width() / dstRect.width();
+    float scaleY = srcRect.height() / dstRect.height();
+    srcRect = FloatRect(
+        srcRect.x() + (visibleDstRect.x() - dstRect.x()) * scaleX,
+        srcRect.y() + (visibleDstRect.y() - dstRect.y()) * scaleY,
+        visibleDstRect.width() * scaleX,
+        visibleDstRect.height() * scaleY);
+    dstRect = visibleDstRect;
+}
+
 void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect, const FloatRect& srcRect, CompositeOperator compositeOp, WebBlendMode blendMode, RespectImageOrientationEnum shouldRespectImageOrientation)
 {
     // Spin the animation to the correct frame before we try to draw it, so we
@@ -304,16 +341,89 @@ void BitmapImage::draw(GraphicsContext* ctxt, const FloatRect& dstRect, const Fl
         }
     }
 
+    if (RefPtr<NativeImageSkia> scaledImage = scaledFrameForDestination(ctxt, normSrcRect, normDstRect)) {
+        normSrcRect.scale(
+            static_cast<float>(scaledImage->bitmap().width()) / image->bitmap().width(),
+            static_cast<float>(scaledImage->bitmap().height()) / image->bitmap().height());
+        image = scaledImage.release();
+    } else {
+        // Only the part of a very large image the clip leaves visible is
+        // decoded, and drawn.
+        FloatRect visibleSrcRect = normSrcRect;
+        FloatRect visibleDstRect = normDstRect;
+        clipToVisibleRect(ctxt, visibleSrcRect, visibleDstRect);
+        if (!visibleSrcRect.isEmpty()) {
+            if (RefPtr<NativeImageSkia> regionImage = regionFrameForSource(visibleSrcRect)) {
+                image = regionImage.release();
+                normSrcRect = visibleSrcRect;
+                normDstRect = visibleDstRect;
+            }
+        }
+    }
+
     image->draw(ctxt, normSrcRect, normDstRect, compositeOp, blendMode);
 
     if (ImageObserver* observer = imageObserver())
         observer->didDraw(this);
 }
 
+// Returns the smallest decoder scale numerator that still leaves twice the
+// device pixels the destination covers. Composited layers are rasterized at
+// the device scale, which isn't part of their CTM, and pinch zoom scales a
+// recording further until it's recorded again at the new scale.
+static unsigned scaleNumeratorForDestination(const SkMatrix& ctm, float deviceScaleFactor, const FloatRect& srcRect, const FloatRect& dstRect)
+{
+    if (ctm.hasPerspective())
+        return ImageDecoder::scaleDenominator;
+
+    float ctmScale = std::max(
+        sqrtf(ctm.getScaleX() * ctm.getScaleX() + ctm.getSkewY() * ctm.getSkewY()),
+        sqrtf(ctm.getSkewX() * ctm.getSkewX() + ctm.getScaleY() * ctm.getScaleY()));
+    float scale = ctmScale * deviceScaleFactor * std::max(dstRect.width() / srcRect.width(), dstRect.height() / srcRect.height());
+
+    unsigned scaleNumerator = ImageDecoder::scaleDenominator;
+    while (scaleNumerator > 1 && scaleNumerator / 2 >= 2 * scale * ImageDecoder::scaleDenominator)
+        scaleNumerator /= 2;
+    return scaleNumerator;
+}
+
+PassRefPtr<NativeImageSkia> BitmapImage::scaledFrameForDestination(GraphicsContext* ctxt, const FloatRect& srcRect, const FloatRect& dstRect)
+{
+    // Animated and partially loaded images always draw at full size.
+    if (!m_allDataReceived || frameCount() != 1 || m_currentFrame)
+        return nullptr;
+
+    unsigned scaleNumerator = scaleNumeratorForDestination(ctxt->getTotalMatrix(), ctxt->deviceScaleFactor(), srcRect, dstRect);
+    if (scaleNumerator == ImageDecoder::scaleDenominator)
+        return nullptr;
+
+    HashMap<unsigned, RefPtr<NativeImageSkia> >::AddResult result = m_scaledFrames.add(scaleNumerator, nullptr);
+    if (result.isNewEntry)
+        result.storedValue->value = m_source.createFrameAtScale(scaleNumerator);
+    return result.storedValue->value;
+}
+
+// Returns the part of a very large image that srcRect samples, and moves
+// srcRect into the returned frame's coordinates.
+PassRefPtr<NativeImageSkia> BitmapImage::regionFrameForSource(FloatRect& srcRect)
+{
+    if (!m_allDataReceived || frameCount() != 1 || m_currentFrame)
+        return nullptr;
+
+    // Leave a pixel around the source for filtering.
+    IntRect region = enclosingIntRect(srcRect);
+    region.inflate(1);
+    RefPtr<NativeImageSkia> image = m_source.createFrameForRegion(region);
+    if (image)
+        srcRect.move(-region.x(), -region.y());
+    return image.release();
+}
+
 void BitmapImage::resetDecoder()
 {
     ASSERT(isMainThread());
 
+    m_scaledFrames.clear();
     m_source.resetDecoder();
 }
 
@@ -505,6 +615,9 @@ void BitmapImage::startAnimation(CatchUpAnimation catchUpIfNecessary)
 
     if (catchUpIfNecessary == DoNotCatchUp || time < m_desiredFrameStartTime) {
         // Haven't yet reached time for next frame to start; delay until then.
+        // Meanwhile, decode the next frame so that drawing it doesn't stall.
+        if (m_allDataReceived)
+            m_source.scheduleFrameDecodeAhead(nextFrame);
         m_frameTimer = new Timer<BitmapImage>(this, &BitmapImage::advanceAnimation);
         m_frameTimer->startOneShot(std::max(m_desiredFrameStartTime - time, 0.), FROM_HERE);
     } else {
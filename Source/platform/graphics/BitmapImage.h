@@ -36,6 +36,7 @@
 #include "platform/graphics/ImageOrientation.h"
 #include "platform/graphics/ImageSource.h"
 #include "wtf/Forward.h"
+#include "wtf/HashMap.h"
 
 namespace blink {
 
@@ -66,6 +67,7 @@ public:
     virtual bool getHotSpot(IntPoint&) const override;
     virtual String filenameExtension() const override;
     virtual bool dataChanged(bool allDataReceived) override;
+    virtual void scheduleDecodeAhead(unsigned distanceFromViewport) override;
 
     bool isAllDataReceived() const { return m_allDataReceived; }
     bool hasColorProfile() const;
@@ -111,6 +113,11 @@ protected:
 
     PassRefPtr<NativeImageSkia> frameAtIndex(size_t);
 
+    // Returns the first frame decoded at a reduced size if drawing |srcRect|
+    // into |dstRect| needs far fewer pixels than the image has, or 0.
+    PassRefPtr<NativeImageSkia> scaledFrameForDestination(GraphicsContext*, const FloatRect& srcRect, const FloatRect& dstRect);
+    PassRefPtr<NativeImageSkia> regionFrameForSource(FloatRect& srcRect);
+
     bool frameIsCompleteAtIndex(size_t);
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t);
@@ -170,6 +177,7 @@ private:
 
     size_t m_currentFrame; // The index of the current frame of animation.
     Vector<FrameData, 1> m_frames; // An array of the cached frames of the animation. We have to ref frames to pin them in the cache.
+    HashMap<unsigned, RefPtr<NativeImageSkia> > m_scaledFrames; // The first frame at reduced sizes, keyed by scale numerator. Kept so that their resize caches survive across draws.
 
     Timer<BitmapImage>* m_frameTimer;
     int m_repetitionCount; // How many total animation loops we should do.  This will be cAnimationNone if this image type is incapable of animation.
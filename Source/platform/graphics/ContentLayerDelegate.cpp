@@ -50,7 +50,7 @@ ContentLayerDelegate::~ContentLayerDelegate()
 {
 }
 
-void ContentLayerDelegate::paintContents(
+void ContentLayerDelegate::paint(
     SkCanvas* canvas, const WebRect& clip, bool canPaintLCDText,
     WebContentLayerClient::GraphicsContextStatus contextStatus)
 {
@@ -67,6 +67,21 @@ void ContentLayerDelegate::paintContents(
     m_painter->paint(context, clip);
 }
 
+void ContentLayerDelegate::paintContents(
+    SkCanvas* canvas, const WebRect& clip, bool canPaintLCDText,
+    WebContentLayerClient::GraphicsContextStatus contextStatus)
+{
+    paint(canvas, clip, canPaintLCDText, contextStatus);
+
+    // With Slimming Paint, the painter only recorded display items. The
+    // compositor asked for pixels, so raster the items that touch the clip.
+    DisplayItemList* displayItemList = m_painter->displayItemList();
+    if (displayItemList && contextStatus == WebContentLayerClient::GraphicsContextEnabled) {
+        GraphicsContext context(canvas, nullptr);
+        displayItemList->replay(&context, clip);
+    }
+}
+
 void ContentLayerDelegate::paintContents(
     WebDisplayItemList* webDisplayItemList, const WebRect& clip, bool canPaintLCDText,
     WebContentLayerClient::GraphicsContextStatus contextStatus)
@@ -85,7 +100,7 @@ void ContentLayerDelegate::paintContents(
     canvas->save();
     canvas->translate(-clip.x, -clip.y);
     canvas->clipRect(SkRect::MakeXYWH(clip.x, clip.y, clip.width, clip.height));
-    paintContents(canvas, clip, canPaintLCDText, contextStatus);
+    paint(canvas, clip, canPaintLCDText, contextStatus);
     canvas->restore();
     picture = adoptRef(recorder.endRecording());
 
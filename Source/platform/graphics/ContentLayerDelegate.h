@@ -66,6 +66,8 @@ public:
     virtual void paintContents(WebDisplayItemList*, const WebRect& clip, bool canPaintLCDText, WebContentLayerClient::GraphicsContextStatus = GraphicsContextEnabled) override;
 
 private:
+    void paint(SkCanvas*, const WebRect& clip, bool canPaintLCDText, WebContentLayerClient::GraphicsContextStatus);
+
     GraphicsContextPainter* m_painter;
     bool m_opaque;
 };
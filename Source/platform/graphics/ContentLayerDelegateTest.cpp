@@ -0,0 +1,103 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/ContentLayerDelegate.h"
+
+#include "platform/RuntimeEnabledFeatures.h"
+#include "platform/geometry/IntRect.h"
+#include "platform/graphics/GraphicsContext.h"
+#include "platform/graphics/paint/DisplayItemList.h"
+#include "platform/graphics/paint/DrawingDisplayItem.h"
+#include "public/platform/WebRect.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+const int layerWidth = 800;
+const int rowHeight = 20;
+const int rowCount = 5000;
+
+// Paints a very long layer made of one drawing per row, like a long page of
+// text.
+class RowsPainter : public GraphicsContextPainter {
+public:
+    RowsPainter() : m_displayItemList(DisplayItemList::create()) { }
+
+    virtual void paint(GraphicsContext& context, const IntRect&) override
+    {
+        ASSERT(context.displayItemList() == m_displayItemList.get());
+        for (int row = 0; row < rowCount; ++row) {
+            SkRect rect = SkRect::MakeXYWH(0, row * rowHeight, layerWidth, rowHeight - 4);
+            SkPictureRecorder recorder;
+            SkCanvas* canvas = recorder.beginRecording(rect);
+            canvas->drawRect(rect, SkPaint());
+            m_displayItemList->add(DrawingDisplayItem::create(reinterpret_cast<DisplayItemClient>(this), DisplayItem::DrawingPaintPhaseForeground, adoptRef(recorder.endRecording())));
+        }
+    }
+
+    virtual DisplayItemList* displayItemList() override { return m_displayItemList.get(); }
+
+private:
+    OwnPtr<DisplayItemList> m_displayItemList;
+};
+
+class PictureCountingCanvas : public SkCanvas {
+public:
+    PictureCountingCanvas() : SkCanvas(layerWidth, rowHeight * rowCount), m_pictureCount(0) { }
+
+    int pictureCount() const { return m_pictureCount; }
+
+protected:
+    virtual void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override
+    {
+        ++m_pictureCount;
+    }
+
+private:
+    int m_pictureCount;
+};
+
+class ContentLayerDelegateTest : public ::testing::Test {
+protected:
+    virtual void SetUp() override
+    {
+        m_wasSlimmingPaintEnabled = RuntimeEnabledFeatures::slimmingPaintEnabled();
+        RuntimeEnabledFeatures::setSlimmingPaintEnabled(true);
+    }
+
+    virtual void TearDown() override
+    {
+        RuntimeEnabledFeatures::setSlimmingPaintEnabled(m_wasSlimmingPaintEnabled);
+    }
+
+    bool m_wasSlimmingPaintEnabled;
+};
+
+TEST_F(ContentLayerDelegateTest, CanvasPaintReplaysDisplayItemsInClip)
+{
+    RowsPainter painter;
+    ContentLayerDelegate delegate(&painter);
+    PictureCountingCanvas canvas;
+
+    // Rows 500 to 505 touch the clip.
+    delegate.paintContents(&canvas, WebRect(0, 10000, layerWidth, 100), false);
+    EXPECT_EQ(6, canvas.pictureCount());
+}
+
+TEST_F(ContentLayerDelegateTest, CanvasPaintReplaysAllDisplayItemsForFullClip)
+{
+    RowsPainter painter;
+    ContentLayerDelegate delegate(&painter);
+    PictureCountingCanvas canvas;
+
+    delegate.paintContents(&canvas, WebRect(0, 0, layerWidth, rowHeight * rowCount), false);
+    EXPECT_EQ(rowCount, canvas.pictureCount());
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/DecodedYUVPlanes.h"
+
+#include "platform/image-decoders/ImageDecoder.h"
+#include "platform/image-decoders/RowConversion.h"
+
+namespace blink {
+
+// Returns log2 of how many luma samples a chroma sample covers, given that
+// chroma lengths are rounded up.
+static unsigned chromaShift(int lumaLength, int chromaLength)
+{
+    unsigned shift = 0;
+    while (shift < 2 && (chromaLength << shift) < lumaLength)
+        ++shift;
+    return shift;
+}
+
+PassOwnPtr<DecodedYUVPlanes> DecodedYUVPlanes::create(const SkISize allocationSizes[3])
+{
+    return adoptPtr(new DecodedYUVPlanes(allocationSizes));
+}
+
+DecodedYUVPlanes::DecodedYUVPlanes(const SkISize allocationSizes[3])
+{
+    for (int i = 0; i < 3; ++i) {
+        m_rowBytes[i] = allocationSizes[i].width();
+        m_planes[i].resize(m_rowBytes[i] * allocationSizes[i].height());
+        m_componentSizes[i] = allocationSizes[i];
+    }
+}
+
+PassOwnPtr<ImagePlanes> DecodedYUVPlanes::imagePlanes()
+{
+    void* planes[3] = { m_planes[0].data(), m_planes[1].data(), m_planes[2].data() };
+    return adoptPtr(new ImagePlanes(planes, m_rowBytes));
+}
+
+void DecodedYUVPlanes::setComponentSizes(const SkISize componentSizes[3])
+{
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(static_cast<size_t>(componentSizes[i].width()) <= m_rowBytes[i]);
+        ASSERT(static_cast<size_t>(componentSizes[i].width()) * componentSizes[i].height() <= m_planes[i].size());
+        m_componentSizes[i] = componentSizes[i];
+    }
+}
+
+size_t DecodedYUVPlanes::memoryUsageInBytes() const
+{
+    return m_planes[0].size() + m_planes[1].size() + m_planes[2].size();
+}
+
+void DecodedYUVPlanes::convertToRGB(const SkIRect& region, void* pixels, size_t rowBytes) const
+{
+    ASSERT(SkIRect::MakeSize(size()).contains(region));
+    // JPEGImageDecoder only decodes U and V planes of the same size.
+    ASSERT(m_componentSizes[1] == m_componentSizes[2]);
+
+    const unsigned horizontalShift = chromaShift(m_componentSizes[0].width(), m_componentSizes[1].width());
+    const unsigned verticalShift = chromaShift(m_componentSizes[0].height(), m_componentSizes[1].height());
+    char* row = static_cast<char*>(pixels);
+    for (int y = region.top(); y < region.bottom(); ++y, row += rowBytes) {
+        const size_t chromaRow = y >> verticalShift;
+        RowConversion::packYUV(m_planes[0].data() + y * m_rowBytes[0],
+            m_planes[1].data() + chromaRow * m_rowBytes[1],
+            m_planes[2].data() + chromaRow * m_rowBytes[2],
+            horizontalShift, region.left(), reinterpret_cast<ImageFrame::PixelData*>(row), region.width());
+    }
+}
+
+} // namespace blink
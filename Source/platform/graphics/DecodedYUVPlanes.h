@@ -0,0 +1,54 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DecodedYUVPlanes_h
+#define DecodedYUVPlanes_h
+
+#include "SkRect.h"
+#include "SkSize.h"
+#include "platform/PlatformExport.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class ImagePlanes;
+
+// Owns the Y, U and V planes of a JPEG decoded by
+// JPEGImageDecoder::decodeToYUV(). With 4:2:0 subsampling they take 1.5 bytes
+// per pixel instead of the 4 of decoded pixels, and are converted to pixels
+// for the software rasterizer a region at a time.
+class PLATFORM_EXPORT DecodedYUVPlanes {
+    WTF_MAKE_NONCOPYABLE(DecodedYUVPlanes); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // |allocationSizes| are the decoder's component sizes for memory
+    // allocation, which are padded to whole DCT blocks.
+    static PassOwnPtr<DecodedYUVPlanes> create(const SkISize allocationSizes[3]);
+
+    // Planes for the decoder to write into.
+    PassOwnPtr<ImagePlanes> imagePlanes();
+
+    // The decoded component sizes, which fit in the allocated ones.
+    void setComponentSizes(const SkISize componentSizes[3]);
+    SkISize size() const { return m_componentSizes[0]; }
+
+    size_t memoryUsageInBytes() const;
+
+    // Converts |region| of the image to opaque N32 pixels. Chroma is
+    // replicated, not interpolated, across the luma samples it covers.
+    void convertToRGB(const SkIRect& region, void* pixels, size_t rowBytes) const;
+
+private:
+    explicit DecodedYUVPlanes(const SkISize allocationSizes[3]);
+
+    Vector<unsigned char> m_planes[3];
+    size_t m_rowBytes[3];
+    SkISize m_componentSizes[3];
+};
+
+} // namespace blink
+
+#endif // DecodedYUVPlanes_h
@@ -36,10 +36,11 @@
 
 namespace blink {
 
-DecodingImageGenerator::DecodingImageGenerator(PassRefPtr<ImageFrameGenerator> frameGenerator, const SkImageInfo& info, size_t index)
+DecodingImageGenerator::DecodingImageGenerator(PassRefPtr<ImageFrameGenerator> frameGenerator, const SkImageInfo& info, size_t index, const SkIRect& region)
     : m_frameGenerator(frameGenerator)
     , m_imageInfo(info)
     , m_frameIndex(index)
+    , m_region(region)
     , m_generationId(0)
 {
 }
@@ -53,6 +54,8 @@ SkData* DecodingImageGenerator::onRefEncodedData()
     // FIXME: If the image has been clipped or scaled, do not return the original
     // encoded data, since on playback it will not be known how the clipping/scaling
     // was done.
+    if (!m_region.isEmpty())
+        return 0;
     RefPtr<SharedBuffer> buffer = nullptr;
     bool allDataReceived = false;
     m_frameGenerator->copyData(&buffer, &allDataReceived);
@@ -71,15 +74,23 @@ bool DecodingImageGenerator::onGetPixels(const SkImageInfo& info, void* pixels,
 {
     TRACE_EVENT1("blink", "DecodingImageGenerator::getPixels", "index", static_cast<int>(m_frameIndex));
 
-    // Implementation doesn't support scaling yet so make sure we're not given a different size.
-    if (info.width() != m_imageInfo.width() || info.height() != m_imageInfo.height() || info.colorType() != m_imageInfo.colorType()) {
-        // ImageFrame may have changed the owning SkBitmap to kOpaque_SkAlphaType after sniffing the encoded data, so if we see a request
-        // for opaque, that is ok even if our initial alphatype was not opaque.
+    // ImageFrame may have changed the owning SkBitmap to kOpaque_SkAlphaType after sniffing the encoded data, so if we see a request
+    // for opaque, that is ok even if our initial alphatype was not opaque.
+    if (info.colorType() != m_imageInfo.colorType())
+        return false;
+
+    // Whole frames may be asked for at a smaller size at raster time, and
+    // ImageFrameGenerator picks the decode size from that. Regions are only
+    // decoded at their own size.
+    bool smallerSize = info.width() <= m_imageInfo.width() && info.height() <= m_imageInfo.height();
+    bool sameSize = info.width() == m_imageInfo.width() && info.height() == m_imageInfo.height();
+    if (m_region.isEmpty() ? !smallerSize : !sameSize)
         return false;
-    }
 
     PlatformInstrumentation::willDecodeLazyPixelRef(m_generationId);
-    bool decoded = m_frameGenerator->decodeAndScale(m_imageInfo, m_frameIndex, pixels, rowBytes);
+    bool decoded = m_region.isEmpty()
+        ? m_frameGenerator->decodeAndScale(SkImageInfo::Make(info.width(), info.height(), m_imageInfo.colorType(), m_imageInfo.alphaType()), m_frameIndex, pixels, rowBytes)
+        : m_frameGenerator->decodeRegion(m_imageInfo, m_region, m_frameIndex, pixels, rowBytes);
     PlatformInstrumentation::didDecodeLazyPixelRef();
     return decoded;
 }
@@ -89,6 +100,10 @@ bool DecodingImageGenerator::onGetYUV8Planes(SkISize sizes[3], void* planes[3],
     if (!RuntimeEnabledFeatures::decodeToYUVEnabled())
         return false;
 
+    // YUV planes are only ever decoded for the whole frame at full size.
+    if (!m_region.isEmpty() || m_imageInfo.width() != m_frameGenerator->getFullSize().width() || m_imageInfo.height() != m_frameGenerator->getFullSize().height())
+        return false;
+
     if (!planes || !planes[0])
         return m_frameGenerator->getYUVComponentSizes(sizes);
 
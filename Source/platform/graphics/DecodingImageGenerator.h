@@ -28,6 +28,7 @@
 
 #include "SkImageGenerator.h"
 #include "SkImageInfo.h"
+#include "SkRect.h"
 
 #include "wtf/RefPtr.h"
 
@@ -44,7 +45,9 @@ class ImageFrameGenerator;
 // as and adapter to ImageFrameGenerator which actually performs decoding.
 class DecodingImageGenerator final : public SkImageGenerator {
 public:
-    DecodingImageGenerator(PassRefPtr<ImageFrameGenerator>, const SkImageInfo&, size_t index);
+    // A non-empty |region| makes this generator produce only that part of
+    // the frame, see ImageFrameGenerator::decodeRegion().
+    DecodingImageGenerator(PassRefPtr<ImageFrameGenerator>, const SkImageInfo&, size_t index, const SkIRect& region = SkIRect::MakeEmpty());
     virtual ~DecodingImageGenerator();
 
     void setGenerationId(size_t id) { m_generationId = id; }
@@ -59,6 +62,7 @@ private:
     RefPtr<ImageFrameGenerator> m_frameGenerator;
     SkImageInfo m_imageInfo;
     size_t m_frameIndex;
+    SkIRect m_region;
     size_t m_generationId;
 };
 
@@ -27,6 +27,7 @@
 #include "platform/graphics/DeferredImageDecoder.h"
 
 #include "platform/graphics/DecodingImageGenerator.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
 #include "platform/graphics/ImageDecodingStore.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "wtf/PassOwnPtr.h"
@@ -38,6 +39,18 @@ namespace {
 // URI label for SkDiscardablePixelRef.
 const char labelDiscardable[] = "discardable";
 
+// Images of more pixels than this are decoded a region at a time, in tiles
+// of regionTileSize pixels.
+const uint64_t minRegionDecodePixels = 4096 * 4096;
+const int regionTileSize = 512;
+const size_t maxRegionBitmaps = 16;
+
+uint64_t regionKey(const IntRect& tiles)
+{
+    // PNG and JPEG images have fewer than 2^16 tiles along each side.
+    return static_cast<uint64_t>(tiles.x()) << 48 | static_cast<uint64_t>(tiles.y()) << 32 | static_cast<uint64_t>(tiles.maxX()) << 16 | tiles.maxY();
+}
+
 } // namespace
 
 bool DeferredImageDecoder::s_enabled = false;
@@ -50,6 +63,8 @@ DeferredImageDecoder::DeferredImageDecoder(PassOwnPtr<ImageDecoder> actualDecode
     , m_orientation(DefaultImageOrientation)
     , m_repetitionCount(cAnimationNone)
     , m_hasColorProfile(false)
+    , m_canDecodeToScale(false)
+    , m_canDecodeRegion(false)
 {
 }
 
@@ -189,6 +204,73 @@ float DeferredImageDecoder::frameDurationAtIndex(size_t index) const
     return 0;
 }
 
+void DeferredImageDecoder::scheduleDecodeAhead(unsigned distanceFromViewport)
+{
+    if (!m_frameGenerator || m_frameGenerator->isMultiFrame() || !m_frameGenerator->needsDecodeAhead(0))
+        return;
+    ImageDecodeScheduler::instance()->schedule(m_frameGenerator, 0, distanceFromViewport);
+}
+
+void DeferredImageDecoder::scheduleFrameDecodeAhead(size_t index)
+{
+    if (!m_frameGenerator || !m_frameGenerator->isMultiFrame() || index >= m_lazyDecodedFrames.size() || !m_frameGenerator->needsDecodeAhead(index))
+        return;
+    // The animation is on screen, so it's as urgent as anything else there.
+    ImageDecodeScheduler::instance()->schedule(m_frameGenerator, index, 0);
+}
+
+SkBitmap DeferredImageDecoder::scaledBitmap(unsigned scaleNumerator)
+{
+    // Only once all data is received, since scaled bitmaps aren't updated
+    // as more data arrives.
+    if (m_actualDecoder || !m_frameGenerator || !m_canDecodeToScale || m_frameGenerator->isMultiFrame() || m_lazyDecodedFrames.size() != 1)
+        return SkBitmap();
+
+    HashMap<unsigned, SkBitmap>::AddResult result = m_scaledBitmaps.add(scaleNumerator, SkBitmap());
+    if (result.isNewEntry)
+        result.storedValue->value = createBitmap(0, ImageDecoder::scaledSize(m_size, scaleNumerator));
+    // Opaque bitmaps draw faster, see frameBufferAtIndex().
+    if (!m_frameGenerator->hasAlpha(0))
+        result.storedValue->value.setAlphaType(kOpaque_SkAlphaType);
+    return result.storedValue->value;
+}
+
+SkBitmap DeferredImageDecoder::regionBitmap(IntRect& region)
+{
+    if (m_actualDecoder || !m_frameGenerator || !m_canDecodeRegion || m_frameGenerator->isMultiFrame() || m_lazyDecodedFrames.size() != 1)
+        return SkBitmap();
+    if (static_cast<uint64_t>(m_size.width()) * m_size.height() < minRegionDecodePixels)
+        return SkBitmap();
+
+    region.intersect(IntRect(IntPoint(), m_size));
+    if (region.isEmpty())
+        return SkBitmap();
+    int firstTileX = region.x() / regionTileSize;
+    int firstTileY = region.y() / regionTileSize;
+    int lastTileX = (region.maxX() - 1) / regionTileSize;
+    int lastTileY = (region.maxY() - 1) / regionTileSize;
+    IntRect tiles(firstTileX, firstTileY, lastTileX - firstTileX + 1, lastTileY - firstTileY + 1);
+    IntRect tileAlignedRegion(tiles.x() * regionTileSize, tiles.y() * regionTileSize, tiles.width() * regionTileSize, tiles.height() * regionTileSize);
+    tileAlignedRegion.intersect(IntRect(IntPoint(), m_size));
+    // Draws of most of the image decode it as a whole.
+    if (static_cast<uint64_t>(tileAlignedRegion.width()) * tileAlignedRegion.height() * 2 > static_cast<uint64_t>(m_size.width()) * m_size.height())
+        return SkBitmap();
+
+    // The bitmaps only reference their pixels, which Skia may have purged
+    // already, so dropping them all is cheap.
+    uint64_t key = regionKey(tiles);
+    if (m_regionBitmaps.size() >= maxRegionBitmaps && !m_regionBitmaps.contains(key))
+        m_regionBitmaps.clear();
+
+    HashMap<uint64_t, SkBitmap>::AddResult result = m_regionBitmaps.add(key, SkBitmap());
+    if (result.isNewEntry) {
+        SkIRect skRegion = SkIRect::MakeXYWH(tileAlignedRegion.x(), tileAlignedRegion.y(), tileAlignedRegion.width(), tileAlignedRegion.height());
+        result.storedValue->value = createBitmap(0, tileAlignedRegion.size(), skRegion);
+    }
+    region = tileAlignedRegion;
+    return result.storedValue->value;
+}
+
 unsigned DeferredImageDecoder::frameBytesAtIndex(size_t index) const
 {
     // If frame decoding is deferred then it is not managed by MemoryCache
@@ -209,6 +291,11 @@ void DeferredImageDecoder::activateLazyDecoding()
     m_orientation = m_actualDecoder->orientation();
     m_filenameExtension = m_actualDecoder->filenameExtension();
     m_hasColorProfile = m_actualDecoder->hasColorProfile();
+    // Images already downsampled to fit the decoded byte limit are decoded as
+    // a whole, at that size. WebP only knows whether it can scale once the
+    // header is parsed, which it is by now.
+    m_canDecodeToScale = m_actualDecoder->canDecodeToScale() && m_actualDecoder->decodedSize() == m_size;
+    m_canDecodeRegion = m_actualDecoder->canDecodeRegion() && m_actualDecoder->decodedSize() == m_size;
     const bool isSingleFrame = m_actualDecoder->repetitionCount() == cAnimationNone || (m_allDataReceived && m_actualDecoder->frameCount() == 1u);
     m_frameGenerator = ImageFrameGenerator::create(SkISize::Make(m_actualDecoder->decodedSize().width(), m_actualDecoder->decodedSize().height()), m_data, m_allDataReceived, !isSingleFrame);
 }
@@ -232,7 +319,7 @@ void DeferredImageDecoder::prepareLazyDecodedFrames()
 
     for (size_t i = previousSize; i < m_lazyDecodedFrames.size(); ++i) {
         OwnPtr<ImageFrame> frame(adoptPtr(new ImageFrame()));
-        frame->setSkBitmap(createBitmap(i));
+        frame->setSkBitmap(createBitmap(i, m_actualDecoder->decodedSize()));
         frame->setDuration(m_actualDecoder->frameDurationAtIndex(i));
         frame->setStatus(m_actualDecoder->frameIsCompleteAtIndex(i) ? ImageFrame::FrameComplete : ImageFrame::FramePartial);
         m_lazyDecodedFrames[i] = frame.release();
@@ -248,7 +335,7 @@ void DeferredImageDecoder::prepareLazyDecodedFrames()
         // Skia to decode again.
         if (m_dataChanged) {
             m_dataChanged = false;
-            m_lazyDecodedFrames[lastFrame]->setSkBitmap(createBitmap(lastFrame));
+            m_lazyDecodedFrames[lastFrame]->setSkBitmap(createBitmap(lastFrame, m_actualDecoder->decodedSize()));
         }
     }
 
@@ -260,9 +347,8 @@ void DeferredImageDecoder::prepareLazyDecodedFrames()
 }
 
 // Creates a SkBitmap that is backed by SkDiscardablePixelRef.
-SkBitmap DeferredImageDecoder::createBitmap(size_t index)
+SkBitmap DeferredImageDecoder::createBitmap(size_t index, const IntSize& decodedSize, const SkIRect& region)
 {
-    IntSize decodedSize = m_actualDecoder->decodedSize();
     ASSERT(decodedSize.width() > 0);
     ASSERT(decodedSize.height() > 0);
 
@@ -274,7 +360,7 @@ SkBitmap DeferredImageDecoder::createBitmap(size_t index)
     const SkImageInfo info = SkImageInfo::Make(decodedSize.width(), decodedSize.height(), colorType, kPremul_SkAlphaType);
 
     SkBitmap bitmap;
-    DecodingImageGenerator* generator = new DecodingImageGenerator(m_frameGenerator, info, index);
+    DecodingImageGenerator* generator = new DecodingImageGenerator(m_frameGenerator, info, index, region);
     bool installed = SkInstallDiscardablePixelRef(generator, &bitmap);
     ASSERT_UNUSED(installed, installed);
     bitmap.pixelRef()->setURI(labelDiscardable);
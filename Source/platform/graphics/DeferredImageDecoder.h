@@ -34,6 +34,7 @@
 #include "platform/graphics/ImageSource.h"
 #include "platform/image-decoders/ImageDecoder.h"
 #include "wtf/Forward.h"
+#include "wtf/HashMap.h"
 #include "wtf/OwnPtr.h"
 #include "wtf/Vector.h"
 
@@ -75,13 +76,31 @@ public:
     ImageOrientation orientation() const;
     bool hotSpot(IntPoint&) const;
 
+    // Queues the first frame on ImageDecodeScheduler if decoding is deferred.
+    void scheduleDecodeAhead(unsigned distanceFromViewport);
+
+    // Queues frame |index| of an animation on ImageDecodeScheduler if
+    // decoding is deferred, so that it's decoded by the time it's shown.
+    void scheduleFrameDecodeAhead(size_t index);
+
+    // Returns a lazily decoded bitmap of the first frame that decodes at
+    // scaleNumerator / ImageDecoder::scaleDenominator of the image size, or
+    // a null bitmap if the decoder can't decode at a reduced size.
+    SkBitmap scaledBitmap(unsigned scaleNumerator);
+
+    // For images too large to decode as a whole, returns a lazily decoded
+    // bitmap of the part of the first frame in |region|, and grows |region|
+    // to the tiles the bitmap covers so that nearby draws share it. Returns
+    // a null bitmap if the image is decoded as a whole instead.
+    SkBitmap regionBitmap(IntRect& region);
+
     // For testing.
     ImageFrameGenerator* frameGenerator() { return m_frameGenerator.get(); }
 
 private:
     explicit DeferredImageDecoder(PassOwnPtr<ImageDecoder> actualDecoder);
     void prepareLazyDecodedFrames();
-    SkBitmap createBitmap(size_t index);
+    SkBitmap createBitmap(size_t index, const IntSize& decodedSize, const SkIRect& region = SkIRect::MakeEmpty());
     void activateLazyDecoding();
 
     RefPtr<SharedBuffer> m_data;
@@ -95,8 +114,14 @@ private:
     ImageOrientation m_orientation;
     int m_repetitionCount;
     bool m_hasColorProfile;
+    bool m_canDecodeToScale;
+    bool m_canDecodeRegion;
 
     Vector<OwnPtr<ImageFrame> > m_lazyDecodedFrames;
+    // Keyed by scale numerator, so that each scale keeps its generation ID.
+    HashMap<unsigned, SkBitmap> m_scaledBitmaps;
+    // Keyed by the tile coordinates of the region, see regionKey().
+    HashMap<uint64_t, SkBitmap> m_regionBitmaps;
     RefPtr<ImageFrameGenerator> m_frameGenerator;
 
     static bool s_enabled;
@@ -28,9 +28,11 @@
 
 #include "SkBitmapDevice.h"
 #include "SkCanvas.h"
+#include "SkColorPriv.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
 #include "SkSurface.h"
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/SharedBuffer.h"
 #include "platform/Task.h"
 #include "platform/graphics/ImageDecodingStore.h"
@@ -38,6 +40,7 @@
 #include "platform/graphics/test/MockImageDecoder.h"
 #include "public/platform/Platform.h"
 #include "public/platform/WebThread.h"
+#include "public/platform/WebUnitTestSupport.h"
 #include "wtf/PassRefPtr.h"
 #include "wtf/RefPtr.h"
 #include <gtest/gtest.h>
@@ -61,6 +64,13 @@ const unsigned char whitePNG[] = {
     0x42, 0x60, 0x82,
 };
 
+PassRefPtr<SharedBuffer> readFile(const char* fileName)
+{
+    String filePath = Platform::current()->unitTestSupport()->webKitRootDir();
+    filePath.append(fileName);
+    return Platform::current()->unitTestSupport()->readFromFile(filePath);
+}
+
 struct Rasterizer {
     SkCanvas* canvas;
     SkPicture* picture;
@@ -91,6 +101,7 @@ public:
 
     virtual void TearDown() override
     {
+        RuntimeEnabledFeatures::setSoftwareDecodeToYUVEnabled(false);
         ImageDecodingStore::instance()->clear();
     }
 
@@ -330,6 +341,98 @@ TEST_F(DeferredImageDecoderTest, decodedSize)
     EXPECT_EQ(1, m_frameBufferRequestCount);
 }
 
+TEST_F(DeferredImageDecoderTest, scaledBitmapNeedsScalingDecoder)
+{
+    m_lazyDecoder->setData(*m_data, true);
+    ASSERT_TRUE(m_lazyDecoder->frameBufferAtIndex(0));
+    // MockImageDecoder can't decode at a reduced size.
+    EXPECT_TRUE(m_lazyDecoder->scaledBitmap(1).isNull());
+}
+
+TEST_F(DeferredImageDecoderTest, jpegScaledBitmap)
+{
+    RefPtr<SharedBuffer> data = readFile("/LayoutTests/fast/images/resources/lenna.jpg"); // 256x256
+    ASSERT_TRUE(data.get());
+    OwnPtr<DeferredImageDecoder> decoder = DeferredImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    ASSERT_TRUE(decoder);
+    decoder->setData(*data, true);
+    ASSERT_TRUE(decoder->frameBufferAtIndex(0));
+
+    SkBitmap bitmap = decoder->scaledBitmap(2);
+    ASSERT_FALSE(bitmap.isNull());
+    EXPECT_EQ(64, bitmap.width());
+    EXPECT_EQ(64, bitmap.height());
+    // Draws at the same scale share the bitmap, and so Skia's decoded copy.
+    EXPECT_EQ(bitmap.getGenerationID(), decoder->scaledBitmap(2).getGenerationID());
+
+    // Drawing it decodes at a quarter of the size.
+    m_surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+    m_surface->getCanvas()->drawBitmap(bitmap, 0, 0);
+    SkBitmap canvasBitmap;
+    canvasBitmap.allocN32Pixels(100, 100);
+    ASSERT_TRUE(m_surface->getCanvas()->readPixels(&canvasBitmap, 0, 0));
+    SkAutoLockPixels autoLock(canvasBitmap);
+    EXPECT_EQ(255u, SkColorGetA(canvasBitmap.getColor(63, 63)));
+    EXPECT_EQ(0u, SkColorGetA(canvasBitmap.getColor(64, 64)));
+}
+
+TEST_F(DeferredImageDecoderTest, regionBitmapNeedsRegionDecoder)
+{
+    m_lazyDecoder->setData(*m_data, true);
+    ASSERT_TRUE(m_lazyDecoder->frameBufferAtIndex(0));
+    // MockImageDecoder can't decode a region at a time.
+    IntRect region(0, 0, 10, 10);
+    EXPECT_TRUE(m_lazyDecoder->regionBitmap(region).isNull());
+}
+
+TEST_F(DeferredImageDecoderTest, jpegKeptAsYUVPlanes)
+{
+    RuntimeEnabledFeatures::setSoftwareDecodeToYUVEnabled(true);
+    RefPtr<SharedBuffer> data = readFile("/LayoutTests/fast/images/resources/lenna.jpg"); // 256x256, YUV 4:2:0
+    ASSERT_TRUE(data.get());
+    OwnPtr<DeferredImageDecoder> decoder = DeferredImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    ASSERT_TRUE(decoder);
+    decoder->setData(*data, true);
+    ASSERT_TRUE(decoder->frameBufferAtIndex(0));
+    ImageFrameGenerator* generator = decoder->frameGenerator();
+    ASSERT_TRUE(generator);
+
+    // The planes take 1.5 bytes per pixel, decoded pixels would take 4.
+    const size_t decodedPixelBytes = 256 * 256 * 4;
+    EXPECT_TRUE(generator->decodeAhead(0));
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+    EXPECT_GT(decodedPixelBytes / 2, ImageDecodingStore::instance()->memoryUsageInBytes());
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+    SkBitmap converted;
+    converted.allocPixels(info);
+    ASSERT_TRUE(generator->decodeAndScale(info, 0, converted.getPixels(), converted.rowBytes()));
+    // The planes stay around for the next time the image is rasterized.
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+
+    // libjpeg interpolates chroma where the conversion replicates it, so the
+    // pixels are only close to the regular decode's.
+    OwnPtr<ImageDecoder> rgbDecoder = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    ASSERT_TRUE(rgbDecoder);
+    rgbDecoder->setData(data.get(), true);
+    ImageFrame* frame = rgbDecoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    ASSERT_EQ(ImageFrame::FrameComplete, frame->status());
+    unsigned totalDifference = 0;
+    for (int y = 0; y < 256; ++y) {
+        for (int x = 0; x < 256; ++x) {
+            SkPMColor expected = *frame->getAddr(x, y);
+            SkPMColor actual = *converted.getAddr32(x, y);
+            EXPECT_EQ(255u, SkGetPackedA32(actual));
+            totalDifference += abs(static_cast<int>(SkGetPackedR32(expected)) - static_cast<int>(SkGetPackedR32(actual)));
+            totalDifference += abs(static_cast<int>(SkGetPackedG32(expected)) - static_cast<int>(SkGetPackedG32(actual)));
+            totalDifference += abs(static_cast<int>(SkGetPackedB32(expected)) - static_cast<int>(SkGetPackedB32(actual)));
+        }
+    }
+    EXPECT_GT(4u, totalDifference / (256 * 256 * 3));
+}
+
 TEST_F(DeferredImageDecoderTest, smallerFrameCount)
 {
     m_frameCount = 1;
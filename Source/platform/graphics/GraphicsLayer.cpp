@@ -279,12 +279,6 @@ void GraphicsLayer::paintGraphicsLayerContents(GraphicsContext& context, const I
         m_debugInfo.clearAnnotatedInvalidateRects();
     incrementPaintCount();
     m_client->paintContents(this, context, m_paintingPhase, clip);
-#ifndef NDEBUG
-    if (m_displayItemList) {
-        ASSERT(RuntimeEnabledFeatures::slimmingPaintEnabled());
-        context.fillRect(clip, Color(0xFF, 0, 0));
-    }
-#endif
 }
 
 void GraphicsLayer::updateChildList()
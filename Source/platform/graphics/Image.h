@@ -103,6 +103,10 @@ public:
 
     virtual void destroyDecodedData(bool destroyAll) = 0;
 
+    // Hints that the image will be drawn soon. Lazily decoded images then get
+    // decoded on a worker thread ahead of rasterization.
+    virtual void scheduleDecodeAhead(unsigned /*distanceFromViewport*/) { }
+
     SharedBuffer* data() { return m_encodedImageData.get(); }
 
     // Animation begins whenever someone draws the image, so startAnimation() is not normally called.
@@ -0,0 +1,148 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
+
+#include "platform/Task.h"
+#include "platform/TraceEvent.h"
+#include "platform/graphics/ImageFrameGenerator.h"
+#include "public/platform/Platform.h"
+#include "public/platform/WebThread.h"
+#include "wtf/MainThread.h"
+#include "wtf/Threading.h"
+#include <algorithm>
+
+namespace blink {
+
+// Decoding ahead competes with the rasterizer for cores and memory, so keep
+// the pool and the queue small.
+static const size_t maxDecodeThreads = 2;
+static const size_t maxQueuedJobs = 64;
+
+ImageDecodeScheduler* ImageDecodeScheduler::instance()
+{
+    AtomicallyInitializedStatic(ImageDecodeScheduler*, scheduler = new ImageDecodeScheduler);
+    return scheduler;
+}
+
+ImageDecodeScheduler::ImageDecodeScheduler()
+    : m_nextThread(0)
+    , m_pendingJobCount(0)
+{
+}
+
+ImageDecodeScheduler::~ImageDecodeScheduler()
+{
+}
+
+void ImageDecodeScheduler::schedule(PassRefPtr<ImageFrameGenerator> prpGenerator, size_t index, unsigned distanceFromViewport)
+{
+    ASSERT(isMainThread());
+    RefPtr<ImageFrameGenerator> generator = prpGenerator;
+
+    if (m_threads.isEmpty()) {
+        size_t threadCount = std::min(maxDecodeThreads, std::max<size_t>(Platform::current()->numberOfProcessors(), 2) - 1);
+        for (size_t i = 0; i < threadCount; ++i) {
+            WebThread* thread = Platform::current()->createThread("ImageDecodeThread");
+            if (!thread)
+                return;
+            m_threads.append(adoptPtr(thread));
+        }
+    }
+
+    {
+        MutexLocker lock(m_mutex);
+        for (size_t i = 0; i < m_jobs.size(); ++i) {
+            if (m_jobs[i].generator == generator && m_jobs[i].index == index) {
+                m_jobs[i].distanceFromViewport = std::min(m_jobs[i].distanceFromViewport, distanceFromViewport);
+                return;
+            }
+        }
+        if (m_jobs.size() >= maxQueuedJobs)
+            return;
+
+        Job job;
+        job.generator = generator;
+        job.index = index;
+        job.distanceFromViewport = distanceFromViewport;
+        SkISize size = job.generator->getFullSize();
+        job.pixelCount = static_cast<uint64_t>(size.width()) * size.height();
+        m_jobs.append(job);
+        ++m_pendingJobCount;
+    }
+
+    TRACE_EVENT_INSTANT1("blink", "ImageDecodeScheduler::schedule", "distanceFromViewport", distanceFromViewport);
+
+    // Each task runs whichever job is most urgent by the time it starts.
+    WebThread* thread = m_threads[m_nextThread++ % m_threads.size()].get();
+    thread->postTask(new Task(WTF::bind(&ImageDecodeScheduler::runNextJobOnWorker, this)));
+}
+
+void ImageDecodeScheduler::cancel(const ImageFrameGenerator* generator, size_t index)
+{
+    MutexLocker lock(m_mutex);
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+        if (m_jobs[i].generator.get() == generator && m_jobs[i].index == index) {
+            // The task posted for the job finds no job, or runs another one.
+            // Either way it doesn't count this one as done.
+            m_jobs.remove(i);
+            ASSERT(m_pendingJobCount);
+            if (!--m_pendingJobCount)
+                m_idleCondition.broadcast();
+            return;
+        }
+    }
+}
+
+bool ImageDecodeScheduler::takeNextJob(Job& job)
+{
+    MutexLocker lock(m_mutex);
+    if (m_jobs.isEmpty())
+        return false;
+
+    size_t next = 0;
+    for (size_t i = 1; i < m_jobs.size(); ++i) {
+        const Job& candidate = m_jobs[i];
+        if (candidate.distanceFromViewport < m_jobs[next].distanceFromViewport
+            || (candidate.distanceFromViewport == m_jobs[next].distanceFromViewport && candidate.pixelCount < m_jobs[next].pixelCount))
+            next = i;
+    }
+    job = m_jobs[next];
+    m_jobs.remove(next);
+    return true;
+}
+
+void ImageDecodeScheduler::didRunJob()
+{
+    MutexLocker lock(m_mutex);
+    ASSERT(m_pendingJobCount);
+    if (!--m_pendingJobCount)
+        m_idleCondition.broadcast();
+}
+
+void ImageDecodeScheduler::runNextJobOnWorker(ImageDecodeScheduler* scheduler)
+{
+    Job job;
+    if (!scheduler->takeNextJob(job))
+        return;
+
+    {
+        TRACE_EVENT2("blink", "ImageDecodeScheduler::decodeAhead", "generator", job.generator.get(), "distanceFromViewport", job.distanceFromViewport);
+        job.generator->decodeAhead(job.index);
+        // Drop the reference before the job counts as done, the generator
+        // may go away with it.
+        job.generator.clear();
+    }
+    scheduler->didRunJob();
+}
+
+void ImageDecodeScheduler::waitUntilIdle()
+{
+    MutexLocker lock(m_mutex);
+    while (m_pendingJobCount)
+        m_idleCondition.wait(m_mutex);
+}
+
+} // namespace blink
@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ImageDecodeScheduler_h
+#define ImageDecodeScheduler_h
+
+#include "platform/PlatformExport.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/RefPtr.h"
+#include "wtf/ThreadingPrimitives.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+class ImageFrameGenerator;
+class WebThread;
+
+// Decodes lazily decoded images ahead of rasterization on a small pool of
+// worker threads, so that the rasterizer finds their pixels in
+// ImageDecodingStore instead of stalling on the decode. Images closest to the
+// viewport are decoded first, and smaller ones first at the same distance.
+//
+// schedule() must be called on the main thread. Decodes run on the workers.
+class PLATFORM_EXPORT ImageDecodeScheduler {
+    WTF_MAKE_NONCOPYABLE(ImageDecodeScheduler);
+public:
+    static ImageDecodeScheduler* instance();
+
+    ~ImageDecodeScheduler();
+
+    // Queues a decode of frame |index| of |generator|. Does nothing if that
+    // frame is already queued.
+    void schedule(PassRefPtr<ImageFrameGenerator>, size_t index, unsigned distanceFromViewport);
+
+    // Drops the queued decode of frame |index| of |generator|, if any. Can be
+    // called on any thread.
+    void cancel(const ImageFrameGenerator*, size_t index);
+
+    // Blocks until all queued decodes have run. For testing.
+    void waitUntilIdle();
+
+private:
+    ImageDecodeScheduler();
+
+    struct Job {
+        RefPtr<ImageFrameGenerator> generator;
+        size_t index;
+        unsigned distanceFromViewport;
+        uint64_t pixelCount;
+    };
+
+    static void runNextJobOnWorker(ImageDecodeScheduler*);
+    bool takeNextJob(Job&);
+    void didRunJob();
+
+    Vector<OwnPtr<WebThread> > m_threads;
+    size_t m_nextThread;
+
+    // Protects m_jobs and m_pendingJobCount, which includes running jobs.
+    Mutex m_mutex;
+    ThreadCondition m_idleCondition;
+    Vector<Job> m_jobs;
+    unsigned m_pendingJobCount;
+};
+
+} // namespace blink
+
+#endif // ImageDecodeScheduler_h
@@ -50,6 +50,10 @@ ImageDecodingStore::~ImageDecodingStore()
     ASSERT(!m_decoderCacheMap.size());
     ASSERT(!m_orderedCacheList.size());
     ASSERT(!m_decoderCacheKeyMap.size());
+    ASSERT(!m_decodedFrameCacheMap.size());
+    ASSERT(!m_decodedFrameCacheKeyMap.size());
+    ASSERT(!m_yuvPlanesCacheMap.size());
+    ASSERT(!m_yuvPlanesCacheKeyMap.size());
 #endif
 }
 
@@ -125,6 +129,93 @@ void ImageDecodingStore::removeDecoder(const ImageFrameGenerator* generator, con
     }
 }
 
+void ImageDecodingStore::insertDecodedFrame(const ImageFrameGenerator* generator, size_t index, const SkBitmap& bitmap)
+{
+    // Prune old cache entries to give space for the new one.
+    prune();
+
+    OwnPtr<DecodedFrameCacheEntry> newCacheEntry = DecodedFrameCacheEntry::create(generator, index, bitmap);
+
+    MutexLocker lock(m_mutex);
+    if (m_decodedFrameCacheMap.contains(newCacheEntry->cacheKey()))
+        return;
+    insertCacheInternal(newCacheEntry.release(), &m_decodedFrameCacheMap, &m_decodedFrameCacheKeyMap);
+}
+
+bool ImageDecodingStore::takeDecodedFrame(const ImageFrameGenerator* generator, size_t index, SkBitmap* bitmap)
+{
+    ASSERT(bitmap);
+
+    Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
+    {
+        MutexLocker lock(m_mutex);
+        DecodedFrameCacheMap::iterator iter = m_decodedFrameCacheMap.find(DecodedFrameCacheEntry::makeCacheKey(generator, index));
+        if (iter == m_decodedFrameCacheMap.end())
+            return false;
+
+        DecodedFrameCacheEntry* cacheEntry = iter->value.get();
+        *bitmap = cacheEntry->bitmap();
+        removeFromCacheInternal(cacheEntry, &cacheEntriesToDelete);
+        removeFromCacheListInternal(cacheEntriesToDelete);
+    }
+    return true;
+}
+
+bool ImageDecodingStore::hasDecodedFrame(const ImageFrameGenerator* generator, size_t index)
+{
+    MutexLocker lock(m_mutex);
+    return m_decodedFrameCacheMap.contains(DecodedFrameCacheEntry::makeCacheKey(generator, index));
+}
+
+bool ImageDecodingStore::lockYUVPlanes(const ImageFrameGenerator* generator, const DecodedYUVPlanes** planes)
+{
+    ASSERT(planes);
+
+    MutexLocker lock(m_mutex);
+    YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(YUVPlanesCacheEntry::makeCacheKey(generator));
+    if (iter == m_yuvPlanesCacheMap.end())
+        return false;
+
+    YUVPlanesCacheEntry* cacheEntry = iter->value.get();
+    cacheEntry->incrementUseCount();
+    *planes = cacheEntry->planes();
+    return true;
+}
+
+void ImageDecodingStore::unlockYUVPlanes(const ImageFrameGenerator* generator, const DecodedYUVPlanes* planes)
+{
+    MutexLocker lock(m_mutex);
+    YUVPlanesCacheMap::iterator iter = m_yuvPlanesCacheMap.find(YUVPlanesCacheEntry::makeCacheKey(generator));
+    ASSERT_WITH_SECURITY_IMPLICATION(iter != m_yuvPlanesCacheMap.end());
+    ASSERT(iter->value->planes() == planes);
+
+    CacheEntry* cacheEntry = iter->value.get();
+    cacheEntry->decrementUseCount();
+
+    // Put the entry to the end of list.
+    m_orderedCacheList.remove(cacheEntry);
+    m_orderedCacheList.append(cacheEntry);
+}
+
+void ImageDecodingStore::insertYUVPlanes(const ImageFrameGenerator* generator, PassOwnPtr<DecodedYUVPlanes> planes)
+{
+    // Prune old cache entries to give space for the new one.
+    prune();
+
+    OwnPtr<YUVPlanesCacheEntry> newCacheEntry = YUVPlanesCacheEntry::create(generator, planes);
+
+    MutexLocker lock(m_mutex);
+    if (m_yuvPlanesCacheMap.contains(newCacheEntry->cacheKey()))
+        return;
+    insertCacheInternal(newCacheEntry.release(), &m_yuvPlanesCacheMap, &m_yuvPlanesCacheKeyMap);
+}
+
+bool ImageDecodingStore::hasYUVPlanes(const ImageFrameGenerator* generator)
+{
+    MutexLocker lock(m_mutex);
+    return m_yuvPlanesCacheMap.contains(YUVPlanesCacheEntry::makeCacheKey(generator));
+}
+
 void ImageDecodingStore::removeCacheIndexedByGenerator(const ImageFrameGenerator* generator)
 {
     Vector<OwnPtr<CacheEntry> > cacheEntriesToDelete;
@@ -134,6 +225,8 @@ void ImageDecodingStore::removeCacheIndexedByGenerator(const ImageFrameGenerator
         // Remove image cache objects and decoder cache objects associated
         // with a ImageFrameGenerator.
         removeCacheIndexedByGeneratorInternal(&m_decoderCacheMap, &m_decoderCacheKeyMap, generator, &cacheEntriesToDelete);
+        removeCacheIndexedByGeneratorInternal(&m_decodedFrameCacheMap, &m_decodedFrameCacheKeyMap, generator, &cacheEntriesToDelete);
+        removeCacheIndexedByGeneratorInternal(&m_yuvPlanesCacheMap, &m_yuvPlanesCacheKeyMap, generator, &cacheEntriesToDelete);
 
         // Remove from LRU list as well.
         removeFromCacheListInternal(cacheEntriesToDelete);
@@ -166,6 +259,12 @@ void ImageDecodingStore::setCacheLimitInBytes(size_t cacheLimit)
     prune();
 }
 
+size_t ImageDecodingStore::cacheLimitInBytes()
+{
+    MutexLocker lock(m_mutex);
+    return m_heapLimitInBytes;
+}
+
 size_t ImageDecodingStore::memoryUsageInBytes()
 {
     MutexLocker lock(m_mutex);
@@ -175,7 +274,7 @@ size_t ImageDecodingStore::memoryUsageInBytes()
 int ImageDecodingStore::cacheEntries()
 {
     MutexLocker lock(m_mutex);
-    return m_decoderCacheMap.size();
+    return m_decoderCacheMap.size() + m_decodedFrameCacheMap.size() + m_yuvPlanesCacheMap.size();
 }
 
 int ImageDecodingStore::decoderCacheEntries()
@@ -184,6 +283,18 @@ int ImageDecodingStore::decoderCacheEntries()
     return m_decoderCacheMap.size();
 }
 
+int ImageDecodingStore::decodedFrameCacheEntries()
+{
+    MutexLocker lock(m_mutex);
+    return m_decodedFrameCacheMap.size();
+}
+
+int ImageDecodingStore::yuvPlanesCacheEntries()
+{
+    MutexLocker lock(m_mutex);
+    return m_yuvPlanesCacheMap.size();
+}
+
 void ImageDecodingStore::prune()
 {
     TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("blink.image_decoding"), "ImageDecodingStore::prune");
@@ -257,6 +368,10 @@ void ImageDecodingStore::removeFromCacheInternal(const CacheEntry* cacheEntry, V
 {
     if (cacheEntry->type() == CacheEntry::TypeDecoder) {
         removeFromCacheInternal(static_cast<const DecoderCacheEntry*>(cacheEntry), &m_decoderCacheMap, &m_decoderCacheKeyMap, deletionList);
+    } else if (cacheEntry->type() == CacheEntry::TypeDecodedFrame) {
+        removeFromCacheInternal(static_cast<const DecodedFrameCacheEntry*>(cacheEntry), &m_decodedFrameCacheMap, &m_decodedFrameCacheKeyMap, deletionList);
+    } else if (cacheEntry->type() == CacheEntry::TypeYUVPlanes) {
+        removeFromCacheInternal(static_cast<const YUVPlanesCacheEntry*>(cacheEntry), &m_yuvPlanesCacheMap, &m_yuvPlanesCacheKeyMap, deletionList);
     } else {
         ASSERT(false);
     }
@@ -26,9 +26,11 @@
 #ifndef ImageDecodingStore_h
 #define ImageDecodingStore_h
 
+#include "SkBitmap.h"
 #include "SkSize.h"
 #include "SkTypes.h"
 #include "platform/PlatformExport.h"
+#include "platform/graphics/DecodedYUVPlanes.h"
 #include "platform/graphics/skia/SkSizeHash.h"
 #include "platform/image-decoders/ImageDecoder.h"
 
@@ -45,7 +47,9 @@ class ImageFrameGenerator;
 
 // FUNCTION
 //
-// ImageDecodingStore is a class used to manage cached decoder objects.
+// ImageDecodingStore is a class used to manage cached decoder objects, frames
+// decoded ahead of rasterization by ImageDecodeScheduler, and the YUV planes
+// of JPEGs which the software rasterizer converts to pixels as it draws them.
 //
 // EXTERNAL OBJECTS
 //
@@ -75,14 +79,30 @@ public:
     void insertDecoder(const ImageFrameGenerator*, PassOwnPtr<ImageDecoder>);
     void removeDecoder(const ImageFrameGenerator*, const ImageDecoder*);
 
+    // Frames decoded ahead of time. A frame is handed out once, taking it
+    // removes it from the cache.
+    void insertDecodedFrame(const ImageFrameGenerator*, size_t index, const SkBitmap&);
+    bool takeDecodedFrame(const ImageFrameGenerator*, size_t index, SkBitmap*);
+    bool hasDecodedFrame(const ImageFrameGenerator*, size_t index);
+
+    // YUV planes of the first frame at full size. Unlike decoders, planes can
+    // be locked by several users at a time since they're only read.
+    bool lockYUVPlanes(const ImageFrameGenerator*, const DecodedYUVPlanes**);
+    void unlockYUVPlanes(const ImageFrameGenerator*, const DecodedYUVPlanes*);
+    void insertYUVPlanes(const ImageFrameGenerator*, PassOwnPtr<DecodedYUVPlanes>);
+    bool hasYUVPlanes(const ImageFrameGenerator*);
+
     // Remove all cache entries indexed by ImageFrameGenerator.
     void removeCacheIndexedByGenerator(const ImageFrameGenerator*);
 
     void clear();
     void setCacheLimitInBytes(size_t);
+    size_t cacheLimitInBytes();
     size_t memoryUsageInBytes();
     int cacheEntries();
     int decoderCacheEntries();
+    int decodedFrameCacheEntries();
+    int yuvPlanesCacheEntries();
 
 private:
     // Decoder cache entry is identified by:
@@ -90,12 +110,22 @@ private:
     // 2. Size of the image.
     typedef std::pair<const ImageFrameGenerator*, SkISize> DecoderCacheKey;
 
+    // Decoded frame cache entry is identified by:
+    // 1. Pointer to ImageFrameGenerator.
+    // 2. Frame index.
+    typedef std::pair<const ImageFrameGenerator*, size_t> DecodedFrameCacheKey;
+
+    // YUV planes cache entry is identified by the ImageFrameGenerator.
+    typedef const ImageFrameGenerator* YUVPlanesCacheKey;
+
     // Base class for all cache entries.
     class CacheEntry : public DoublyLinkedListNode<CacheEntry> {
         friend class WTF::DoublyLinkedListNode<CacheEntry>;
     public:
         enum CacheType {
             TypeDecoder,
+            TypeDecodedFrame,
+            TypeYUVPlanes,
         };
 
         CacheEntry(const ImageFrameGenerator* generator, int useCount)
@@ -163,6 +193,59 @@ private:
         SkISize m_size;
     };
 
+    class DecodedFrameCacheEntry final : public CacheEntry {
+    public:
+        static PassOwnPtr<DecodedFrameCacheEntry> create(const ImageFrameGenerator* generator, size_t index, const SkBitmap& bitmap)
+        {
+            return adoptPtr(new DecodedFrameCacheEntry(generator, index, bitmap));
+        }
+
+        DecodedFrameCacheEntry(const ImageFrameGenerator* generator, size_t index, const SkBitmap& bitmap)
+            : CacheEntry(generator, 0)
+            , m_index(index)
+            , m_bitmap(bitmap)
+        {
+        }
+
+        virtual size_t memoryUsageInBytes() const override { return m_bitmap.getSize(); }
+        virtual CacheType type() const override { return TypeDecodedFrame; }
+
+        static DecodedFrameCacheKey makeCacheKey(const ImageFrameGenerator* generator, size_t index)
+        {
+            return std::make_pair(generator, index);
+        }
+        DecodedFrameCacheKey cacheKey() const { return makeCacheKey(m_generator, m_index); }
+        const SkBitmap& bitmap() const { return m_bitmap; }
+
+    private:
+        size_t m_index;
+        SkBitmap m_bitmap;
+    };
+
+    class YUVPlanesCacheEntry final : public CacheEntry {
+    public:
+        static PassOwnPtr<YUVPlanesCacheEntry> create(const ImageFrameGenerator* generator, PassOwnPtr<DecodedYUVPlanes> planes)
+        {
+            return adoptPtr(new YUVPlanesCacheEntry(generator, planes));
+        }
+
+        YUVPlanesCacheEntry(const ImageFrameGenerator* generator, PassOwnPtr<DecodedYUVPlanes> planes)
+            : CacheEntry(generator, 0)
+            , m_planes(planes)
+        {
+        }
+
+        virtual size_t memoryUsageInBytes() const override { return m_planes->memoryUsageInBytes(); }
+        virtual CacheType type() const override { return TypeYUVPlanes; }
+
+        static YUVPlanesCacheKey makeCacheKey(const ImageFrameGenerator* generator) { return generator; }
+        YUVPlanesCacheKey cacheKey() const { return m_generator; }
+        const DecodedYUVPlanes* planes() const { return m_planes.get(); }
+
+    private:
+        OwnPtr<DecodedYUVPlanes> m_planes;
+    };
+
     ImageDecodingStore();
 
     void prune();
@@ -201,6 +284,20 @@ private:
     typedef HashMap<const ImageFrameGenerator*, DecoderCacheKeySet> DecoderCacheKeyMap;
     DecoderCacheKeyMap m_decoderCacheKeyMap;
 
+    // Same as above for decoded frames.
+    typedef HashMap<DecodedFrameCacheKey, OwnPtr<DecodedFrameCacheEntry> > DecodedFrameCacheMap;
+    DecodedFrameCacheMap m_decodedFrameCacheMap;
+    typedef HashSet<DecodedFrameCacheKey> DecodedFrameCacheKeySet;
+    typedef HashMap<const ImageFrameGenerator*, DecodedFrameCacheKeySet> DecodedFrameCacheKeyMap;
+    DecodedFrameCacheKeyMap m_decodedFrameCacheKeyMap;
+
+    // Same as above for YUV planes.
+    typedef HashMap<YUVPlanesCacheKey, OwnPtr<YUVPlanesCacheEntry> > YUVPlanesCacheMap;
+    YUVPlanesCacheMap m_yuvPlanesCacheMap;
+    typedef HashSet<YUVPlanesCacheKey> YUVPlanesCacheKeySet;
+    typedef HashMap<const ImageFrameGenerator*, YUVPlanesCacheKeySet> YUVPlanesCacheKeyMap;
+    YUVPlanesCacheKeyMap m_yuvPlanesCacheKeyMap;
+
     size_t m_heapLimitInBytes;
     size_t m_heapMemoryUsageInBytes;
 
@@ -208,6 +305,10 @@ private:
     //   m_orderedCacheList
     //   m_decoderCacheMap and all CacheEntrys stored in it
     //   m_decoderCacheKeyMap
+    //   m_decodedFrameCacheMap and all CacheEntrys stored in it
+    //   m_decodedFrameCacheKeyMap
+    //   m_yuvPlanesCacheMap and all CacheEntrys stored in it
+    //   m_yuvPlanesCacheKeyMap
     //   m_heapLimitInBytes
     //   m_heapMemoryUsageInBytes
     // This mutex also protects calls to underlying skBitmap's
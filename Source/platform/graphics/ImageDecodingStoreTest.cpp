@@ -179,4 +179,35 @@ TEST_F(ImageDecodingStoreTest, removeDecoder)
     EXPECT_FALSE(ImageDecodingStore::instance()->lockDecoder(m_generator.get(), size, &testDecoder));
 }
 
+TEST_F(ImageDecodingStoreTest, yuvPlanesInUseNotEvicted)
+{
+    // A 16x16 4:2:0 image.
+    const SkISize sizes[3] = { SkISize::Make(16, 16), SkISize::Make(8, 8), SkISize::Make(8, 8) };
+    OwnPtr<DecodedYUVPlanes> planes = DecodedYUVPlanes::create(sizes);
+    const DecodedYUVPlanes* refPlanes = planes.get();
+    ImageDecodingStore::instance()->insertYUVPlanes(m_generator.get(), planes.release());
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+    EXPECT_EQ(384u, ImageDecodingStore::instance()->memoryUsageInBytes());
+
+    // Planes can be locked more than once.
+    const DecodedYUVPlanes* testPlanes1;
+    const DecodedYUVPlanes* testPlanes2;
+    EXPECT_TRUE(ImageDecodingStore::instance()->lockYUVPlanes(m_generator.get(), &testPlanes1));
+    EXPECT_TRUE(ImageDecodingStore::instance()->lockYUVPlanes(m_generator.get(), &testPlanes2));
+    EXPECT_EQ(refPlanes, testPlanes1);
+    EXPECT_EQ(refPlanes, testPlanes2);
+
+    evictOneCache();
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+
+    ImageDecodingStore::instance()->unlockYUVPlanes(m_generator.get(), testPlanes1);
+    evictOneCache();
+    EXPECT_EQ(1, ImageDecodingStore::instance()->yuvPlanesCacheEntries());
+
+    ImageDecodingStore::instance()->unlockYUVPlanes(m_generator.get(), testPlanes2);
+    evictOneCache();
+    EXPECT_FALSE(ImageDecodingStore::instance()->cacheEntries());
+    EXPECT_FALSE(ImageDecodingStore::instance()->hasYUVPlanes(m_generator.get()));
+}
+
 } // namespace
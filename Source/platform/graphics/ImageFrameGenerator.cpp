@@ -27,13 +27,21 @@
 
 #include "platform/graphics/ImageFrameGenerator.h"
 
+#include "platform/RuntimeEnabledFeatures.h"
 #include "platform/SharedBuffer.h"
 #include "platform/TraceEvent.h"
+#include "platform/graphics/DecodedYUVPlanes.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
 #include "platform/graphics/ImageDecodingStore.h"
 #include "platform/image-decoders/ImageDecoder.h"
+#include "skia/ext/image_operations.h"
 
 namespace blink {
 
+// Animation frames are only decoded ahead if they take at most this fraction
+// of ImageDecodingStore's cache.
+static const size_t maxDecodedAheadFrameFraction = 4;
+
 // Creates a SkPixelRef such that the memory for pixels is given by an external body.
 // This is used to write directly to the memory given by Skia during decoding.
 class ImageFrameGenerator::ExternalMemoryAllocator : public SkBitmap::Allocator {
@@ -82,12 +90,42 @@ static bool updateYUVComponentSizes(ImageDecoder* decoder, SkISize componentSize
     return true;
 }
 
+// Returns the numerator of the decoder scale that turns |fullSize| into
+// |scaledSize|, or 0 if no decoder scale does.
+static unsigned scaleNumeratorForSize(const SkISize& fullSize, const SkISize& scaledSize)
+{
+    for (unsigned scaleNumerator = ImageDecoder::scaleDenominator; scaleNumerator; scaleNumerator /= 2) {
+        IntSize size = ImageDecoder::scaledSize(IntSize(fullSize.width(), fullSize.height()), scaleNumerator);
+        if (size.width() == scaledSize.width() && size.height() == scaledSize.height())
+            return scaleNumerator;
+    }
+    return 0;
+}
+
+// Returns the smallest size a decoder scale turns |fullSize| into that still
+// covers |scaledSize|.
+static SkISize decodedSizeForScaledSize(const SkISize& fullSize, const SkISize& scaledSize)
+{
+    SkISize decodedSize = fullSize;
+    for (unsigned scaleNumerator = ImageDecoder::scaleDenominator / 2; scaleNumerator; scaleNumerator /= 2) {
+        IntSize size = ImageDecoder::scaledSize(IntSize(fullSize.width(), fullSize.height()), scaleNumerator);
+        if (size.width() < scaledSize.width() || size.height() < scaledSize.height())
+            break;
+        decodedSize.set(size.width(), size.height());
+    }
+    return decodedSize;
+}
+
 ImageFrameGenerator::ImageFrameGenerator(const SkISize& fullSize, PassRefPtr<SharedBuffer> data, bool allDataReceived, bool isMultiFrame)
     : m_fullSize(fullSize)
     , m_isMultiFrame(isMultiFrame)
     , m_decodeFailedAndEmpty(false)
+    , m_yuvPlanesUnsupported(false)
+    , m_scaledDecodeUnsupported(false)
     , m_decodeCount(0)
     , m_frameCount(0)
+    , m_animationStallCount(0)
+    , m_rasterizerHasFullFrame(false)
 {
     setData(data.get(), allDataReceived);
 }
@@ -117,24 +155,86 @@ bool ImageFrameGenerator::decodeAndScale(const SkImageInfo& info, size_t index,
     // Prevents concurrent decode or scale operations on the same image data.
     MutexLocker lock(m_decodeMutex);
 
-    // This implementation does not support scaling so check the requested size.
     SkISize scaledSize = SkISize::Make(info.width(), info.height());
-    ASSERT(m_fullSize == scaledSize);
+    if (scaledSize.isEmpty() || scaledSize.width() > m_fullSize.width() || scaledSize.height() > m_fullSize.height())
+        return false;
 
     if (m_decodeFailedAndEmpty)
         return false;
 
     TRACE_EVENT2("blink", "ImageFrameGenerator::decodeAndScale", "generator", this, "decodeCount", m_decodeCount);
 
-    m_externalAllocator = adoptPtr(new ExternalMemoryAllocator(info, pixels, rowBytes));
+    // Frames decoded ahead are always full size.
+    SkBitmap decodedFrame;
+    if (scaledSize == m_fullSize && ImageDecodingStore::instance()->takeDecodedFrame(this, index, &decodedFrame)) {
+        SkAutoLockPixels lockPixels(decodedFrame);
+        // Opaque pixels are also valid premultiplied ones.
+        bool compatible = decodedFrame.width() == info.width() && decodedFrame.height() == info.height() && decodedFrame.colorType() == info.colorType();
+        if (compatible && decodedFrame.copyPixelsTo(pixels, rowBytes * info.height(), rowBytes)) {
+            TRACE_EVENT_INSTANT1("blink", "ImageFrameGenerator::usedDecodedAheadFrame", "generator", this);
+            m_rasterizerHasFullFrame = !m_isMultiFrame;
+            return true;
+        }
+    } else if (m_isMultiFrame && index && m_frameCount) {
+        // Once all data is received, which is when m_frameCount is known,
+        // animation frames after the first are decoded ahead while the
+        // previous frame is shown. The rasterizer decoding one itself means
+        // the animation may miss its frame time.
+        ++m_animationStallCount;
+        TRACE_EVENT_INSTANT2("blink", "ImageFrameGenerator::animationStall", "generator", this, "index", static_cast<int>(index));
+    }
 
-    SkBitmap bitmap = tryToResumeDecode(scaledSize, index);
-    if (bitmap.isNull())
+    // The rasterizer produces the frame itself from here on, so a decode
+    // ahead of it that is still queued would only duplicate the work.
+    ImageDecodeScheduler::instance()->cancel(this, index);
+    if (scaledSize == m_fullSize && !m_isMultiFrame) {
+        SharedBuffer* data = 0;
+        bool allDataReceived = false;
+        m_data.data(&data, &allDataReceived);
+        m_rasterizerHasFullFrame = allDataReceived;
+    }
+
+    if (scaledSize == m_fullSize && !index && info.colorType() == kN32_SkColorType
+        && convertYUVPlanes(SkIRect::MakeSize(m_fullSize), pixels, rowBytes, true))
+        return true;
+
+    // The rasterizer asks for the frame at the size it is drawn at, so the
+    // decode size is picked here: the smallest decoder scale that covers the
+    // request, see ImageDecoder::setTargetScaleNumerator(). The rest of the
+    // way is resampled. Decoders which can't scale only decode at full size.
+    SkISize decodedSize = m_scaledDecodeUnsupported ? m_fullSize : decodedSizeForScaledSize(m_fullSize, scaledSize);
+    if (decodedSize == scaledSize) {
+        if (decodeToPixels(info, index, pixels, rowBytes))
+            return true;
+        // decode() gives up on decoders which can't scale before decoding.
+        if (scaledSize == m_fullSize || !m_scaledDecodeUnsupported)
+            return false;
+        decodedSize = m_fullSize;
+    }
+
+    SkBitmap decodedBitmap;
+    if (!decodedBitmap.tryAllocPixels(SkImageInfo::Make(decodedSize.width(), decodedSize.height(), info.colorType(), info.alphaType())))
         return false;
+    if (!decodeToPixels(decodedBitmap.info(), index, decodedBitmap.getPixels(), decodedBitmap.rowBytes()))
+        return false;
+
+    TRACE_EVENT2("blink", "ImageFrameGenerator::resample", "width", scaledSize.width(), "height", scaledSize.height());
+    SkBitmap resizedBitmap = skia::ImageOperations::Resize(decodedBitmap, skia::ImageOperations::RESIZE_GOOD, scaledSize.width(), scaledSize.height());
+    SkAutoLockPixels lockPixels(resizedBitmap);
+    return resizedBitmap.copyPixelsTo(pixels, rowBytes * info.height(), rowBytes);
+}
+
+bool ImageFrameGenerator::decodeToPixels(const SkImageInfo& info, size_t index, void* pixels, size_t rowBytes)
+{
+    SkISize scaledSize = SkISize::Make(info.width(), info.height());
+    m_externalAllocator = adoptPtr(new ExternalMemoryAllocator(info, pixels, rowBytes));
+    SkBitmap bitmap = tryToResumeDecode(scaledSize, index);
 
     // Don't keep the allocator because it contains a pointer to memory
     // that we do not own.
     m_externalAllocator.clear();
+    if (bitmap.isNull())
+        return false;
 
     ASSERT(bitmap.width() == scaledSize.width());
     ASSERT(bitmap.height() == scaledSize.height());
@@ -147,6 +247,220 @@ bool ImageFrameGenerator::decodeAndScale(const SkImageInfo& info, size_t index,
     return result;
 }
 
+bool ImageFrameGenerator::decodeRegion(const SkImageInfo& info, const SkIRect& region, size_t index, void* pixels, size_t rowBytes)
+{
+    // Prevents concurrent decode or scale operations on the same image data.
+    MutexLocker lock(m_decodeMutex);
+
+    if (m_decodeFailedAndEmpty || m_isMultiFrame)
+        return false;
+    if (info.width() != region.width() || info.height() != region.height() || !SkIRect::MakeSize(m_fullSize).contains(region))
+        return false;
+
+    SharedBuffer* data = 0;
+    bool allDataReceived = false;
+    m_data.data(&data, &allDataReceived);
+    if (!allDataReceived)
+        return false;
+
+    TRACE_EVENT2("blink", "ImageFrameGenerator::decodeRegion", "width", region.width(), "height", region.height());
+
+    // Regions are only decoded for images too large to decode as a whole,
+    // but if their planes are around, converting is much cheaper.
+    if (!index && info.colorType() == kN32_SkColorType && convertYUVPlanes(region, pixels, rowBytes, false))
+        return true;
+
+    OwnPtr<ImageDecoder> decoder;
+    if (m_imageDecoderFactory)
+        decoder = m_imageDecoderFactory->create();
+    if (!decoder)
+        decoder = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    if (!decoder)
+        return false;
+
+    ExternalMemoryAllocator allocator(info, pixels, rowBytes);
+    decoder->setDecodeRegion(IntRect(region.x(), region.y(), region.width(), region.height()));
+    decoder->setMemoryAllocator(&allocator);
+    decoder->setData(data, allDataReceived);
+    ImageFrame* frame = decoder->frameBufferAtIndex(index);
+    decoder->setMemoryAllocator(0);
+    if (!frame || frame->status() != ImageFrame::FrameComplete)
+        return false;
+
+    // Decoders which can't decode regions produce the whole frame.
+    SkBitmap bitmap = frame->getSkBitmap();
+    if (bitmap.width() != region.width() || bitmap.height() != region.height())
+        return false;
+
+    if (bitmap.getPixels() != pixels)
+        return bitmap.copyPixelsTo(pixels, rowBytes * info.height(), rowBytes);
+    return true;
+}
+
+bool ImageFrameGenerator::decodeAhead(size_t index)
+{
+    // Never make the rasterizer wait for a decode it could do itself.
+    MutexTryLocker lock(m_decodeMutex);
+    if (!lock.locked())
+        return false;
+
+    if (m_decodeFailedAndEmpty || m_rasterizerHasFullFrame)
+        return false;
+
+    if (ImageDecodingStore::instance()->hasDecodedFrame(this, index))
+        return true;
+    if (!index && ImageDecodingStore::instance()->hasYUVPlanes(this))
+        return true;
+
+    SharedBuffer* data = 0;
+    bool allDataReceived = false;
+    m_data.data(&data, &allDataReceived);
+    if (!allDataReceived)
+        return false;
+
+    TRACE_EVENT2("blink", "ImageFrameGenerator::decodeAhead", "width", m_fullSize.width(), "height", m_fullSize.height());
+
+    if (m_isMultiFrame)
+        return decodeAnimationFrameAhead(index);
+
+    // YUV planes take less than half the memory of decoded pixels.
+    if (!index) {
+        OwnPtr<DecodedYUVPlanes> planes = decodeToYUVPlanes();
+        if (planes) {
+            ImageDecodingStore::instance()->insertYUVPlanes(this, planes.release());
+            return true;
+        }
+    }
+
+    OwnPtr<ImageDecoder> decoder;
+    if (m_imageDecoderFactory)
+        decoder = m_imageDecoderFactory->create();
+    if (!decoder)
+        decoder = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    if (!decoder)
+        return false;
+
+    decoder->setData(data, allDataReceived);
+    ImageFrame* frame = decoder->frameBufferAtIndex(index);
+    if (!frame || frame->status() != ImageFrame::FrameComplete)
+        return false;
+
+    SkBitmap bitmap = frame->getSkBitmap();
+    if (bitmap.isNull() || bitmap.width() != m_fullSize.width() || bitmap.height() != m_fullSize.height())
+        return false;
+
+    setHasAlpha(index, !bitmap.isOpaque());
+    // The bitmap keeps the frame's pixels alive after the decoder is gone.
+    ImageDecodingStore::instance()->insertDecodedFrame(this, index, bitmap);
+    return true;
+}
+
+bool ImageFrameGenerator::needsDecodeAhead(size_t index)
+{
+    MutexTryLocker lock(m_decodeMutex);
+    if (!lock.locked())
+        return false;
+
+    if (m_decodeFailedAndEmpty || m_rasterizerHasFullFrame)
+        return false;
+    if (!index && ImageDecodingStore::instance()->hasYUVPlanes(this))
+        return false;
+    return !ImageDecodingStore::instance()->hasDecodedFrame(this, index);
+}
+
+bool ImageFrameGenerator::decodeAnimationFrameAhead(size_t index)
+{
+    // Keep one animation from evicting everything else in the store.
+    uint64_t frameBytes = static_cast<uint64_t>(m_fullSize.width()) * m_fullSize.height() * sizeof(ImageFrame::PixelData);
+    if (frameBytes > ImageDecodingStore::instance()->cacheLimitInBytes() / maxDecodedAheadFrameFraction)
+        return false;
+
+    // Continues with the decoder kept for the animation, which usually holds
+    // the frame this one depends on, if any.
+    SkBitmap bitmap = tryToResumeDecode(m_fullSize, index);
+    if (bitmap.isNull() || index >= m_frameComplete.size() || !m_frameComplete[index])
+        return false;
+
+    // The decoder allocates a new frame buffer for every frame, so the
+    // bitmap's pixels don't change once it's complete.
+    ImageDecodingStore::instance()->insertDecodedFrame(this, index, bitmap);
+    return true;
+}
+
+PassOwnPtr<DecodedYUVPlanes> ImageFrameGenerator::decodeToYUVPlanes()
+{
+    if (m_yuvPlanesUnsupported || m_isMultiFrame || !RuntimeEnabledFeatures::softwareDecodeToYUVEnabled())
+        return nullptr;
+
+    SharedBuffer* data = 0;
+    bool allDataReceived = false;
+    m_data.data(&data, &allDataReceived);
+
+    // FIXME: YUV decoding does not currently support progressive decoding.
+    if (!allDataReceived)
+        return nullptr;
+
+    TRACE_EVENT2("blink", "ImageFrameGenerator::decodeToYUVPlanes", "width", m_fullSize.width(), "height", m_fullSize.height());
+
+    OwnPtr<ImageDecoder> decoder = ImageDecoder::create(*data, ImageSource::AlphaPremultiplied, ImageSource::GammaAndColorProfileApplied);
+    if (!decoder) {
+        m_yuvPlanesUnsupported = true;
+        return nullptr;
+    }
+
+    // Setting a dummy ImagePlanes object signals to the decoder that we want
+    // to do YUV decoding; the real planes can only be allocated once the
+    // header tells their sizes.
+    decoder->setData(data, allDataReceived);
+    decoder->setImagePlanes(adoptPtr(new ImagePlanes));
+    SkISize componentSizes[3];
+    if (!updateYUVComponentSizes(decoder.get(), componentSizes, ImageDecoder::SizeForMemoryAllocation)) {
+        m_yuvPlanesUnsupported = true;
+        return nullptr;
+    }
+
+    OwnPtr<DecodedYUVPlanes> planes = DecodedYUVPlanes::create(componentSizes);
+    decoder->setImagePlanes(planes->imagePlanes());
+    updateYUVComponentSizes(decoder.get(), componentSizes, ImageDecoder::ActualSize);
+    // Planes are only ever decoded at full size.
+    if (componentSizes[0] != m_fullSize) {
+        m_yuvPlanesUnsupported = true;
+        return nullptr;
+    }
+    planes->setComponentSizes(componentSizes);
+
+    if (!decoder->decodeToYUV()) {
+        // Leave the failure to the regular decode.
+        m_yuvPlanesUnsupported = true;
+        return nullptr;
+    }
+    setHasAlpha(0, false); // YUV is always opaque
+    return planes.release();
+}
+
+bool ImageFrameGenerator::convertYUVPlanes(const SkIRect& region, void* pixels, size_t rowBytes, bool decodeIfNeeded)
+{
+    if (m_yuvPlanesUnsupported || m_isMultiFrame || !RuntimeEnabledFeatures::softwareDecodeToYUVEnabled())
+        return false;
+
+    const DecodedYUVPlanes* planes = 0;
+    if (ImageDecodingStore::instance()->lockYUVPlanes(this, &planes)) {
+        TRACE_EVENT2("blink", "ImageFrameGenerator::convertYUVPlanes", "width", region.width(), "height", region.height());
+        planes->convertToRGB(region, pixels, rowBytes);
+        ImageDecodingStore::instance()->unlockYUVPlanes(this, planes);
+        return true;
+    }
+    if (!decodeIfNeeded)
+        return false;
+
+    OwnPtr<DecodedYUVPlanes> newPlanes = decodeToYUVPlanes();
+    if (!newPlanes)
+        return false;
+    newPlanes->convertToRGB(region, pixels, rowBytes);
+    ImageDecodingStore::instance()->insertYUVPlanes(this, newPlanes.release());
+    return true;
+}
+
 bool ImageFrameGenerator::decodeToYUV(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3])
 {
     // This method is called to populate a discardable memory owned by Skia.
@@ -194,11 +508,11 @@ SkBitmap ImageFrameGenerator::tryToResumeDecode(const SkISize& scaledSize, size_
     TRACE_EVENT1("blink", "ImageFrameGenerator::tryToResumeDecodeAndScale", "index", static_cast<int>(index));
 
     ImageDecoder* decoder = 0;
-    const bool resumeDecoding = ImageDecodingStore::instance()->lockDecoder(this, m_fullSize, &decoder);
+    const bool resumeDecoding = ImageDecodingStore::instance()->lockDecoder(this, scaledSize, &decoder);
     ASSERT(!resumeDecoding || decoder);
 
     SkBitmap fullSizeImage;
-    bool complete = decode(index, &decoder, &fullSizeImage);
+    bool complete = decode(index, scaledSize, &decoder, &fullSizeImage);
 
     if (!decoder)
         return SkBitmap();
@@ -264,9 +578,9 @@ void ImageFrameGenerator::setHasAlpha(size_t index, bool hasAlpha)
     m_hasAlpha[index] = hasAlpha;
 }
 
-bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap* bitmap)
+bool ImageFrameGenerator::decode(size_t index, const SkISize& scaledSize, ImageDecoder** decoder, SkBitmap* bitmap)
 {
-    TRACE_EVENT2("blink", "ImageFrameGenerator::decode", "width", m_fullSize.width(), "height", m_fullSize.height());
+    TRACE_EVENT2("blink", "ImageFrameGenerator::decode", "width", scaledSize.width(), "height", scaledSize.height());
 
     ASSERT(decoder);
     SharedBuffer* data = 0;
@@ -285,6 +599,9 @@ bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap*
 
         if (!*decoder)
             return false;
+
+        if (scaledSize != m_fullSize)
+            (*decoder)->setTargetScaleNumerator(scaleNumeratorForSize(m_fullSize, scaledSize));
     }
 
     if (!m_isMultiFrame && newDecoder && allDataReceived) {
@@ -295,6 +612,15 @@ bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap*
     }
     (*decoder)->setData(data, allDataReceived);
 
+    // Leave it to the caller to decode at full size rather than have a
+    // decoder which can't scale decode the whole frame only to drop it.
+    if (newDecoder && scaledSize != m_fullSize && (!(*decoder)->isSizeAvailable() || !(*decoder)->canDecodeToScale())) {
+        m_scaledDecodeUnsupported = (*decoder)->isSizeAvailable();
+        (*decoder)->setData(0, false);
+        (*decoder)->setMemoryAllocator(0);
+        return false;
+    }
+
     ImageFrame* frame = (*decoder)->frameBufferAtIndex(index);
     // For multi-frame image decoders, we need to know how many frames are
     // in that image in order to release the decoder when all frames are
@@ -317,7 +643,12 @@ bool ImageFrameGenerator::decode(size_t index, ImageDecoder** decoder, SkBitmap*
     SkBitmap fullSizeBitmap = frame->getSkBitmap();
     if (!fullSizeBitmap.isNull())
     {
-        ASSERT(fullSizeBitmap.width() == m_fullSize.width() && fullSizeBitmap.height() == m_fullSize.height());
+        // Decoders which can't scale keep decoding at full size.
+        if (fullSizeBitmap.width() != scaledSize.width() || fullSizeBitmap.height() != scaledSize.height()) {
+            ASSERT(scaledSize != m_fullSize);
+            *bitmap = SkBitmap();
+            return false;
+        }
         setHasAlpha(index, !fullSizeBitmap.isOpaque());
     }
     *bitmap = fullSizeBitmap;
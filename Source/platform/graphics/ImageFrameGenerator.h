@@ -41,6 +41,7 @@
 
 namespace blink {
 
+class DecodedYUVPlanes;
 class ImageDecoder;
 class SharedBuffer;
 
@@ -65,11 +66,36 @@ public:
 
     // Decodes and scales the specified frame indicated by |index|. Dimensions
     // and output format are specified in |info|. Decoded pixels are written
-    // into |pixels| with a stride of |rowBytes|.
+    // into |pixels| with a stride of |rowBytes|. Sizes smaller than the full
+    // size are decoded at the nearest larger decoder scale and resampled.
+    //
+    // With SoftwareDecodeToYUV enabled, JPEGs are decoded to YUV planes which
+    // are kept in ImageDecodingStore, and later calls only convert them.
     //
     // Returns true if decoding was successful.
     bool decodeAndScale(const SkImageInfo&, size_t index, void* pixels, size_t rowBytes);
 
+    // Decodes only |region| of frame |index|, which |info| has the size of,
+    // for images too large to decode as a whole. Region decodes always start
+    // from the encoded data; the decoded region itself is cached by Skia
+    // like any other frame. Returns false until all data is received.
+    bool decodeRegion(const SkImageInfo&, const SkIRect& region, size_t index, void* pixels, size_t rowBytes);
+
+    // Decodes frame |index| into ImageDecodingStore ahead of decodeAndScale(),
+    // which then only copies the pixels. Called on ImageDecodeScheduler
+    // threads. Returns false if the frame wasn't decoded, e.g. because the
+    // data is incomplete or another decode of this image is in progress.
+    // Animation frames continue from the decoder the animation keeps in
+    // ImageDecodingStore, which has the frames they depend on. JPEGs are
+    // decoded to YUV planes instead of pixels if possible.
+    bool decodeAhead(size_t index);
+
+    // Whether decoding frame |index| ahead would save the rasterizer a
+    // decode. It wouldn't if the frame is decoded ahead already, if a decode
+    // of this image is running, or if the rasterizer has already had the
+    // whole frame of a still image, which Skia then keeps.
+    bool needsDecodeAhead(size_t index);
+
     // Decodes YUV components directly into the provided memory planes.
     bool decodeToYUV(SkISize componentSizes[3], void* planes[3], size_t rowBytes[3]);
 
@@ -82,6 +108,14 @@ public:
 
     bool isMultiFrame() const { return m_isMultiFrame; }
 
+    // The number of animation frames after the first which the rasterizer
+    // had to decode itself because they weren't decoded ahead.
+    size_t animationStallCount()
+    {
+        MutexLocker lock(m_decodeMutex);
+        return m_animationStallCount;
+    }
+
     // FIXME: Return alpha state for each frame.
     bool hasAlpha(size_t);
 
@@ -98,19 +132,32 @@ private:
 
     // These methods are called while m_decodeMutex is locked.
     SkBitmap tryToResumeDecode(const SkISize& scaledSize, size_t index);
+    // Decodes to exactly the size of |info|, which has to be a decoder scale.
+    bool decodeToPixels(const SkImageInfo&, size_t index, void* pixels, size_t rowBytes);
+    bool decodeAnimationFrameAhead(size_t index);
+    PassOwnPtr<DecodedYUVPlanes> decodeToYUVPlanes();
+
+    // Converts |region| of the YUV planes in ImageDecodingStore. If there
+    // are none and |decodeIfNeeded| is set, decodes them first. Returns false
+    // if the image can't be decoded to YUV planes.
+    bool convertYUVPlanes(const SkIRect& region, void* pixels, size_t rowBytes, bool decodeIfNeeded);
 
-    // Use the given decoder to decode. If a decoder is not given then try to create one.
-    // Returns true if decoding was complete.
-    bool decode(size_t index, ImageDecoder**, SkBitmap*);
+    // Use the given decoder to decode. If a decoder is not given then try to create one
+    // that decodes to |scaledSize|. Returns true if decoding was complete.
+    bool decode(size_t index, const SkISize& scaledSize, ImageDecoder**, SkBitmap*);
 
     SkISize m_fullSize;
     ThreadSafeDataTransport m_data;
     bool m_isMultiFrame;
     bool m_decodeFailedAndEmpty;
+    bool m_yuvPlanesUnsupported;
+    bool m_scaledDecodeUnsupported;
     Vector<bool> m_hasAlpha;
     int m_decodeCount;
     Vector<bool> m_frameComplete;
     size_t m_frameCount;
+    size_t m_animationStallCount;
+    bool m_rasterizerHasFullFrame;
     OwnPtr<ExternalMemoryAllocator> m_externalAllocator;
 
     OwnPtr<ImageDecoderFactory> m_imageDecoderFactory;
@@ -28,6 +28,7 @@
 
 #include "platform/SharedBuffer.h"
 #include "platform/Task.h"
+#include "platform/graphics/ImageDecodeScheduler.h"
 #include "platform/graphics/ImageDecodingStore.h"
 #include "platform/graphics/test/MockImageDecoder.h"
 #include "public/platform/Platform.h"
@@ -230,4 +231,170 @@ TEST_F(ImageFrameGeneratorTest, removeMultiFrameDecoder)
     EXPECT_EQ(1, m_decodersDestroyed);
 }
 
+TEST_F(ImageFrameGeneratorTest, decodeAhead)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+
+    EXPECT_TRUE(m_generator->decodeAhead(0));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(1, m_decodersDestroyed);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+
+    // The rasterizer copies the decoded pixels instead of decoding.
+    char buffer[100 * 100 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+
+    // The decoded frame is handed out only once.
+    m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4);
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeAheadNeedsAllData)
+{
+    setFrameStatus(ImageFrame::FramePartial);
+
+    EXPECT_FALSE(m_generator->decodeAhead(0));
+    EXPECT_EQ(0, m_frameBufferRequestCount);
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeAheadOnScheduler)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+
+    ImageDecodeScheduler::instance()->schedule(m_generator, 0, 0);
+    ImageDecodeScheduler::instance()->waitUntilIdle();
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+
+    // Decoding on the raster path doesn't stall on the decoder.
+    char buffer[100 * 100 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+}
+
+TEST_F(ImageFrameGeneratorTest, rasterDecodeCancelsDecodeAhead)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+
+    // However the decode ahead and the raster decode interleave, the frame
+    // is decoded once and nothing is left behind in the store.
+    ImageDecodeScheduler::instance()->schedule(m_generator, 0, 0);
+    char buffer[100 * 100 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4));
+    ImageDecodeScheduler::instance()->waitUntilIdle();
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+}
+
+TEST_F(ImageFrameGeneratorTest, needsDecodeAhead)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+    EXPECT_TRUE(m_generator->needsDecodeAhead(0));
+
+    EXPECT_TRUE(m_generator->decodeAhead(0));
+    EXPECT_FALSE(m_generator->needsDecodeAhead(0));
+
+    // Skia keeps the frame once the rasterizer has had all of it.
+    char buffer[100 * 100 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4));
+    EXPECT_EQ(0, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+    EXPECT_FALSE(m_generator->needsDecodeAhead(0));
+    EXPECT_FALSE(m_generator->decodeAhead(0));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+}
+
+TEST_F(ImageFrameGeneratorTest, needsDecodeAheadAfterPartialRasterDecode)
+{
+    setFrameStatus(ImageFrame::FramePartial);
+    char buffer[100 * 100 * 4];
+    m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4);
+
+    // The rasterizer only had part of the frame.
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+    EXPECT_TRUE(m_generator->needsDecodeAhead(0));
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeAheadAnimationFrame)
+{
+    setFrameCount(3);
+    setFrameStatus(ImageFrame::FrameComplete);
+
+    EXPECT_TRUE(m_generator->decodeAhead(1));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+    // The animation keeps its decoder for the next frames.
+    EXPECT_EQ(0, m_decodersDestroyed);
+
+    char buffer[100 * 100 * 4];
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 1, buffer, 100 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+    EXPECT_EQ(0u, m_generator->animationStallCount());
+
+    // A frame that wasn't decoded ahead stalls the animation.
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 2, buffer, 100 * 4));
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+    EXPECT_EQ(1u, m_generator->animationStallCount());
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeAheadSkipsLargeAnimationFrames)
+{
+    setFrameCount(3);
+    setFrameStatus(ImageFrame::FrameComplete);
+
+    // Frames have to fit in a quarter of the cache.
+    ImageDecodingStore::instance()->setCacheLimitInBytes(4 * 100 * 100 * 4 - 4);
+    EXPECT_FALSE(m_generator->decodeAhead(1));
+    EXPECT_EQ(0, m_frameBufferRequestCount);
+
+    ImageDecodingStore::instance()->setCacheLimitInBytes(4 * 100 * 100 * 4);
+    EXPECT_TRUE(m_generator->decodeAhead(1));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeToScale)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+
+    // Sizes larger than the image are not supported.
+    char buffer[100 * 100 * 4];
+    SkImageInfo info = SkImageInfo::Make(100, 120, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    EXPECT_FALSE(m_generator->decodeAndScale(info, 0, buffer, 100 * 4));
+    EXPECT_EQ(0, m_frameBufferRequestCount);
+
+    // The mock decoder can't scale, which is found out before it decodes
+    // anything, so 1/2 scale takes a single full size decode and a resample.
+    info = SkImageInfo::Make(50, 50, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    EXPECT_TRUE(m_generator->decodeAndScale(info, 0, buffer, 50 * 4));
+    EXPECT_EQ(1, m_frameBufferRequestCount);
+
+    // Later scaled requests go straight to the full size decode.
+    info = SkImageInfo::Make(30, 30, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    EXPECT_TRUE(m_generator->decodeAndScale(info, 0, buffer, 30 * 4));
+    EXPECT_EQ(2, m_frameBufferRequestCount);
+
+    // Full size decodes are unaffected.
+    EXPECT_TRUE(m_generator->decodeAndScale(imageInfo(), 0, buffer, 100 * 4));
+    EXPECT_EQ(3, m_frameBufferRequestCount);
+}
+
+TEST_F(ImageFrameGeneratorTest, decodeToScaleKeepsDecodedAheadFrame)
+{
+    setFrameStatus(ImageFrame::FrameComplete);
+    m_generator->setData(m_data, true);
+    EXPECT_TRUE(m_generator->decodeAhead(0));
+
+    char buffer[100 * 100 * 4];
+    SkImageInfo info = SkImageInfo::Make(50, 50, kBGRA_8888_SkColorType, kOpaque_SkAlphaType);
+    m_generator->decodeAndScale(info, 0, buffer, 50 * 4);
+    EXPECT_EQ(1, ImageDecodingStore::instance()->decodedFrameCacheEntries());
+}
+
 } // namespace blink
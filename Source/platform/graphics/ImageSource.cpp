@@ -29,6 +29,7 @@
 #include "platform/graphics/ImageSource.h"
 
 #include "platform/graphics/DeferredImageDecoder.h"
+#include "platform/graphics/skia/NativeImageSkia.h"
 #include "platform/image-decoders/ImageDecoder.h"
 
 namespace blink {
@@ -135,6 +136,28 @@ PassRefPtr<NativeImageSkia> ImageSource::createFrameAtIndex(size_t index)
     return buffer->asNewNativeImage();
 }
 
+PassRefPtr<NativeImageSkia> ImageSource::createFrameAtScale(unsigned scaleNumerator)
+{
+    if (!m_decoder)
+        return nullptr;
+
+    SkBitmap bitmap = m_decoder->scaledBitmap(scaleNumerator);
+    if (bitmap.isNull())
+        return nullptr;
+    return NativeImageSkia::create(bitmap);
+}
+
+PassRefPtr<NativeImageSkia> ImageSource::createFrameForRegion(IntRect& region)
+{
+    if (!m_decoder)
+        return nullptr;
+
+    SkBitmap bitmap = m_decoder->regionBitmap(region);
+    if (bitmap.isNull())
+        return nullptr;
+    return NativeImageSkia::create(bitmap);
+}
+
 float ImageSource::frameDurationAtIndex(size_t index) const
 {
     if (!m_decoder)
@@ -170,4 +193,16 @@ unsigned ImageSource::frameBytesAtIndex(size_t index) const
     return m_decoder ? m_decoder->frameBytesAtIndex(index) : 0;
 }
 
+void ImageSource::scheduleDecodeAhead(unsigned distanceFromViewport)
+{
+    if (m_decoder)
+        m_decoder->scheduleDecodeAhead(distanceFromViewport);
+}
+
+void ImageSource::scheduleFrameDecodeAhead(size_t index)
+{
+    if (m_decoder)
+        m_decoder->scheduleFrameDecodeAhead(index);
+}
+
 } // namespace blink
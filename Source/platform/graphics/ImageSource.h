@@ -37,6 +37,7 @@ namespace blink {
 class DeferredImageDecoder;
 class ImageOrientation;
 class IntPoint;
+class IntRect;
 class IntSize;
 class NativeImageSkia;
 class SharedBuffer;
@@ -117,6 +118,15 @@ public:
 
     PassRefPtr<NativeImageSkia> createFrameAtIndex(size_t);
 
+    // Returns the first frame decoded at scaleNumerator / 8 of the image
+    // size, or 0 if the decoder can't decode it at a reduced size.
+    PassRefPtr<NativeImageSkia> createFrameAtScale(unsigned scaleNumerator);
+
+    // Returns the part of the first frame covering region, decoded on its own,
+    // or 0 if the image is too small or can't be decoded a region at a time.
+    // On success region is grown to the rect the returned frame covers.
+    PassRefPtr<NativeImageSkia> createFrameForRegion(IntRect& region);
+
     float frameDurationAtIndex(size_t) const;
     bool frameHasAlphaAtIndex(size_t) const; // Whether or not the frame actually used any alpha.
     bool frameIsCompleteAtIndex(size_t) const; // Whether or not the frame is fully received.
@@ -126,6 +136,13 @@ public:
     // decoded then return 0.
     unsigned frameBytesAtIndex(size_t) const;
 
+    // Decodes the first frame ahead of rasterization if decoding is deferred.
+    void scheduleDecodeAhead(unsigned distanceFromViewport);
+
+    // Decodes frame |index| of an animation ahead of it being shown if
+    // decoding is deferred.
+    void scheduleFrameDecodeAhead(size_t index);
+
 private:
     OwnPtr<DeferredImageDecoder> m_decoder;
 
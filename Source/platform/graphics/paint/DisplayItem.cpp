@@ -66,6 +66,8 @@ WTF::String DisplayItem::typeAsDebugString(DisplayItem::Type type)
     case FloatClipSelection: return "FloatClipSelection";
     case FloatClipSelfOutline: return "FloatClipSelfOutline";
     case EndFloatClip: return "EndFloatClip";
+    case BeginSubsequence: return "BeginSubsequence";
+    case EndSubsequence: return "EndSubsequence";
     }
     ASSERT_NOT_REACHED();
     return "Unknown";
@@ -80,7 +80,9 @@ public:
         FloatClipForeground,
         FloatClipSelection,
         FloatClipSelfOutline,
-        EndFloatClip
+        EndFloatClip,
+        BeginSubsequence,
+        EndSubsequence
     };
 
     // Create a dummy display item which just holds the id but has no display operation.
@@ -109,6 +111,7 @@ public:
 #endif
 
     virtual bool isCached() const { return false; }
+    virtual bool isDrawing() const { return false; }
 
 protected:
     DisplayItem(DisplayItemClient client, Type type)
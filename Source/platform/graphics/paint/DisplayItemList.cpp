@@ -7,6 +7,7 @@
 
 #include "platform/NotImplemented.h"
 #include "platform/RuntimeEnabledFeatures.h"
+#include "platform/graphics/paint/DisplayItemSpatialIndex.h"
 #ifndef NDEBUG
 #include "platform/graphics/paint/DisplayItem.h"
 #include "wtf/text/StringBuilder.h"
@@ -15,6 +16,10 @@
 
 namespace blink {
 
+DisplayItemList::~DisplayItemList()
+{
+}
+
 const PaintList& DisplayItemList::paintList()
 {
     ASSERT(RuntimeEnabledFeatures::slimmingPaintEnabled());
@@ -33,6 +38,7 @@ void DisplayItemList::invalidate(DisplayItemClient client)
 {
     ASSERT(RuntimeEnabledFeatures::slimmingPaintEnabled());
     m_cachedClients.remove(client);
+    m_cachedSubsequenceClients.remove(client);
 }
 
 void DisplayItemList::invalidateAll()
@@ -42,6 +48,8 @@ void DisplayItemList::invalidateAll()
     ASSERT(m_newPaints.isEmpty());
     m_paintList.clear();
     m_cachedClients.clear();
+    m_cachedSubsequenceClients.clear();
+    m_spatialIndex.clear();
 }
 
 PaintList::iterator DisplayItemList::findNextMatchingCachedItem(PaintList::iterator begin, const DisplayItem& displayItem)
@@ -57,13 +65,35 @@ PaintList::iterator DisplayItemList::findNextMatchingCachedItem(PaintList::itera
             return it;
     }
 
+    // The markers of a subsequence are new the first time their client paints
+    // one, even though the client's other display items may be cached.
+    ASSERT(displayItem.type() == DisplayItem::BeginSubsequence || displayItem.type() == DisplayItem::EndSubsequence);
+    return end;
+}
+
+// Returns the position just past the EndSubsequence item that closes the
+// subsequence starting at |begin|.
+PaintList::iterator DisplayItemList::findCachedSubsequenceEnd(PaintList::iterator begin)
+{
+    ASSERT((*begin)->type() == DisplayItem::BeginSubsequence);
+    PaintList::iterator end = m_paintList.end();
+    DisplayItemClient client = (*begin)->client();
+
+    for (PaintList::iterator it = begin + 1; it != end; ++it) {
+        DisplayItem& existing = **it;
+        if (existing.client() == client && existing.type() == DisplayItem::EndSubsequence)
+            return it + 1;
+    }
+
     ASSERT_NOT_REACHED();
     return end;
 }
 
-static void appendDisplayItem(PaintList& list, HashSet<DisplayItemClient>& clients, WTF::PassOwnPtr<DisplayItem> displayItem)
+static void appendDisplayItem(PaintList& list, HashSet<DisplayItemClient>& clients, HashSet<DisplayItemClient>& subsequenceClients, WTF::PassOwnPtr<DisplayItem> displayItem)
 {
     clients.add(displayItem->client());
+    if (displayItem->type() == DisplayItem::BeginSubsequence)
+        subsequenceClients.add(displayItem->client());
     list.append(displayItem);
 }
 
@@ -72,10 +102,14 @@ static void appendDisplayItem(PaintList& list, HashSet<DisplayItemClient>& clien
 //
 // The algorithm is O(|existing paint list| + |newly painted list|): by using
 // the ordering implied by the existing paint list, extra treewalks are avoided.
+// A cached subsequence placeholder brings its whole range of cached items along,
+// so that the cost of painting and merging is proportional to what changed.
 void DisplayItemList::updatePaintList()
 {
     PaintList updatedList;
     HashSet<DisplayItemClient> newCachedClients;
+    HashSet<DisplayItemClient> newCachedSubsequenceClients;
+    size_t repaintedItemCount = 0;
 
     PaintList::iterator paintListIt = m_paintList.begin();
     PaintList::iterator paintListEnd = m_paintList.end();
@@ -86,26 +120,41 @@ void DisplayItemList::updatePaintList()
             // Copy all of the existing items over until we hit the matching cached item.
             for (; paintListIt != cachedItemIt; ++paintListIt) {
                 if (clientCacheIsValid((*paintListIt)->client()))
-                    appendDisplayItem(updatedList, newCachedClients, paintListIt->release());
+                    appendDisplayItem(updatedList, newCachedClients, newCachedSubsequenceClients, paintListIt->release());
             }
 
-            // Use the cached item for the new display item.
-            appendDisplayItem(updatedList, newCachedClients, cachedItemIt->release());
-            ++paintListIt;
+            // Use the cached item for the new display item, or the whole cached
+            // subsequence if the new display item stands for one.
+            PaintList::iterator cachedEndIt = cachedItemIt + 1;
+            if (newDisplayItem->isCached() && newDisplayItem->type() == DisplayItem::BeginSubsequence)
+                cachedEndIt = findCachedSubsequenceEnd(cachedItemIt);
+            for (; paintListIt != cachedEndIt; ++paintListIt) {
+                if (clientCacheIsValid((*paintListIt)->client()))
+                    appendDisplayItem(updatedList, newCachedClients, newCachedSubsequenceClients, paintListIt->release());
+            }
         } else {
             // If the new display item is a cached placeholder, we should have found
             // the cached display item.
             ASSERT(!newDisplayItem->isCached());
 
             // Copy over the new item.
-            appendDisplayItem(updatedList, newCachedClients, newDisplayItem.release());
+            appendDisplayItem(updatedList, newCachedClients, newCachedSubsequenceClients, newDisplayItem.release());
+            ++repaintedItemCount;
         }
     }
 
     // Copy over any remaining items that are validly cached.
     for (; paintListIt != paintListEnd; ++paintListIt) {
         if (clientCacheIsValid((*paintListIt)->client()))
-            appendDisplayItem(updatedList, newCachedClients, paintListIt->release());
+            appendDisplayItem(updatedList, newCachedClients, newCachedSubsequenceClients, paintListIt->release());
+    }
+
+    if (!m_newPaints.isEmpty() || updatedList.size() != m_paintList.size())
+        m_spatialIndex.clear();
+
+    if (!m_newPaints.isEmpty()) {
+        m_reusedItemCount = updatedList.size() - repaintedItemCount;
+        m_repaintedItemCount = repaintedItemCount;
     }
 
     m_newPaints.clear();
@@ -113,6 +162,8 @@ void DisplayItemList::updatePaintList()
     m_paintList.swap(updatedList);
     m_cachedClients.clear();
     m_cachedClients.swap(newCachedClients);
+    m_cachedSubsequenceClients.clear();
+    m_cachedSubsequenceClients.swap(newCachedSubsequenceClients);
 }
 
 #ifndef NDEBUG
@@ -149,4 +200,20 @@ void DisplayItemList::replay(GraphicsContext* context)
         displayItem->replay(context);
 }
 
+void DisplayItemList::replay(GraphicsContext* context, const IntRect& bounds)
+{
+    updatePaintList();
+    Vector<size_t> displayItems;
+    spatialIndex().query(bounds, displayItems);
+    for (size_t index : displayItems)
+        m_paintList[index]->replay(context);
+}
+
+const DisplayItemSpatialIndex& DisplayItemList::spatialIndex()
+{
+    if (!m_spatialIndex)
+        m_spatialIndex = DisplayItemSpatialIndex::create(m_paintList);
+    return *m_spatialIndex;
+}
+
 } // namespace blink
@@ -8,12 +8,15 @@
 #include "platform/PlatformExport.h"
 #include "platform/graphics/paint/DisplayItem.h"
 #include "wtf/HashSet.h"
+#include "wtf/OwnPtr.h"
 #include "wtf/PassOwnPtr.h"
 #include "wtf/Vector.h"
 
 namespace blink {
 
+class DisplayItemSpatialIndex;
 class GraphicsContext;
+class IntRect;
 
 typedef Vector<OwnPtr<DisplayItem> > PaintList;
 
@@ -21,6 +24,7 @@ class PLATFORM_EXPORT DisplayItemList {
     WTF_MAKE_NONCOPYABLE(DisplayItemList);
 public:
     static PassOwnPtr<DisplayItemList> create() { return adoptPtr(new DisplayItemList); }
+    ~DisplayItemList();
 
     const PaintList& paintList();
     void add(WTF::PassOwnPtr<DisplayItem>);
@@ -29,20 +33,42 @@ public:
     void invalidateAll();
     bool clientCacheIsValid(DisplayItemClient client) const { return m_cachedClients.contains(client); }
 
+    // A subsequence is the range of display items between a BeginSubsequence and
+    // an EndSubsequence item of the same client, e.g. everything a RenderLayer
+    // painted. When none of the painters inside it changed, a CachedDisplayItem of
+    // type BeginSubsequence stands for the whole range.
+    bool subsequenceCacheIsValid(DisplayItemClient client) const { return m_cachedSubsequenceClients.contains(client); }
+
+    // How many display items the last update of the paint list took from the
+    // cache, and how many were painted anew.
+    size_t reusedItemCount() const { return m_reusedItemCount; }
+    size_t repaintedItemCount() const { return m_repaintedItemCount; }
+
     // Plays back the current PaintList() into the given context.
     void replay(GraphicsContext*);
 
+    // Like replay(), but skips the drawings outside of |bounds|, e.g. to raster
+    // only a dirty rect. The context should be clipped to |bounds|. See
+    // DisplayItemSpatialIndex.
+    void replay(GraphicsContext*, const IntRect& bounds);
+
 #ifndef NDEBUG
     void showDebugData() const;
 #endif
 
 protected:
-    DisplayItemList() { };
+    DisplayItemList()
+        : m_reusedItemCount(0)
+        , m_repaintedItemCount(0)
+    {
+    }
 
 private:
     PaintList::iterator findNextMatchingCachedItem(PaintList::iterator, const DisplayItem&);
+    PaintList::iterator findCachedSubsequenceEnd(PaintList::iterator);
     bool wasInvalidated(const DisplayItem&) const;
     void updatePaintList();
+    const DisplayItemSpatialIndex& spatialIndex();
 
 #ifndef NDEBUG
     WTF::String paintListAsDebugString(const PaintList&) const;
@@ -50,7 +76,12 @@ private:
 
     PaintList m_paintList;
     HashSet<DisplayItemClient> m_cachedClients;
+    HashSet<DisplayItemClient> m_cachedSubsequenceClients;
     PaintList m_newPaints;
+    size_t m_reusedItemCount;
+    size_t m_repaintedItemCount;
+    // Built on demand for the current m_paintList.
+    OwnPtr<DisplayItemSpatialIndex> m_spatialIndex;
 };
 
 } // namespace blink
@@ -0,0 +1,122 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/paint/DisplayItemSpatialIndex.h"
+
+#include "platform/TraceEvent.h"
+#include "platform/geometry/FloatRect.h"
+#include "platform/graphics/paint/DrawingDisplayItem.h"
+#include "platform/graphics/paint/TransformDisplayItem.h"
+#include "platform/transforms/AffineTransform.h"
+#include <algorithm>
+
+namespace blink {
+
+static const int minCellSize = 256;
+// Keeps the grid small for huge lists, e.g. of very long pages.
+static const int maxCellsPerSide = 64;
+
+DisplayItemSpatialIndex::DisplayItemSpatialIndex(const PaintList& paintList)
+    : m_columns(0)
+    , m_rows(0)
+{
+    TRACE_EVENT1("blink", "DisplayItemSpatialIndex::DisplayItemSpatialIndex", "displayItems", paintList.size());
+
+    Vector<AffineTransform> transforms;
+    transforms.append(AffineTransform());
+    unsigned filterDepth = 0;
+
+    m_itemBounds.resize(paintList.size());
+    for (size_t index = 0; index < paintList.size(); ++index) {
+        const DisplayItem& displayItem = *paintList[index];
+
+        if (!displayItem.isDrawing()) {
+            if (displayItem.type() == DisplayItem::BeginTransform) {
+                AffineTransform transform = transforms.last();
+                transform.multiply(static_cast<const BeginTransformDisplayItem&>(displayItem).transform());
+                transforms.append(transform);
+            } else if (displayItem.type() == DisplayItem::EndTransform) {
+                ASSERT(transforms.size() > 1);
+                transforms.removeLast();
+            } else if (displayItem.type() == DisplayItem::BeginFilter) {
+                ++filterDepth;
+            } else if (displayItem.type() == DisplayItem::EndFilter) {
+                ASSERT(filterDepth);
+                --filterDepth;
+            }
+            m_unboundedItems.append(index);
+            continue;
+        }
+
+        if (filterDepth) {
+            m_unboundedItems.append(index);
+            continue;
+        }
+
+        // Anti-aliasing may touch a pixel outside of the picture's cull rect.
+        FloatRect cullRect(static_cast<const DrawingDisplayItem&>(displayItem).picture()->cullRect());
+        IntRect bounds = enclosingIntRect(transforms.last().mapRect(cullRect));
+        bounds.inflate(1);
+        m_itemBounds[index] = bounds;
+        m_gridBounds.unite(bounds);
+    }
+
+    if (m_gridBounds.isEmpty())
+        return;
+
+    m_cellSize = IntSize(
+        std::max(minCellSize, (m_gridBounds.width() + maxCellsPerSide - 1) / maxCellsPerSide),
+        std::max(minCellSize, (m_gridBounds.height() + maxCellsPerSide - 1) / maxCellsPerSide));
+    m_columns = (m_gridBounds.width() + m_cellSize.width() - 1) / m_cellSize.width();
+    m_rows = (m_gridBounds.height() + m_cellSize.height() - 1) / m_cellSize.height();
+    m_cells.resize(m_columns * m_rows);
+
+    for (size_t index = 0; index < paintList.size(); ++index) {
+        if (!m_itemBounds[index].isEmpty())
+            insert(index, m_itemBounds[index]);
+    }
+}
+
+void DisplayItemSpatialIndex::insert(size_t index, const IntRect& bounds)
+{
+    size_t firstColumn = (bounds.x() - m_gridBounds.x()) / m_cellSize.width();
+    size_t lastColumn = (bounds.maxX() - 1 - m_gridBounds.x()) / m_cellSize.width();
+    size_t firstRow = (bounds.y() - m_gridBounds.y()) / m_cellSize.height();
+    size_t lastRow = (bounds.maxY() - 1 - m_gridBounds.y()) / m_cellSize.height();
+    for (size_t row = firstRow; row <= lastRow; ++row) {
+        for (size_t column = firstColumn; column <= lastColumn; ++column)
+            m_cells[row * m_columns + column].append(index);
+    }
+}
+
+void DisplayItemSpatialIndex::query(const IntRect& rect, Vector<size_t>& indices) const
+{
+    Vector<size_t> drawings;
+    IntRect gridRect = intersection(rect, m_gridBounds);
+    if (!gridRect.isEmpty()) {
+        size_t firstColumn = (gridRect.x() - m_gridBounds.x()) / m_cellSize.width();
+        size_t lastColumn = (gridRect.maxX() - 1 - m_gridBounds.x()) / m_cellSize.width();
+        size_t firstRow = (gridRect.y() - m_gridBounds.y()) / m_cellSize.height();
+        size_t lastRow = (gridRect.maxY() - 1 - m_gridBounds.y()) / m_cellSize.height();
+        for (size_t row = firstRow; row <= lastRow; ++row) {
+            for (size_t column = firstColumn; column <= lastColumn; ++column) {
+                for (size_t index : m_cells[row * m_columns + column]) {
+                    if (m_itemBounds[index].intersects(rect))
+                        drawings.append(index);
+                }
+            }
+        }
+
+        // Drawings that span several cells were found once per cell.
+        std::sort(drawings.begin(), drawings.end());
+        drawings.shrink(std::unique(drawings.begin(), drawings.end()) - drawings.begin());
+    }
+
+    size_t start = indices.size();
+    indices.grow(start + drawings.size() + m_unboundedItems.size());
+    std::merge(drawings.begin(), drawings.end(), m_unboundedItems.begin(), m_unboundedItems.end(), indices.begin() + start);
+}
+
+} // namespace blink
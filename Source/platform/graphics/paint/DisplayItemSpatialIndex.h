@@ -0,0 +1,53 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef DisplayItemSpatialIndex_h
+#define DisplayItemSpatialIndex_h
+
+#include "platform/PlatformExport.h"
+#include "platform/geometry/IntRect.h"
+#include "platform/graphics/paint/DisplayItemList.h"
+#include "wtf/FastAllocBase.h"
+#include "wtf/Noncopyable.h"
+#include "wtf/PassOwnPtr.h"
+#include "wtf/Vector.h"
+
+namespace blink {
+
+// A grid over the bounds of the drawings in a PaintList, for replaying only
+// the part of the list within a rect. The bounds of a drawing are those of its
+// picture, mapped by the transforms it's nested in. Clips are ignored, and
+// drawings nested in a filter are taken to be everywhere, since the filter
+// may move them. Display items other than drawings, i.e. the begin and end
+// items of clips, transforms and effects, are always replayed, so that they
+// stay paired.
+class PLATFORM_EXPORT DisplayItemSpatialIndex {
+    WTF_MAKE_NONCOPYABLE(DisplayItemSpatialIndex);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static PassOwnPtr<DisplayItemSpatialIndex> create(const PaintList& paintList) { return adoptPtr(new DisplayItemSpatialIndex(paintList)); }
+
+    explicit DisplayItemSpatialIndex(const PaintList&);
+
+    // Appends the indices in the PaintList of the display items to replay for
+    // |rect| to |indices|, in paint order.
+    void query(const IntRect& rect, Vector<size_t>& indices) const;
+
+private:
+    void insert(size_t index, const IntRect& bounds);
+
+    // Indices of the display items to replay for any rect.
+    Vector<size_t> m_unboundedItems;
+    Vector<IntRect> m_itemBounds;
+
+    IntRect m_gridBounds;
+    IntSize m_cellSize;
+    size_t m_columns;
+    size_t m_rows;
+    Vector<Vector<size_t> > m_cells;
+};
+
+} // namespace blink
+
+#endif // DisplayItemSpatialIndex_h
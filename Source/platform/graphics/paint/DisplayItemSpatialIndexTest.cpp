@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/graphics/paint/DisplayItemSpatialIndex.h"
+
+#include "platform/graphics/paint/DrawingDisplayItem.h"
+#include "platform/graphics/paint/TransformDisplayItem.h"
+#include "platform/transforms/AffineTransform.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+class DisplayItemSpatialIndexTest : public ::testing::Test {
+protected:
+    DisplayItemClient client() { return reinterpret_cast<DisplayItemClient>(this); }
+
+    void appendRect(const SkRect& rect)
+    {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(rect);
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawRect(rect, paint);
+        m_paintList.append(DrawingDisplayItem::create(client(), DisplayItem::DrawingPaintPhaseForeground, adoptRef(recorder.endRecording())));
+    }
+
+    Vector<size_t> query(const IntRect& rect)
+    {
+        DisplayItemSpatialIndex spatialIndex(m_paintList);
+        Vector<size_t> indices;
+        spatialIndex.query(rect, indices);
+        return indices;
+    }
+
+    PaintList m_paintList;
+};
+
+#define EXPECT_INDICES(actual, expectedSize, ...) { \
+    const size_t expected[] = { __VA_ARGS__ }; \
+    ASSERT_EQ((size_t)expectedSize, actual.size()); \
+    for (size_t i = 0; i < expectedSize; ++i) \
+        EXPECT_EQ(expected[i], actual[i]); \
+}
+
+TEST_F(DisplayItemSpatialIndexTest, SkipsDrawingsOutsideRect)
+{
+    appendRect(SkRect::MakeXYWH(0, 0, 50, 50));
+    m_paintList.append(BeginTransformDisplayItem::create(client(), AffineTransform::translation(0, 1000)));
+    appendRect(SkRect::MakeXYWH(0, 0, 50, 50));
+    m_paintList.append(EndTransformDisplayItem::create(client()));
+    appendRect(SkRect::MakeXYWH(600, 0, 1000, 50));
+
+    Vector<size_t> indices = query(IntRect(0, 0, 100, 100));
+    EXPECT_INDICES(indices, 3, 0, 1, 3);
+
+    // The second drawing is moved down by the transform.
+    indices = query(IntRect(0, 990, 100, 100));
+    EXPECT_INDICES(indices, 3, 1, 2, 3);
+
+    // The last drawing spans several cells but is replayed once.
+    indices = query(IntRect(500, 0, 1200, 100));
+    EXPECT_INDICES(indices, 3, 1, 3, 4);
+
+    indices = query(IntRect(-500, -500, 100, 100));
+    EXPECT_INDICES(indices, 2, 1, 3);
+}
+
+TEST_F(DisplayItemSpatialIndexTest, FilteredDrawingsAreEverywhere)
+{
+    appendRect(SkRect::MakeXYWH(0, 0, 50, 50));
+    m_paintList.append(DisplayItem::create(client(), DisplayItem::BeginFilter));
+    appendRect(SkRect::MakeXYWH(0, 0, 50, 50));
+    m_paintList.append(DisplayItem::create(client(), DisplayItem::EndFilter));
+
+    Vector<size_t> indices = query(IntRect(3000, 3000, 100, 100));
+    EXPECT_INDICES(indices, 3, 1, 2, 3);
+}
+
+} // namespace
@@ -25,6 +25,8 @@ public:
 
     PassRefPtr<const SkPicture> picture() const { return m_picture; }
 
+    virtual bool isDrawing() const override { return true; }
+
 protected:
     DrawingDisplayItem(DisplayItemClient client, Type type, PassRefPtr<const SkPicture> picture)
         : DisplayItem(client, type), m_picture(picture) { ASSERT(m_picture); }
@@ -18,6 +18,8 @@ public:
     virtual void replay(GraphicsContext*) override;
     virtual void appendToWebDisplayItemList(WebDisplayItemList*) const override;
 
+    const AffineTransform& transform() const { return m_transform; }
+
 protected:
     BeginTransformDisplayItem(DisplayItemClient, const AffineTransform&);
 
@@ -71,10 +71,14 @@ public:
 
     static const size_t noDecodedImageByteLimit = Platform::noDecodedImageByteLimit;
 
+    // Denominator of the scales passed to setTargetScaleNumerator().
+    static const unsigned scaleDenominator = 8;
+
     ImageDecoder(ImageSource::AlphaOption alphaOption, ImageSource::GammaAndColorProfileOption gammaAndColorProfileOption, size_t maxDecodedBytes)
         : m_premultiplyAlpha(alphaOption == ImageSource::AlphaPremultiplied)
         , m_ignoreGammaAndColorProfile(gammaAndColorProfileOption == ImageSource::GammaAndColorProfileIgnored)
         , m_maxDecodedBytes(maxDecodedBytes)
+        , m_targetScaleNumerator(scaleDenominator)
         , m_sizeAvailable(false)
         , m_isAllDataReceived(false)
         , m_failed(false) { }
@@ -118,6 +122,51 @@ public:
     // return the actual decoded size.
     virtual IntSize decodedSize() const { return size(); }
 
+    // Decoders which can decode at a reduced resolution return true here
+    // once the size is available. After setTargetScaleNumerator(n) they
+    // decode to scaledSize(size(), n) instead of the full size.
+    virtual bool canDecodeToScale() const { return false; }
+
+    // Asks for frames of scaleNumerator / scaleDenominator of the image
+    // size, e.g. for thumbnails of large photos. Must be called before
+    // decoding starts. Only 1, 2 and 4 are used, since every libjpeg build
+    // implements those scales in its IDCT.
+    void setTargetScaleNumerator(unsigned scaleNumerator)
+    {
+        ASSERT(scaleNumerator && scaleNumerator <= scaleDenominator);
+        m_targetScaleNumerator = scaleNumerator;
+    }
+    unsigned targetScaleNumerator() const { return m_targetScaleNumerator; }
+
+    // Rounds up like jpeg_calc_output_dimensions() does.
+    static IntSize scaledSize(const IntSize& size, unsigned scaleNumerator)
+    {
+        return IntSize(
+            static_cast<int>((static_cast<uint64_t>(size.width()) * scaleNumerator + scaleDenominator - 1) / scaleDenominator),
+            static_cast<int>((static_cast<uint64_t>(size.height()) * scaleNumerator + scaleDenominator - 1) / scaleDenominator));
+    }
+
+    // Decoders which can decode a sub-rectangle of the image return true
+    // here. After setDecodeRegion() their frame buffers only hold the pixels
+    // of that region of the decoded image, so very large images can be
+    // painted a part at a time. Decoding stops after the region's last row
+    // where the format allows it. Must be called before decoding starts.
+    virtual bool canDecodeRegion() const { return false; }
+    void setDecodeRegion(const IntRect& region)
+    {
+        ASSERT(!region.isEmpty());
+        m_decodeRegion = region;
+    }
+
+    // Returns the part of the decoded image the frame buffers hold.
+    IntRect decodeRegion() const
+    {
+        IntRect decodedRect(IntPoint(), decodedSize());
+        if (!m_decodeRegion.isEmpty())
+            decodedRect.intersect(m_decodeRegion);
+        return decodedRect;
+    }
+
     // Decoders which support YUV decoding can override this to
     // give potentially different sizes per component.
     virtual IntSize decodedYUVSize(int component, SizeType) const { return decodedSize(); }
@@ -310,6 +359,12 @@ protected:
     // memory devices.
     size_t m_maxDecodedBytes;
 
+    // See setTargetScaleNumerator().
+    unsigned m_targetScaleNumerator;
+
+    // See setDecodeRegion(). Empty unless a region was asked for.
+    IntRect m_decodeRegion;
+
 private:
     // Some code paths compute the size of the image as "width * height * 4"
     // and return it as a (signed) int.  Avoid overflow.
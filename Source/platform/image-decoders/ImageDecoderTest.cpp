@@ -81,6 +81,32 @@ TEST(ImageDecoderTest, sizeCalculationMayOverflow)
     EXPECT_TRUE(decoder->setSize(1 << 14, 1 << 14));
 }
 
+TEST(ImageDecoderTest, scaledSize)
+{
+    EXPECT_EQ(IntSize(256, 256), ImageDecoder::scaledSize(IntSize(256, 256), 8));
+    EXPECT_EQ(IntSize(128, 128), ImageDecoder::scaledSize(IntSize(256, 256), 4));
+    EXPECT_EQ(IntSize(32, 32), ImageDecoder::scaledSize(IntSize(256, 256), 1));
+    // Odd sizes round up, like libjpeg does.
+    EXPECT_EQ(IntSize(138, 104), ImageDecoder::scaledSize(IntSize(275, 207), 4));
+    EXPECT_EQ(IntSize(35, 26), ImageDecoder::scaledSize(IntSize(275, 207), 1));
+    EXPECT_EQ(IntSize(1, 1), ImageDecoder::scaledSize(IntSize(1, 1), 1));
+    // No overflow for the largest allowed sizes.
+    EXPECT_EQ(IntSize(1 << 25, 1), ImageDecoder::scaledSize(IntSize(1 << 28, 1), 1));
+}
+
+TEST(ImageDecoderTest, targetScaleNumerator)
+{
+    OwnPtr<TestImageDecoder> decoder(adoptPtr(new TestImageDecoder()));
+    EXPECT_EQ(ImageDecoder::scaleDenominator, decoder->targetScaleNumerator());
+    EXPECT_FALSE(decoder->canDecodeToScale());
+
+    // Decoders which can't scale keep decoding at full size.
+    decoder->setTargetScaleNumerator(2);
+    EXPECT_EQ(2u, decoder->targetScaleNumerator());
+    decoder->initFrames(1, 100, 50);
+    EXPECT_EQ(IntSize(100, 50), decoder->decodedSize());
+}
+
 TEST(ImageDecoderTest, requiredPreviousFrameIndex)
 {
     OwnPtr<TestImageDecoder> decoder(adoptPtr(new TestImageDecoder()));
@@ -0,0 +1,390 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/image-decoders/RowConversion.h"
+
+#include "wtf/CPU.h"
+#include <string.h>
+
+#if CPU(X86) || CPU(X86_64)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
+namespace blink {
+
+namespace RowConversion {
+
+// The vector code writes pixels as RGBA or BGRA bytes, alpha last.
+COMPILE_ASSERT(SK_A32_SHIFT == 24, ImageFramePixelsHaveAlphaInTheTopByte);
+
+// YCbCr to RGB coefficients of JFIF, as 2.14 fixed point:
+// R = Y + 1.402 Cr, G = Y - 0.344136 Cb - 0.714136 Cr, B = Y + 1.772 Cb.
+static const int crToR = 22970;
+static const int cbToG = -5638;
+static const int crToG = -11700;
+static const int cbToB = 29032;
+static const int yuvRounding = 1 << 13;
+static const int yuvShift = 14;
+
+static inline unsigned clampToByte(int value)
+{
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+// The vector code computes exactly the same values.
+static inline void setYUV(ImageFrame::PixelData* destination, int y, int u, int v)
+{
+    int cb = u - 128;
+    int cr = v - 128;
+    unsigned r = clampToByte(y + ((crToR * cr + yuvRounding) >> yuvShift));
+    unsigned g = clampToByte(y + ((cbToG * cb + crToG * cr + yuvRounding) >> yuvShift));
+    unsigned b = clampToByte(y + ((cbToB * cb + yuvRounding) >> yuvShift));
+    ImageFrame::setRGBARaw(destination, r, g, b, 255);
+}
+
+#if CPU(X86) || CPU(X86_64) || HAVE(ARM_NEON_INTRINSICS)
+// Reads the chroma samples of eight pixels starting at pixel |x|, which is a
+// multiple of 2^|chromaShift|, without reading past them.
+static inline uint64_t readChroma(const unsigned char* row, unsigned chromaShift, unsigned x)
+{
+    uint64_t samples = 0;
+    memcpy(&samples, row + (x >> chromaShift), 8 >> chromaShift);
+    return samples;
+}
+#endif
+
+#if CPU(X86) || CPU(X86_64)
+
+// Premultiplies two pixels held as 16-bit components, leaving their alpha
+// untouched. Rounds down like ImageFrame::setRGBAPremultiply() does.
+static inline __m128i premultiplyWords(__m128i pixels)
+{
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i product = _mm_mullo_epi16(pixels, alpha);
+    // x / 255 == (x + 1 + (x >> 8)) >> 8 for x <= 255 * 255.
+    product = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)), _mm_srli_epi16(product, 8)), 8);
+    const __m128i alphaWords = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    return _mm_or_si128(_mm_andnot_si128(alphaWords, product), _mm_and_si128(alphaWords, pixels));
+}
+
+// Multiplies the first three bytes of four pixels by their fourth byte.
+static inline __m128i premultiplyPixels(__m128i pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = premultiplyWords(_mm_unpacklo_epi8(pixels, zero));
+    __m128i high = premultiplyWords(_mm_unpackhi_epi8(pixels, zero));
+    return _mm_packus_epi16(low, high);
+}
+
+// Turns four RGBA pixels into ImageFrame pixels.
+static inline __m128i toN32(__m128i pixels)
+{
+#if SK_R32_SHIFT == 16
+    // Swap the R and B bytes.
+    const __m128i redAndBlue = _mm_set1_epi32(0x00FF00FF);
+    __m128i swapped = _mm_and_si128(pixels, redAndBlue);
+    swapped = _mm_shufflehi_epi16(_mm_shufflelo_epi16(swapped, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_andnot_si128(redAndBlue, pixels), swapped);
+#else
+    return pixels;
+#endif
+}
+
+static inline unsigned andOfAlphas(__m128i pixels)
+{
+    uint32_t values[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), pixels);
+    return (values[0] & values[1] & values[2] & values[3]) >> SK_A32_SHIFT;
+}
+
+template <bool premultiplyAlpha> static unsigned packRGBAPixels(const unsigned char*& source, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    __m128i alphas = _mm_set1_epi32(-1);
+    for (; pixels >= 4; pixels -= 4, source += 16, destination += 4) {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        alphas = _mm_and_si128(alphas, rgba);
+        if (premultiplyAlpha)
+            rgba = premultiplyPixels(rgba);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), toN32(rgba));
+    }
+    return andOfAlphas(alphas);
+}
+
+static void packInvertedCMYKPixels(const unsigned char*& source, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    // Multiplying the CMY bytes by K is the same as premultiplying them.
+    const __m128i opaque = _mm_slli_epi32(_mm_set1_epi32(0xFF), SK_A32_SHIFT);
+    for (; pixels >= 4; pixels -= 4, source += 16, destination += 4) {
+        __m128i cmyk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), toN32(_mm_or_si128(premultiplyPixels(cmyk), opaque)));
+    }
+}
+
+static void packRGBPixels(const unsigned char*&, ImageFrame::PixelData*&, unsigned&)
+{
+    // SSE2 has no byte shuffles, the scalar loop below is as fast.
+}
+
+// Loads eight chroma samples as words, minus 128.
+static inline __m128i loadChroma(const unsigned char* row, unsigned chromaShift, unsigned x)
+{
+    uint64_t samples = readChroma(row, chromaShift, x);
+    __m128i chroma = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&samples));
+    for (unsigned i = 0; i < chromaShift; ++i)
+        chroma = _mm_unpacklo_epi8(chroma, chroma);
+    return _mm_sub_epi16(_mm_unpacklo_epi8(chroma, _mm_setzero_si128()), _mm_set1_epi16(128));
+}
+
+// Computes ((cb * cbFactor + cr * crFactor + rounding) >> 14) for eight
+// pixels, given their interleaved Cb and Cr words.
+static inline __m128i chromaTerm(__m128i low, __m128i high, short cbFactor, short crFactor)
+{
+    const __m128i factors = _mm_set_epi16(crFactor, cbFactor, crFactor, cbFactor, crFactor, cbFactor, crFactor, cbFactor);
+    const __m128i rounding = _mm_set1_epi32(yuvRounding);
+    low = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(low, factors), rounding), yuvShift);
+    high = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(high, factors), rounding), yuvShift);
+    return _mm_packs_epi32(low, high);
+}
+
+static void packYUVPixels(const unsigned char* yRow, const unsigned char* uRow, const unsigned char* vRow, unsigned chromaShift, unsigned& x, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set1_epi8(-1);
+    for (; pixels >= 8; pixels -= 8, x += 8, destination += 8) {
+        __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(yRow + x)), zero);
+        __m128i cb = loadChroma(uRow, chromaShift, x);
+        __m128i cr = loadChroma(vRow, chromaShift, x);
+        __m128i low = _mm_unpacklo_epi16(cb, cr);
+        __m128i high = _mm_unpackhi_epi16(cb, cr);
+
+        __m128i r = _mm_adds_epi16(y, chromaTerm(low, high, 0, crToR));
+        __m128i g = _mm_adds_epi16(y, chromaTerm(low, high, cbToG, crToG));
+        __m128i b = _mm_adds_epi16(y, chromaTerm(low, high, cbToB, 0));
+#if SK_R32_SHIFT == 16
+        __m128i first = _mm_packus_epi16(b, zero);
+        __m128i third = _mm_packus_epi16(r, zero);
+#else
+        __m128i first = _mm_packus_epi16(r, zero);
+        __m128i third = _mm_packus_epi16(b, zero);
+#endif
+        __m128i firstSecond = _mm_unpacklo_epi8(first, _mm_packus_epi16(g, zero));
+        __m128i thirdAlpha = _mm_unpacklo_epi8(third, opaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_unpacklo_epi16(firstSecond, thirdAlpha));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 4), _mm_unpackhi_epi16(firstSecond, thirdAlpha));
+    }
+}
+
+#elif HAVE(ARM_NEON_INTRINSICS)
+
+// Rounds down like ImageFrame::setRGBAPremultiply() does.
+static inline uint8x8_t multiply(uint8x8_t a, uint8x8_t b)
+{
+    uint16x8_t product = vmull_u8(a, b);
+    // x / 255 == (x + 1 + (x >> 8)) >> 8 for x <= 255 * 255.
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(product, vdupq_n_u16(1)), vshrq_n_u16(product, 8)), 8);
+}
+
+// Stores eight RGBA pixels as ImageFrame pixels.
+static inline void storeN32(ImageFrame::PixelData* destination, uint8x8x4_t pixels)
+{
+#if SK_R32_SHIFT == 16
+    uint8x8_t red = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = red;
+#endif
+    vst4_u8(reinterpret_cast<uint8_t*>(destination), pixels);
+}
+
+template <bool premultiplyAlpha> static unsigned packRGBAPixels(const unsigned char*& source, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    uint8x8_t alphas = vdup_n_u8(255);
+    for (; pixels >= 8; pixels -= 8, source += 32, destination += 8) {
+        uint8x8x4_t rgba = vld4_u8(source);
+        alphas = vand_u8(alphas, rgba.val[3]);
+        if (premultiplyAlpha) {
+            rgba.val[0] = multiply(rgba.val[0], rgba.val[3]);
+            rgba.val[1] = multiply(rgba.val[1], rgba.val[3]);
+            rgba.val[2] = multiply(rgba.val[2], rgba.val[3]);
+        }
+        storeN32(destination, rgba);
+    }
+
+    uint8_t values[8];
+    vst1_u8(values, alphas);
+    unsigned alphaMask = 255;
+    for (size_t i = 0; i < 8; ++i)
+        alphaMask &= values[i];
+    return alphaMask;
+}
+
+static void packInvertedCMYKPixels(const unsigned char*& source, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    for (; pixels >= 8; pixels -= 8, source += 32, destination += 8) {
+        uint8x8x4_t cmyk = vld4_u8(source);
+        uint8x8x4_t rgba;
+        rgba.val[0] = multiply(cmyk.val[0], cmyk.val[3]);
+        rgba.val[1] = multiply(cmyk.val[1], cmyk.val[3]);
+        rgba.val[2] = multiply(cmyk.val[2], cmyk.val[3]);
+        rgba.val[3] = vdup_n_u8(255);
+        storeN32(destination, rgba);
+    }
+}
+
+static void packRGBPixels(const unsigned char*& source, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    for (; pixels >= 8; pixels -= 8, source += 24, destination += 8) {
+        uint8x8x3_t rgb = vld3_u8(source);
+        uint8x8x4_t rgba = {{ rgb.val[0], rgb.val[1], rgb.val[2], vdup_n_u8(255) }};
+        storeN32(destination, rgba);
+    }
+}
+
+// Loads eight chroma samples as words, minus 128.
+static inline int16x8_t loadChroma(const unsigned char* row, unsigned chromaShift, unsigned x)
+{
+    uint8x8_t chroma = vcreate_u8(readChroma(row, chromaShift, x));
+    for (unsigned i = 0; i < chromaShift; ++i)
+        chroma = vzip_u8(chroma, chroma).val[0];
+    return vreinterpretq_s16_u16(vsubl_u8(chroma, vdup_n_u8(128)));
+}
+
+// vrshrn adds the same rounding as the scalar code before shifting.
+static inline uint8x8_t addChroma(int16x8_t y, int32x4_t low, int32x4_t high)
+{
+    return vqmovun_s16(vqaddq_s16(y, vcombine_s16(vrshrn_n_s32(low, yuvShift), vrshrn_n_s32(high, yuvShift))));
+}
+
+static void packYUVPixels(const unsigned char* yRow, const unsigned char* uRow, const unsigned char* vRow, unsigned chromaShift, unsigned& x, ImageFrame::PixelData*& destination, unsigned& pixels)
+{
+    for (; pixels >= 8; pixels -= 8, x += 8, destination += 8) {
+        int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(yRow + x)));
+        int16x8_t cb = loadChroma(uRow, chromaShift, x);
+        int16x8_t cr = loadChroma(vRow, chromaShift, x);
+
+        uint8x8x4_t rgba;
+        rgba.val[0] = addChroma(y, vmull_n_s16(vget_low_s16(cr), crToR), vmull_n_s16(vget_high_s16(cr), crToR));
+        rgba.val[1] = addChroma(y,
+            vmlal_n_s16(vmull_n_s16(vget_low_s16(cb), cbToG), vget_low_s16(cr), crToG),
+            vmlal_n_s16(vmull_n_s16(vget_high_s16(cb), cbToG), vget_high_s16(cr), crToG));
+        rgba.val[2] = addChroma(y, vmull_n_s16(vget_low_s16(cb), cbToB), vmull_n_s16(vget_high_s16(cb), cbToB));
+        rgba.val[3] = vdup_n_u8(255);
+        storeN32(destination, rgba);
+    }
+}
+
+#else
+
+template <bool premultiplyAlpha> static unsigned packRGBAPixels(const unsigned char*&, ImageFrame::PixelData*&, unsigned&)
+{
+    return 255;
+}
+
+static void packInvertedCMYKPixels(const unsigned char*&, ImageFrame::PixelData*&, unsigned&)
+{
+}
+
+static void packRGBPixels(const unsigned char*&, ImageFrame::PixelData*&, unsigned&)
+{
+}
+
+static void packYUVPixels(const unsigned char*, const unsigned char*, const unsigned char*, unsigned, unsigned&, ImageFrame::PixelData*&, unsigned&)
+{
+}
+
+#endif
+
+// The functions below convert as many pixels as the vector code can and
+// finish the row one pixel at a time.
+
+unsigned packRGBA(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels, bool premultiply)
+{
+    unsigned alphaMask = 255;
+    if (premultiply) {
+        alphaMask &= packRGBAPixels<true>(source, destination, pixels);
+        for (; pixels; --pixels, source += 4) {
+            ImageFrame::setRGBAPremultiply(destination++, source[0], source[1], source[2], source[3]);
+            alphaMask &= source[3];
+        }
+    } else {
+        alphaMask &= packRGBAPixels<false>(source, destination, pixels);
+        for (; pixels; --pixels, source += 4) {
+            ImageFrame::setRGBARaw(destination++, source[0], source[1], source[2], source[3]);
+            alphaMask &= source[3];
+        }
+    }
+    return alphaMask;
+}
+
+void packRGB(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels)
+{
+    packRGBPixels(source, destination, pixels);
+    for (; pixels; --pixels, source += 3)
+        ImageFrame::setRGBARaw(destination++, source[0], source[1], source[2], 255);
+}
+
+void packInvertedCMYK(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels)
+{
+    packInvertedCMYKPixels(source, destination, pixels);
+    for (; pixels; --pixels, source += 4) {
+        // Source is 'Inverted CMYK', output is RGB.
+        // See: http://www.easyrgb.com/math.php?MATH=M12#text12
+        // Or: http://www.ilkeratalay.com/colorspacesfaq.php#rgb
+        // From CMYK to CMY:
+        // X =   X    * (1 -   K   ) +   K  [for X = C, M, or Y]
+        // Thus, from Inverted CMYK to CMY is:
+        // X = (1-iX) * (1 - (1-iK)) + (1-iK) => 1 - iX*iK
+        // From CMY (0..1) to RGB (0..1):
+        // R = 1 - C => 1 - (1 - iC*iK) => iC*iK  [G and B similar]
+        unsigned k = source[3];
+        ImageFrame::setRGBARaw(destination++, source[0] * k / 255, source[1] * k / 255, source[2] * k / 255, 255);
+    }
+}
+
+void packYUV(const unsigned char* yRow, const unsigned char* uRow, const unsigned char* vRow, unsigned chromaShift, unsigned x, ImageFrame::PixelData* destination, unsigned pixels)
+{
+    ASSERT(chromaShift <= 2);
+    // The vector code starts on a chroma sample boundary.
+    const unsigned chromaMask = (1 << chromaShift) - 1;
+    for (; pixels && (x & chromaMask); --pixels, ++x)
+        setYUV(destination++, yRow[x], uRow[x >> chromaShift], vRow[x >> chromaShift]);
+    packYUVPixels(yRow, uRow, vRow, chromaShift, x, destination, pixels);
+    for (; pixels; --pixels, ++x)
+        setYUV(destination++, yRow[x], uRow[x >> chromaShift], vRow[x >> chromaShift]);
+}
+
+bool mapPalette(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels, const ImageFrame::PixelData* palette, size_t paletteSize, size_t transparentIndex, bool writeTransparentPixels)
+{
+    // There are no vector table lookups in SSE2, and NEON's only cover 32
+    // bytes, so this is a plain loop. The two loops are almost identical,
+    // only one of them writes transparent pixels.
+    bool sawTransparentPixel = false;
+    const unsigned char* end = source + pixels;
+    if (writeTransparentPixels) {
+        for (; source != end; ++source, ++destination) {
+            const size_t index = *source;
+            if (index != transparentIndex && index < paletteSize) {
+                *destination = palette[index];
+            } else {
+                *destination = 0;
+                sawTransparentPixel = true;
+            }
+        }
+    } else {
+        for (; source != end; ++source, ++destination) {
+            const size_t index = *source;
+            if (index != transparentIndex && index < paletteSize)
+                *destination = palette[index];
+            else
+                sawTransparentPixel = true;
+        }
+    }
+    return sawTransparentPixel;
+}
+
+} // namespace RowConversion
+
+} // namespace blink
@@ -0,0 +1,45 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef RowConversion_h
+#define RowConversion_h
+
+#include "platform/PlatformExport.h"
+#include "platform/image-decoders/ImageFrame.h"
+
+namespace blink {
+
+// Converts rows of decoded pixels into ImageFrame pixels, i.e. Skia's N32
+// order, a whole row at a time. Uses SSE2 or NEON where available and gives
+// the same results as ImageFrame::setRGBA() and friends otherwise. Color
+// profile transforms are applied to the source row before it's converted.
+namespace RowConversion {
+
+// Packs RGBA bytes, premultiplying them if |premultiply| is set. Returns the
+// AND of the row's alpha values, which is 255 if the row is opaque.
+PLATFORM_EXPORT unsigned packRGBA(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels, bool premultiply);
+
+// Packs RGB bytes as opaque pixels.
+PLATFORM_EXPORT void packRGB(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels);
+
+// Packs inverted CMYK bytes, as written by Adobe apps, as opaque pixels.
+PLATFORM_EXPORT void packInvertedCMYK(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels);
+
+// Converts full range YCbCr, as stored in JPEGs, to opaque pixels, starting
+// with pixel |x| of the row. |yRow|, |uRow| and |vRow| are whole rows; the
+// chroma rows have a sample for every 2^|chromaShift| luma samples, with
+// |chromaShift| at most 2, and chroma is replicated across them.
+PLATFORM_EXPORT void packYUV(const unsigned char* yRow, const unsigned char* uRow, const unsigned char* vRow, unsigned chromaShift, unsigned x, ImageFrame::PixelData* destination, unsigned pixels);
+
+// Looks palette indices up in |palette|. Indices equal to |transparentIndex|
+// or outside the palette are written as transparent pixels if
+// |writeTransparentPixels| is set and left alone otherwise. Returns whether
+// there were any such indices.
+PLATFORM_EXPORT bool mapPalette(const unsigned char* source, ImageFrame::PixelData* destination, unsigned pixels, const ImageFrame::PixelData* palette, size_t paletteSize, size_t transparentIndex, bool writeTransparentPixels);
+
+} // namespace RowConversion
+
+} // namespace blink
+
+#endif // RowConversion_h
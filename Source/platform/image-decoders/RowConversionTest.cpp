@@ -0,0 +1,166 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/image-decoders/RowConversion.h"
+
+#include "wtf/NotFound.h"
+#include "wtf/Vector.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// Every combination of a color component and alpha, plus a few pixels so
+// that the vector loops leave a tail behind.
+const unsigned testPixels = 256 * 256 + 5;
+
+void fillSource(Vector<unsigned char>& source, unsigned channels)
+{
+    source.resize(testPixels * channels);
+    for (unsigned i = 0; i < testPixels; ++i) {
+        unsigned char* pixel = source.data() + i * channels;
+        for (unsigned channel = 0; channel < channels; ++channel)
+            pixel[channel] = (i * (channel + 3)) & 255;
+        pixel[channels - 1] = (i >> 8) & 255;
+    }
+}
+
+} // namespace
+
+TEST(RowConversionTest, packRGBA)
+{
+    Vector<unsigned char> source;
+    fillSource(source, 4);
+
+    for (int premultiply = 0; premultiply < 2; ++premultiply) {
+        Vector<ImageFrame::PixelData> expected(testPixels);
+        unsigned expectedAlphaMask = 255;
+        for (unsigned i = 0; i < testPixels; ++i) {
+            const unsigned char* pixel = source.data() + i * 4;
+            if (premultiply)
+                ImageFrame::setRGBAPremultiply(&expected[i], pixel[0], pixel[1], pixel[2], pixel[3]);
+            else
+                ImageFrame::setRGBARaw(&expected[i], pixel[0], pixel[1], pixel[2], pixel[3]);
+            expectedAlphaMask &= pixel[3];
+        }
+
+        Vector<ImageFrame::PixelData> actual(testPixels);
+        EXPECT_EQ(expectedAlphaMask, RowConversion::packRGBA(source.data(), actual.data(), testPixels, premultiply));
+        EXPECT_TRUE(expected == actual);
+    }
+}
+
+TEST(RowConversionTest, packRGBAOpaqueRow)
+{
+    Vector<unsigned char> source(37 * 4, 255);
+    Vector<ImageFrame::PixelData> destination(37);
+    EXPECT_EQ(255u, RowConversion::packRGBA(source.data(), destination.data(), 37, true));
+    source[36 * 4 + 3] = 254;
+    EXPECT_EQ(254u, RowConversion::packRGBA(source.data(), destination.data(), 37, true));
+}
+
+TEST(RowConversionTest, packRGB)
+{
+    Vector<unsigned char> source;
+    fillSource(source, 3);
+
+    Vector<ImageFrame::PixelData> expected(testPixels);
+    for (unsigned i = 0; i < testPixels; ++i) {
+        const unsigned char* pixel = source.data() + i * 3;
+        ImageFrame::setRGBARaw(&expected[i], pixel[0], pixel[1], pixel[2], 255);
+    }
+
+    Vector<ImageFrame::PixelData> actual(testPixels);
+    RowConversion::packRGB(source.data(), actual.data(), testPixels);
+    EXPECT_TRUE(expected == actual);
+}
+
+TEST(RowConversionTest, packInvertedCMYK)
+{
+    Vector<unsigned char> source;
+    fillSource(source, 4);
+
+    Vector<ImageFrame::PixelData> expected(testPixels);
+    for (unsigned i = 0; i < testPixels; ++i) {
+        const unsigned char* pixel = source.data() + i * 4;
+        unsigned k = pixel[3];
+        ImageFrame::setRGBARaw(&expected[i], pixel[0] * k / 255, pixel[1] * k / 255, pixel[2] * k / 255, 255);
+    }
+
+    Vector<ImageFrame::PixelData> actual(testPixels);
+    RowConversion::packInvertedCMYK(source.data(), actual.data(), testPixels);
+    EXPECT_TRUE(expected == actual);
+}
+
+TEST(RowConversionTest, packYUV)
+{
+    // Gray stays gray, and saturated chroma clamps.
+    const unsigned char gray = 100, neutral = 128, high = 255, low = 0;
+    ImageFrame::PixelData pixel;
+    RowConversion::packYUV(&gray, &neutral, &neutral, 0, 0, &pixel, 1);
+    ImageFrame::PixelData expected;
+    ImageFrame::setRGBARaw(&expected, 100, 100, 100, 255);
+    EXPECT_EQ(expected, pixel);
+    RowConversion::packYUV(&gray, &low, &high, 0, 0, &pixel, 1);
+    ImageFrame::setRGBARaw(&expected, 255, 53, 0, 255);
+    EXPECT_EQ(expected, pixel);
+
+    // Rows starting inside a chroma sample and ending with a tail give the
+    // same pixels as converting the whole row.
+    const unsigned width = 45;
+    Vector<unsigned char> luma(width);
+    for (unsigned i = 0; i < width; ++i)
+        luma[i] = i * 5;
+    for (unsigned chromaShift = 0; chromaShift <= 2; ++chromaShift) {
+        unsigned chromaWidth = (width + (1 << chromaShift) - 1) >> chromaShift;
+        Vector<unsigned char> u(chromaWidth);
+        Vector<unsigned char> v(chromaWidth);
+        for (unsigned i = 0; i < chromaWidth; ++i) {
+            u[i] = i * 37;
+            v[i] = 255 - i * 23;
+        }
+
+        Vector<ImageFrame::PixelData> row(width);
+        RowConversion::packYUV(luma.data(), u.data(), v.data(), chromaShift, 0, row.data(), width);
+        for (unsigned x = 0; x < width; ++x) {
+            ImageFrame::PixelData single;
+            RowConversion::packYUV(luma.data(), u.data(), v.data(), chromaShift, x, &single, 1);
+            EXPECT_EQ(single, row[x]);
+        }
+
+        Vector<ImageFrame::PixelData> region(width - 11);
+        RowConversion::packYUV(luma.data(), u.data(), v.data(), chromaShift, 3, region.data(), width - 11);
+        for (unsigned x = 0; x < width - 11; ++x)
+            EXPECT_EQ(row[x + 3], region[x]);
+    }
+}
+
+TEST(RowConversionTest, mapPalette)
+{
+    const ImageFrame::PixelData palette[] = { 0xFF000001, 0xFF000002, 0xFF000003 };
+    const unsigned char source[] = { 0, 1, 2, 3, 1 };
+    const ImageFrame::PixelData background = 0xFFFFFFFF;
+
+    ImageFrame::PixelData destination[5];
+    std::fill(destination, destination + 5, background);
+    EXPECT_FALSE(RowConversion::mapPalette(source, destination, 3, palette, 3, kNotFound, true));
+    EXPECT_EQ(palette[0], destination[0]);
+    EXPECT_EQ(palette[2], destination[2]);
+    EXPECT_EQ(background, destination[3]);
+
+    // Index 1 is transparent and index 3 is outside the palette.
+    EXPECT_TRUE(RowConversion::mapPalette(source, destination, 5, palette, 3, 1, true));
+    EXPECT_EQ(palette[0], destination[0]);
+    EXPECT_EQ(0u, destination[1]);
+    EXPECT_EQ(0u, destination[3]);
+
+    std::fill(destination, destination + 5, background);
+    EXPECT_TRUE(RowConversion::mapPalette(source, destination, 5, palette, 3, 1, false));
+    EXPECT_EQ(background, destination[1]);
+    EXPECT_EQ(palette[2], destination[2]);
+    EXPECT_EQ(background, destination[3]);
+}
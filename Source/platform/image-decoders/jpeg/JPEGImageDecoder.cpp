@@ -41,6 +41,7 @@
 #include "platform/image-decoders/jpeg/JPEGImageDecoder.h"
 
 #include "platform/PlatformInstrumentation.h"
+#include "platform/image-decoders/RowConversion.h"
 #include "wtf/PassOwnPtr.h"
 #include "wtf/dtoa/utils.h"
 
@@ -92,9 +93,6 @@ namespace {
 
 const int exifMarker = JPEG_APP0 + 1;
 
-// JPEG only supports a denominator of 8.
-const unsigned scaleDenominator = 8;
-
 } // namespace
 
 namespace blink {
@@ -450,7 +448,7 @@ public:
 
             // Calculate and set decoded size.
             m_info.scale_num = m_decoder->desiredScaleNumerator();
-            m_info.scale_denom = scaleDenominator;
+            m_info.scale_denom = ImageDecoder::scaleDenominator;
             jpeg_calc_output_dimensions(&m_info);
             m_decoder->setDecodedSize(m_info.output_width, m_info.output_height);
 
@@ -523,6 +521,12 @@ public:
                 if (!m_decoder->outputScanlines())
                     return false; // I/O suspension.
 
+                // Region decodes stop after the last row of their region.
+                if (m_info.output_scanline < m_info.output_height) {
+                    m_decoder->jpegComplete();
+                    return true;
+                }
+
                 // If we've completed image output...
                 ASSERT(m_info.output_scanline == m_info.output_height);
                 m_state = JPEG_DONE;
@@ -730,7 +734,7 @@ unsigned JPEGImageDecoder::desiredScaleNumerator() const
 {
     size_t originalBytes = size().width() * size().height() * 4;
     if (originalBytes <= m_maxDecodedBytes) {
-        return scaleDenominator;
+        return m_targetScaleNumerator;
     }
 
     // Downsample according to the maximum decoded size.
@@ -738,7 +742,7 @@ unsigned JPEGImageDecoder::desiredScaleNumerator() const
         // MSVC needs explicit parameter type for sqrt().
         static_cast<float>(m_maxDecodedBytes * scaleDenominator * scaleDenominator / originalBytes))));
 
-    return scaleNumerator;
+    return std::min(scaleNumerator, m_targetScaleNumerator);
 }
 
 bool JPEGImageDecoder::canDecodeToYUV() const
@@ -790,54 +794,39 @@ void JPEGImageDecoder::setImagePlanes(PassOwnPtr<ImagePlanes> imagePlanes)
     m_imagePlanes = imagePlanes;
 }
 
-template <J_COLOR_SPACE colorSpace> void setPixel(ImageFrame& buffer, ImageFrame::PixelData* pixel, JSAMPARRAY samples, int column)
-{
-    ASSERT_NOT_REACHED();
-}
-
-template <> void setPixel<JCS_RGB>(ImageFrame& buffer, ImageFrame::PixelData* pixel, JSAMPARRAY samples, int column)
+// Progressive output passes have to read every row, sequential decodes
+// can stop after the last row of |region|.
+static JDIMENSION lastRowToRead(const jpeg_decompress_struct* info, const IntRect& region)
 {
-    JSAMPLE* jsample = *samples + column * 3;
-    buffer.setRGBARaw(pixel, jsample[0], jsample[1], jsample[2], 255);
+    return info->buffered_image ? info->output_height : static_cast<JDIMENSION>(region.maxY());
 }
 
-template <> void setPixel<JCS_CMYK>(ImageFrame& buffer, ImageFrame::PixelData* pixel, JSAMPARRAY samples, int column)
-{
-    JSAMPLE* jsample = *samples + column * 4;
-
-    // Source is 'Inverted CMYK', output is RGB.
-    // See: http://www.easyrgb.com/math.php?MATH=M12#text12
-    // Or: http://www.ilkeratalay.com/colorspacesfaq.php#rgb
-    // From CMYK to CMY:
-    // X =   X    * (1 -   K   ) +   K  [for X = C, M, or Y]
-    // Thus, from Inverted CMYK to CMY is:
-    // X = (1-iX) * (1 - (1-iK)) + (1-iK) => 1 - iX*iK
-    // From CMY (0..1) to RGB (0..1):
-    // R = 1 - C => 1 - (1 - iC*iK) => iC*iK  [G and B similar]
-    unsigned k = jsample[3];
-    buffer.setRGBARaw(pixel, jsample[0] * k / 255, jsample[1] * k / 255, jsample[2] * k / 255, 255);
-}
-
-template <J_COLOR_SPACE colorSpace> bool outputRows(JPEGImageReader* reader, ImageFrame& buffer)
+template <J_COLOR_SPACE colorSpace> bool outputRows(JPEGImageReader* reader, ImageFrame& buffer, const IntRect& region)
 {
     JSAMPARRAY samples = reader->samples();
     jpeg_decompress_struct* info = reader->info();
-    int width = info->output_width;
+    JDIMENSION lastRow = lastRowToRead(info, region);
 
-    while (info->output_scanline < info->output_height) {
+    while (info->output_scanline < lastRow) {
         // jpeg_read_scanlines will increase the scanline counter, so we
         // save the scanline before calling it.
         int y = info->output_scanline;
         // Request one scanline: returns 0 or 1 scanlines.
         if (jpeg_read_scanlines(info, samples, 1) != 1)
             return false;
+        if (y < region.y() || y >= region.maxY())
+            continue;
 #if USE(QCMSLIB)
-        if (reader->colorTransform() && colorSpace == JCS_RGB)
-            qcms_transform_data(reader->colorTransform(), *samples, *samples, width);
+        if (reader->colorTransform() && colorSpace == JCS_RGB) {
+            JSAMPLE* regionSamples = *samples + region.x() * 3;
+            qcms_transform_data(reader->colorTransform(), regionSamples, regionSamples, region.width());
+        }
 #endif
-        ImageFrame::PixelData* pixel = buffer.getAddr(0, y);
-        for (int x = 0; x < width; ++pixel, ++x)
-            setPixel<colorSpace>(buffer, pixel, samples, x);
+        ImageFrame::PixelData* pixel = buffer.getAddr(0, y - region.y());
+        if (colorSpace == JCS_RGB)
+            RowConversion::packRGB(*samples + region.x() * 3, pixel, region.width());
+        else
+            RowConversion::packInvertedCMYK(*samples + region.x() * 4, pixel, region.width());
     }
 
     buffer.setPixelsChanged(true);
@@ -935,11 +924,12 @@ bool JPEGImageDecoder::outputScanlines()
 
     // Initialize the framebuffer if needed.
     ImageFrame& buffer = m_frameBufferCache[0];
+    const IntRect region = decodeRegion();
     if (buffer.status() == ImageFrame::FrameEmpty) {
         ASSERT(info->output_width == static_cast<JDIMENSION>(m_decodedSize.width()));
         ASSERT(info->output_height == static_cast<JDIMENSION>(m_decodedSize.height()));
 
-        if (!buffer.setSize(info->output_width, info->output_height))
+        if (!buffer.setSize(region.width(), region.height()))
             return setFailed();
         buffer.setStatus(ImageFrame::FramePartial);
         // The buffer is transparent outside the decoded area while the image is
@@ -952,13 +942,23 @@ bool JPEGImageDecoder::outputScanlines()
 
 #if defined(TURBO_JPEG_RGB_SWIZZLE)
     if (turboSwizzled(info->out_color_space)) {
-        while (info->output_scanline < info->output_height) {
-            unsigned char* row = reinterpret_cast<unsigned char*>(buffer.getAddr(0, info->output_scanline));
+        JDIMENSION lastRow = lastRowToRead(info, region);
+        while (info->output_scanline < lastRow) {
+            int y = info->output_scanline;
+            bool rowInRegion = y >= region.y() && y < region.maxY();
+            // Rows of full width regions are decoded in place, others go
+            // through the sample buffer.
+            unsigned char* regionRow = rowInRegion ? reinterpret_cast<unsigned char*>(buffer.getAddr(0, y - region.y())) : 0;
+            unsigned char* row = rowInRegion && region.width() == static_cast<int>(info->output_width) ? regionRow : *m_reader->samples();
             if (jpeg_read_scanlines(info, &row, 1) != 1)
                 return false;
+            if (!rowInRegion)
+                continue;
+            if (row != regionRow)
+                memcpy(regionRow, row + region.x() * sizeof(ImageFrame::PixelData), region.width() * sizeof(ImageFrame::PixelData));
 #if USE(QCMSLIB)
             if (qcms_transform* transform = m_reader->colorTransform())
-                qcms_transform_data_type(transform, row, row, info->output_width, rgbOutputColorSpace() == JCS_EXT_BGRA ? QCMS_OUTPUT_BGRX : QCMS_OUTPUT_RGBX);
+                qcms_transform_data_type(transform, regionRow, regionRow, region.width(), rgbOutputColorSpace() == JCS_EXT_BGRA ? QCMS_OUTPUT_BGRX : QCMS_OUTPUT_RGBX);
 #endif
         }
         buffer.setPixelsChanged(true);
@@ -968,9 +968,9 @@ bool JPEGImageDecoder::outputScanlines()
 
     switch (info->out_color_space) {
     case JCS_RGB:
-        return outputRows<JCS_RGB>(m_reader.get(), buffer);
+        return outputRows<JCS_RGB>(m_reader.get(), buffer, region);
     case JCS_CMYK:
-        return outputRows<JCS_CMYK>(m_reader.get(), buffer);
+        return outputRows<JCS_CMYK>(m_reader.get(), buffer, region);
     default:
         ASSERT_NOT_REACHED();
     }
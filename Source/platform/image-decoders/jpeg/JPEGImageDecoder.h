@@ -48,6 +48,8 @@ public:
     virtual bool isSizeAvailable() override;
     virtual bool hasColorProfile() const override { return m_hasColorProfile; }
     virtual IntSize decodedSize() const override { return m_decodedSize; }
+    virtual bool canDecodeToScale() const override { return true; }
+    virtual bool canDecodeRegion() const override { return true; }
     virtual IntSize decodedYUVSize(int component, SizeType) const override;
     virtual bool setSize(unsigned width, unsigned height) override;
     virtual ImageFrame* frameBufferAtIndex(size_t) override;
@@ -79,6 +79,23 @@ void downsample(size_t maxDecodedBytes, unsigned* outputWidth, unsigned* outputH
     EXPECT_EQ(IntSize(*outputWidth, *outputHeight), decoder->decodedSize());
 }
 
+void decodeToScale(unsigned scaleNumerator, size_t maxDecodedBytes, unsigned* outputWidth, unsigned* outputHeight, const char* imageFilePath)
+{
+    RefPtr<SharedBuffer> data = readFile(imageFilePath);
+    ASSERT_TRUE(data.get());
+
+    OwnPtr<JPEGImageDecoder> decoder = createDecoder(maxDecodedBytes);
+    decoder->setTargetScaleNumerator(scaleNumerator);
+    decoder->setData(data.get(), true);
+
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(ImageFrame::FrameComplete, frame->status());
+    *outputWidth = frame->getSkBitmap().width();
+    *outputHeight = frame->getSkBitmap().height();
+    EXPECT_EQ(IntSize(*outputWidth, *outputHeight), decoder->decodedSize());
+}
+
 void readYUV(size_t maxDecodedBytes, unsigned* outputYWidth, unsigned* outputYHeight, unsigned* outputUVWidth, unsigned* outputUVHeight, const char* imageFilePath)
 {
     RefPtr<SharedBuffer> data = readFile(imageFilePath);
@@ -203,6 +220,75 @@ TEST(JPEGImageDecoderTest, downsampleImageSizeNotMultipleOf8)
     EXPECT_EQ(182u, outputHeight);
 }
 
+// Tests that a target scale decodes to the size ImageDecoder::scaledSize()
+// predicts, which is what lazily decoded bitmaps of that scale are sized to.
+TEST(JPEGImageDecoderTest, decodeToScale)
+{
+    const char* jpegFile = "/LayoutTests/fast/images/resources/icc-v2-gbr.jpg"; // 275x207
+    unsigned outputWidth, outputHeight;
+
+    for (unsigned scaleNumerator = 1; scaleNumerator <= ImageDecoder::scaleDenominator; scaleNumerator *= 2) {
+        decodeToScale(scaleNumerator, LargeEnoughSize, &outputWidth, &outputHeight, jpegFile);
+        EXPECT_EQ(ImageDecoder::scaledSize(IntSize(275, 207), scaleNumerator), IntSize(outputWidth, outputHeight));
+    }
+
+    decodeToScale(1, LargeEnoughSize, &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(35u, outputWidth);
+    EXPECT_EQ(26u, outputHeight);
+}
+
+// Tests that the decoded byte limit still applies if it asks for a smaller
+// size than the target scale.
+TEST(JPEGImageDecoderTest, decodeToScaleWithinMaxDecodedSize)
+{
+    const char* jpegFile = "/LayoutTests/fast/images/resources/lenna.jpg"; // 256x256
+    unsigned outputWidth, outputHeight;
+
+    // The 1/8 limit wins over a 4/8 target.
+    decodeToScale(4, 40 * 40 * 4, &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(32u, outputWidth);
+    EXPECT_EQ(32u, outputHeight);
+
+    // The 1/8 target wins over a 4/8 limit.
+    decodeToScale(1, 130 * 130 * 4, &outputWidth, &outputHeight, jpegFile);
+    EXPECT_EQ(32u, outputWidth);
+    EXPECT_EQ(32u, outputHeight);
+}
+
+// Tests that decoding a region gives the same pixels as the region of a full
+// decode.
+TEST(JPEGImageDecoderTest, decodeRegion)
+{
+    RefPtr<SharedBuffer> data = readFile("/LayoutTests/fast/images/resources/lenna.jpg"); // 256x256
+    ASSERT_TRUE(data.get());
+
+    OwnPtr<JPEGImageDecoder> decoder = createDecoder(LargeEnoughSize);
+    decoder->setData(data.get(), true);
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    SkBitmap fullBitmap = frame->getSkBitmap();
+
+    IntRect region(32, 48, 100, 60);
+    OwnPtr<JPEGImageDecoder> regionDecoder = createDecoder(LargeEnoughSize);
+    ASSERT_TRUE(regionDecoder->canDecodeRegion());
+    regionDecoder->setDecodeRegion(region);
+    regionDecoder->setData(data.get(), true);
+    frame = regionDecoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(ImageFrame::FrameComplete, frame->status());
+    EXPECT_EQ(region, regionDecoder->decodeRegion());
+    SkBitmap regionBitmap = frame->getSkBitmap();
+    ASSERT_EQ(region.width(), regionBitmap.width());
+    ASSERT_EQ(region.height(), regionBitmap.height());
+
+    SkAutoLockPixels fullLock(fullBitmap);
+    SkAutoLockPixels regionLock(regionBitmap);
+    for (int y = 0; y < region.height(); ++y) {
+        for (int x = 0; x < region.width(); ++x)
+            ASSERT_EQ(*fullBitmap.getAddr32(region.x() + x, region.y() + y), *regionBitmap.getAddr32(x, y));
+    }
+}
+
 // Tests that upsampling is not allowed.
 TEST(JPEGImageDecoderTest, upsample)
 {
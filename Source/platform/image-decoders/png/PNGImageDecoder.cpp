@@ -40,6 +40,7 @@
 #include "platform/image-decoders/png/PNGImageDecoder.h"
 
 #include "platform/PlatformInstrumentation.h"
+#include "platform/image-decoders/RowConversion.h"
 #include "wtf/PassOwnPtr.h"
 
 #include "png.h"
@@ -390,16 +391,18 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
 
     // Initialize the framebuffer if needed.
     ImageFrame& buffer = m_frameBufferCache[0];
+    const IntRect region = decodeRegion();
     if (buffer.status() == ImageFrame::FrameEmpty) {
         png_structp png = m_reader->pngPtr();
-        if (!buffer.setSize(size().width(), size().height())) {
+        if (!buffer.setSize(region.width(), region.height())) {
             longjmp(JMPBUF(png), 1);
             return;
         }
 
         unsigned colorChannels = m_reader->hasAlpha() ? 4 : 3;
         if (PNG_INTERLACE_ADAM7 == png_get_interlace_type(png, m_reader->infoPtr())) {
-            m_reader->createInterlaceBuffer(colorChannels * size().width() * size().height());
+            // Later passes only need the rows of the region.
+            m_reader->createInterlaceBuffer(colorChannels * size().width() * region.height());
             if (!m_reader->interlaceBuffer()) {
                 longjmp(JMPBUF(png), 1);
                 return;
@@ -440,7 +443,7 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
     if (!rowBuffer)
         return;
     int y = rowIndex;
-    if (y < 0 || y >= size().height())
+    if (y < region.y() || y >= region.maxY())
         return;
 
     /* libpng comments (continued).
@@ -463,50 +466,41 @@ void PNGImageDecoder::rowAvailable(unsigned char* rowBuffer, unsigned rowIndex,
      */
 
     bool hasAlpha = m_reader->hasAlpha();
+    unsigned colorChannels = hasAlpha ? 4 : 3;
     png_bytep row = rowBuffer;
 
     if (png_bytep interlaceBuffer = m_reader->interlaceBuffer()) {
-        unsigned colorChannels = hasAlpha ? 4 : 3;
-        row = interlaceBuffer + (rowIndex * colorChannels * size().width());
+        row = interlaceBuffer + ((y - region.y()) * colorChannels * size().width());
         png_progressive_combine_row(m_reader->pngPtr(), row, rowBuffer);
     }
 
+    // Only the columns of the region are stored.
+    row += region.x() * colorChannels;
+
 #if USE(QCMSLIB)
     if (qcms_transform* transform = m_reader->colorTransform()) {
-        qcms_transform_data(transform, row, m_reader->rowBuffer(), size().width());
+        qcms_transform_data(transform, row, m_reader->rowBuffer(), region.width());
         row = m_reader->rowBuffer();
     }
 #endif
 
-    // Write the decoded row pixels to the frame buffer. The repetitive
-    // form of the row write loops is for speed.
-    ImageFrame::PixelData* address = buffer.getAddr(0, y);
+    // Write the decoded row pixels to the frame buffer.
+    ImageFrame::PixelData* address = buffer.getAddr(0, y - region.y());
     unsigned alphaMask = 255;
-    int width = size().width();
-
-    png_bytep pixel = row;
-    if (hasAlpha) {
-        if (buffer.premultiplyAlpha()) {
-            for (int x = 0; x < width; ++x, pixel += 4) {
-                buffer.setRGBAPremultiply(address++, pixel[0], pixel[1], pixel[2], pixel[3]);
-                alphaMask &= pixel[3];
-            }
-        } else {
-            for (int x = 0; x < width; ++x, pixel += 4) {
-                buffer.setRGBARaw(address++, pixel[0], pixel[1], pixel[2], pixel[3]);
-                alphaMask &= pixel[3];
-            }
-        }
-    } else {
-        for (int x = 0; x < width; ++x, pixel += 3) {
-            buffer.setRGBARaw(address++, pixel[0], pixel[1], pixel[2], 255);
-        }
-    }
+    if (hasAlpha)
+        alphaMask = RowConversion::packRGBA(row, address, region.width(), buffer.premultiplyAlpha());
+    else
+        RowConversion::packRGB(row, address, region.width());
 
     if (alphaMask != 255 && !buffer.hasAlpha())
         buffer.setHasAlpha(true);
 
     buffer.setPixelsChanged(true);
+
+    // Without interlacing nothing below the region changes it, so the
+    // reader can stop here.
+    if (y == region.maxY() - 1 && !m_reader->interlaceBuffer() && region.maxY() < size().height())
+        complete();
 }
 
 void PNGImageDecoder::complete()
@@ -44,6 +44,7 @@ public:
     virtual String filenameExtension() const override { return "png"; }
     virtual bool isSizeAvailable() override;
     virtual bool hasColorProfile() const override { return m_hasColorProfile; }
+    virtual bool canDecodeRegion() const override { return true; }
     virtual ImageFrame* frameBufferAtIndex(size_t) override;
 
     // Callbacks from libpng
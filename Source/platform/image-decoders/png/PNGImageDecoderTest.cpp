@@ -0,0 +1,168 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "config.h"
+#include "platform/image-decoders/png/PNGImageDecoder.h"
+
+#include "platform/SharedBuffer.h"
+#include "wtf/OwnPtr.h"
+#include "wtf/PassOwnPtr.h"
+#include <gtest/gtest.h>
+
+using namespace blink;
+
+namespace {
+
+// The same 37x29 picture with alpha, stored without and with Adam7
+// interlacing.
+const unsigned char regionPNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00,
+    0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x25,
+    0x00, 0x00, 0x00, 0x1d, 0x08, 0x06, 0x00, 0x00, 0x00, 0x2d,
+    0xb7, 0xa5, 0xc3, 0x00, 0x00, 0x00, 0xb3, 0x49, 0x44, 0x41,
+    0x54, 0x78, 0xda, 0xcd, 0xd7, 0x21, 0x0f, 0xc2, 0x30, 0x10,
+    0x86, 0xe1, 0xef, 0x0c, 0x99, 0x44, 0x22, 0x91, 0xc8, 0x49,
+    0xe4, 0x24, 0x12, 0x89, 0x44, 0x4e, 0x22, 0x71, 0xb4, 0x6e,
+    0x72, 0x12, 0x89, 0x44, 0x22, 0x91, 0x48, 0x24, 0x12, 0xb9,
+    0x7f, 0x72, 0xe0, 0x08, 0x37, 0x85, 0xa1, 0xaf, 0x68, 0x93,
+    0xe6, 0x2e, 0x5f, 0x1e, 0xd1, 0xa4, 0x3d, 0x93, 0x94, 0x26,
+    0xef, 0xed, 0xb3, 0xfc, 0xf0, 0x7d, 0x36, 0x85, 0x7a, 0x0e,
+    0xf5, 0xd0, 0xef, 0xa1, 0xdf, 0xf2, 0xaf, 0xf9, 0xa6, 0x8a,
+    0x88, 0x9a, 0x12, 0x51, 0x33, 0x22, 0x6a, 0xee, 0x5e, 0x1a,
+    0x11, 0xf3, 0x4d, 0x0b, 0x22, 0xaa, 0x26, 0xa2, 0x96, 0x44,
+    0x54, 0x23, 0x2f, 0x8d, 0x88, 0xf9, 0xa6, 0x15, 0x11, 0xb5,
+    0x26, 0xa2, 0x36, 0x44, 0xd4, 0xd6, 0x53, 0x69, 0x44, 0xcc,
+    0x37, 0xb5, 0x44, 0xd4, 0x8e, 0x88, 0xda, 0x13, 0x51, 0x69,
+    0x74, 0xd1, 0xff, 0x8e, 0x88, 0xf9, 0xa6, 0x8e, 0x88, 0xea,
+    0x89, 0xa8, 0x23, 0x11, 0x75, 0x1a, 0x3d, 0xc8, 0xb9, 0xf4,
+    0xa7, 0xcf, 0x74, 0x26, 0xa2, 0x2e, 0x44, 0xd4, 0x95, 0x88,
+    0xba, 0x11, 0x07, 0x87, 0x3b, 0x11, 0xf5, 0x20, 0xa2, 0x9e,
+    0x44, 0xd4, 0xc0, 0x1b, 0x1c, 0x5e, 0x41, 0xee, 0x24, 0x34,
+    0xdf, 0x22, 0xd5, 0x31, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+const unsigned char interlacedRegionPNG[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00,
+    0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00, 0x00, 0x25,
+    0x00, 0x00, 0x00, 0x1d, 0x08, 0x06, 0x00, 0x00, 0x01, 0x5a,
+    0xb0, 0x95, 0x55, 0x00, 0x00, 0x01, 0x71, 0x49, 0x44, 0x41,
+    0x54, 0x78, 0xda, 0xcd, 0x95, 0xad, 0x57, 0xc3, 0x30, 0x14,
+    0xc5, 0xef, 0x35, 0x39, 0x88, 0x88, 0xc9, 0xca, 0x49, 0xe4,
+    0x24, 0x72, 0x12, 0x39, 0x89, 0x9c, 0x44, 0x4e, 0xe2, 0x9a,
+    0x38, 0xe4, 0x24, 0x72, 0x12, 0x39, 0x89, 0xac, 0x44, 0x4e,
+    0x22, 0xf7, 0x9f, 0x3c, 0xde, 0x46, 0x3b, 0x46, 0xba, 0x8f,
+    0x42, 0xdf, 0xa1, 0x11, 0x39, 0x49, 0x5e, 0x6f, 0x7e, 0xb9,
+    0x79, 0xf9, 0x28, 0x01, 0x84, 0x09, 0x50, 0x6a, 0x81, 0x96,
+    0xb8, 0x6b, 0x13, 0x53, 0xc8, 0x71, 0x60, 0xd7, 0x26, 0xc2,
+    0x3e, 0x18, 0x8f, 0xd5, 0x44, 0x75, 0x62, 0x78, 0x01, 0x69,
+    0x2b, 0x8b, 0xa9, 0x9c, 0x50, 0x06, 0x69, 0x4f, 0x54, 0x54,
+    0x27, 0x86, 0x63, 0x2c, 0x52, 0xa8, 0x09, 0x65, 0x47, 0xad,
+    0x4b, 0xad, 0xb5, 0x4d, 0x6d, 0x4b, 0x79, 0x1c, 0x27, 0xe6,
+    0x12, 0x2e, 0x09, 0x9a, 0x38, 0xb1, 0xda, 0x13, 0xcf, 0x0a,
+    0x9a, 0x38, 0xb1, 0xed, 0x38, 0xb5, 0xd7, 0x5c, 0x5e, 0xa5,
+    0xf9, 0x0e, 0x0b, 0xa1, 0xd7, 0x0d, 0xb8, 0x3e, 0x5d, 0x87,
+    0x95, 0xd2, 0x87, 0x3d, 0xe9, 0x72, 0x2a, 0x7c, 0x87, 0x54,
+    0xd0, 0x57, 0x5d, 0x56, 0xd7, 0x21, 0x57, 0xc4, 0x08, 0x41,
+    0x73, 0x05, 0xaf, 0xc1, 0xaf, 0x9a, 0xa8, 0xfb, 0xb1, 0xee,
+    0xd7, 0x71, 0xa9, 0xe3, 0x8c, 0xe7, 0xf4, 0xc4, 0x44, 0xa4,
+    0x2f, 0xa4, 0xd1, 0x13, 0x33, 0x48, 0x5f, 0x48, 0xa3, 0x27,
+    0x16, 0x12, 0xfa, 0x42, 0x1a, 0x3d, 0xb1, 0x3c, 0x38, 0xfb,
+    0x33, 0xa4, 0xd1, 0x13, 0xeb, 0x43, 0xce, 0x62, 0xdf, 0x8d,
+    0x20, 0x36, 0x86, 0xbb, 0xe9, 0x60, 0x03, 0xa3, 0x1b, 0x59,
+    0x81, 0xc6, 0x36, 0xe7, 0x8b, 0x6e, 0x62, 0x05, 0x9a, 0xda,
+    0x1c, 0x52, 0xba, 0x99, 0x15, 0x68, 0x6e, 0x73, 0xd2, 0xe9,
+    0x16, 0x56, 0xa0, 0x60, 0x73, 0x5d, 0xe8, 0x96, 0x56, 0xa0,
+    0x95, 0xcd, 0x9d, 0xa3, 0x5b, 0x5b, 0x81, 0x2a, 0xab, 0x2b,
+    0xb2, 0xb1, 0x02, 0x6d, 0x8d, 0xae, 0x08, 0x6e, 0x10, 0xf4,
+    0x29, 0xc1, 0x77, 0x91, 0xf2, 0x67, 0x9f, 0x48, 0xbe, 0xc7,
+    0xe4, 0x7b, 0xa2, 0x97, 0x44, 0xcf, 0xf8, 0x5b, 0xfe, 0xee,
+    0xe7, 0x97, 0xa1, 0xa9, 0x5b, 0x91, 0xa1, 0x4d, 0xa4, 0x7c,
+    0xe2, 0x2e, 0x47, 0x53, 0xf7, 0x90, 0xa1, 0x4d, 0xa4, 0x7c,
+    0xe2, 0x21, 0x47, 0x53, 0x8f, 0x12, 0x86, 0x36, 0x91, 0xf2,
+    0x89, 0xa7, 0x1c, 0x4d, 0x3d, 0xb7, 0xb6, 0xef, 0xdf, 0x4d,
+    0xa4, 0x7c, 0xe2, 0x25, 0x47, 0x53, 0xaf, 0xad, 0x27, 0x21,
+    0x0e, 0xfd, 0x98, 0x12, 0x6f, 0x39, 0x9a, 0x7a, 0xcf, 0xf1,
+    0x37, 0xf3, 0x91, 0x9f, 0xa9, 0x4f, 0x31, 0xc3, 0xed, 0xf0,
+    0x5c, 0xfa, 0x90, 0xcf, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+PassOwnPtr<PNGImageDecoder> createDecoder()
+{
+    return adoptPtr(new PNGImageDecoder(ImageSource::AlphaNotPremultiplied, ImageSource::GammaAndColorProfileApplied, ImageDecoder::noDecodedImageByteLimit));
+}
+
+// Tests that decoding |region| gives the same pixels as the part of a full
+// decode that |expectedRegion| covers.
+template <size_t size>
+void testDecodeRegion(const unsigned char (&png)[size], const IntRect& region, const IntRect& expectedRegion)
+{
+    RefPtr<SharedBuffer> data = SharedBuffer::create(png, size);
+
+    OwnPtr<PNGImageDecoder> decoder = createDecoder();
+    decoder->setData(data.get(), true);
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(ImageFrame::FrameComplete, frame->status());
+    SkBitmap fullBitmap = frame->getSkBitmap();
+    ASSERT_EQ(37, fullBitmap.width());
+    ASSERT_EQ(29, fullBitmap.height());
+
+    OwnPtr<PNGImageDecoder> regionDecoder = createDecoder();
+    ASSERT_TRUE(regionDecoder->canDecodeRegion());
+    regionDecoder->setDecodeRegion(region);
+    regionDecoder->setData(data.get(), true);
+    frame = regionDecoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(ImageFrame::FrameComplete, frame->status());
+    EXPECT_FALSE(regionDecoder->failed());
+    EXPECT_EQ(expectedRegion, regionDecoder->decodeRegion());
+    SkBitmap regionBitmap = frame->getSkBitmap();
+    ASSERT_EQ(expectedRegion.width(), regionBitmap.width());
+    ASSERT_EQ(expectedRegion.height(), regionBitmap.height());
+
+    SkAutoLockPixels fullLock(fullBitmap);
+    SkAutoLockPixels regionLock(regionBitmap);
+    for (int y = 0; y < expectedRegion.height(); ++y) {
+        for (int x = 0; x < expectedRegion.width(); ++x)
+            ASSERT_EQ(*fullBitmap.getAddr32(expectedRegion.x() + x, expectedRegion.y() + y), *regionBitmap.getAddr32(x, y));
+    }
+}
+
+} // namespace
+
+TEST(PNGImageDecoderTest, decodeRegion)
+{
+    IntRect region(5, 9, 20, 11);
+    testDecodeRegion(regionPNG, region, region);
+}
+
+TEST(PNGImageDecoderTest, decodeRegionInterlaced)
+{
+    IntRect region(5, 9, 20, 11);
+    testDecodeRegion(interlacedRegionPNG, region, region);
+}
+
+TEST(PNGImageDecoderTest, decodeRegionAtRightAndBottomEdges)
+{
+    IntRect region(21, 17, 16, 12);
+    testDecodeRegion(regionPNG, region, region);
+    testDecodeRegion(interlacedRegionPNG, region, region);
+}
+
+TEST(PNGImageDecoderTest, decodeRegionBeyondRightAndBottomEdges)
+{
+    // Regions are clipped to the image.
+    testDecodeRegion(regionPNG, IntRect(30, 20, 16, 16), IntRect(30, 20, 7, 9));
+    testDecodeRegion(interlacedRegionPNG, IntRect(30, 20, 16, 16), IntRect(30, 20, 7, 9));
+}
+
+TEST(PNGImageDecoderTest, decodeRegionOfTopRows)
+{
+    // Decoding of non-interlaced images stops after the region's last row.
+    IntRect region(0, 0, 37, 1);
+    testDecodeRegion(regionPNG, region, region);
+    testDecodeRegion(interlacedRegionPNG, region, region);
+}
@@ -178,6 +178,17 @@ bool WEBPImageDecoder::isSizeAvailable()
     return ImageDecoder::isSizeAvailable();
 }
 
+IntSize WEBPImageDecoder::decodedSize() const
+{
+    return canDecodeToScale() ? scaledSize(size(), m_targetScaleNumerator) : size();
+}
+
+bool WEBPImageDecoder::canDecodeToScale() const
+{
+    // Animation frames are composited onto each other at full size.
+    return ImageDecoder::isSizeAvailable() && !(m_formatFlags & ANIMATION_FLAG);
+}
+
 size_t WEBPImageDecoder::frameCount()
 {
     if (!updateDemuxer())
@@ -565,13 +576,14 @@ bool WEBPImageDecoder::decode(const uint8_t* dataBytes, size_t dataSize, bool on
     ASSERT(buffer.status() != ImageFrame::FrameComplete);
 
     if (buffer.status() == ImageFrame::FrameEmpty) {
-        if (!buffer.setSize(size().width(), size().height()))
+        const IntSize bufferSize = decodedSize();
+        if (!buffer.setSize(bufferSize.width(), bufferSize.height()))
             return setFailed();
         buffer.setStatus(ImageFrame::FramePartial);
         // The buffer is transparent outside the decoded area while the image is loading.
         // The correct value of 'hasAlpha' for the frame will be set when it is fully decoded.
         buffer.setHasAlpha(true);
-        buffer.setOriginalFrameRect(IntRect(IntPoint(), size()));
+        buffer.setOriginalFrameRect(IntRect(IntPoint(), bufferSize));
     }
 
     const IntRect& frameRect = buffer.originalFrameRect();
@@ -583,17 +595,26 @@ bool WEBPImageDecoder::decode(const uint8_t* dataBytes, size_t dataSize, bool on
         if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile())
             mode = MODE_RGBA; // Decode to RGBA for input to libqcms.
 #endif
-        WebPInitDecBuffer(&m_decoderBuffer);
-        m_decoderBuffer.colorspace = mode;
-        m_decoderBuffer.u.RGBA.stride = size().width() * sizeof(ImageFrame::PixelData);
-        m_decoderBuffer.u.RGBA.size = m_decoderBuffer.u.RGBA.stride * frameRect.height();
-        m_decoderBuffer.is_external_memory = 1;
-        m_decoder = WebPINewDecoder(&m_decoderBuffer);
+        if (!WebPInitDecoderConfig(&m_decoderConfig))
+            return setFailed();
+        WebPDecBuffer& decoderBuffer = m_decoderConfig.output;
+        decoderBuffer.colorspace = mode;
+        decoderBuffer.u.RGBA.stride = decodedSize().width() * sizeof(ImageFrame::PixelData);
+        decoderBuffer.u.RGBA.size = decoderBuffer.u.RGBA.stride * frameRect.height();
+        decoderBuffer.is_external_memory = 1;
+        // libwebp scales while decoding, so only the scaled rows are ever
+        // reconstructed and written out.
+        if (decodedSize() != size()) {
+            m_decoderConfig.options.use_scaling = 1;
+            m_decoderConfig.options.scaled_width = frameRect.width();
+            m_decoderConfig.options.scaled_height = frameRect.height();
+        }
+        m_decoder = WebPIDecode(0, 0, &m_decoderConfig);
         if (!m_decoder)
             return setFailed();
     }
 
-    m_decoderBuffer.u.RGBA.rgba = reinterpret_cast<uint8_t*>(buffer.getAddr(frameRect.x(), frameRect.y()));
+    m_decoderConfig.output.u.RGBA.rgba = reinterpret_cast<uint8_t*>(buffer.getAddr(frameRect.x(), frameRect.y()));
 
     switch (WebPIUpdate(m_decoder, dataBytes, dataSize)) {
     case VP8_STATUS_OK:
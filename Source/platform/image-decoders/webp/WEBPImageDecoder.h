@@ -44,6 +44,8 @@ public:
     virtual String filenameExtension() const override { return "webp"; }
     virtual bool isSizeAvailable() override;
     virtual bool hasColorProfile() const override { return m_hasColorProfile; }
+    virtual IntSize decodedSize() const override;
+    virtual bool canDecodeToScale() const override;
     virtual size_t frameCount() override;
     virtual ImageFrame* frameBufferAtIndex(size_t) override;
     virtual void setData(SharedBuffer* data, bool allDataReceived) override;
@@ -56,7 +58,8 @@ private:
     bool decode(const uint8_t* dataBytes, size_t dataSize, bool onlySize, size_t frameIndex);
 
     WebPIDecoder* m_decoder;
-    WebPDecBuffer m_decoderBuffer;
+    // Holds the output buffer and the scaling options of |m_decoder|.
+    WebPDecoderConfig m_decoderConfig;
     int m_formatFlags;
     bool m_frameBackgroundHasAlpha;
     bool m_hasColorProfile;
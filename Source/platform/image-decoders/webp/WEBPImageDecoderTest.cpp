@@ -662,3 +662,45 @@ TEST(StaticWebPTests, notAnimated)
     EXPECT_EQ(1u, decoder->frameCount());
     EXPECT_EQ(cAnimationNone, decoder->repetitionCount());
 }
+
+TEST(StaticWebPTests, decodeToScale)
+{
+    const char* webpFiles[] = {
+        "/LayoutTests/fast/images/resources/webp-color-profile-lossy.webp",
+        "/LayoutTests/fast/images/resources/webp-color-profile-lossless.webp",
+    };
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(webpFiles); ++i) {
+        RefPtr<SharedBuffer> data = readFile(webpFiles[i]);
+        ASSERT_TRUE(data.get());
+
+        for (unsigned scaleNumerator = 1; scaleNumerator <= ImageDecoder::scaleDenominator; scaleNumerator *= 2) {
+            OwnPtr<WEBPImageDecoder> decoder = createDecoder();
+            decoder->setTargetScaleNumerator(scaleNumerator);
+            decoder->setData(data.get(), true);
+            ASSERT_TRUE(decoder->isSizeAvailable());
+            EXPECT_TRUE(decoder->canDecodeToScale());
+
+            ImageFrame* frame = decoder->frameBufferAtIndex(0);
+            ASSERT_TRUE(frame);
+            EXPECT_EQ(ImageFrame::FrameComplete, frame->status());
+            EXPECT_EQ(ImageDecoder::scaledSize(decoder->size(), scaleNumerator), decoder->decodedSize());
+            EXPECT_EQ(decoder->decodedSize(), IntSize(frame->getSkBitmap().width(), frame->getSkBitmap().height()));
+        }
+    }
+}
+
+TEST(AnimatedWebPTests, decodeToScaleIgnored)
+{
+    OwnPtr<WEBPImageDecoder> decoder = createDecoder();
+    decoder->setTargetScaleNumerator(1);
+    RefPtr<SharedBuffer> data = readFile("/LayoutTests/fast/images/resources/webp-animated.webp");
+    ASSERT_TRUE(data.get());
+    decoder->setData(data.get(), true);
+    ASSERT_TRUE(decoder->isSizeAvailable());
+
+    // Animation frames are composited at full size.
+    EXPECT_FALSE(decoder->canDecodeToScale());
+    ImageFrame* frame = decoder->frameBufferAtIndex(0);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(decoder->size(), IntSize(frame->getSkBitmap().width(), frame->getSkBitmap().height()));
+}
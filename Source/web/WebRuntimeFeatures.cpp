@@ -83,6 +83,11 @@ void WebRuntimeFeatures::enableDecodeToYUV(bool enable)
     RuntimeEnabledFeatures::setDecodeToYUVEnabled(enable);
 }
 
+void WebRuntimeFeatures::enableSoftwareDecodeToYUV(bool enable)
+{
+    RuntimeEnabledFeatures::setSoftwareDecodeToYUVEnabled(enable);
+}
+
 void WebRuntimeFeatures::forceDisplayList2dCanvas(bool enable)
 {
     RuntimeEnabledFeatures::setForceDisplayList2dCanvasEnabled(enable);
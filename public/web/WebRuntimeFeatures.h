@@ -50,6 +50,7 @@ public:
     BLINK_EXPORT static bool isCompositedSelectionUpdateEnabled();
 
     BLINK_EXPORT static void enableDecodeToYUV(bool);
+    BLINK_EXPORT static void enableSoftwareDecodeToYUV(bool);
 
     BLINK_EXPORT static void enableDisplayList2dCanvas(bool);
     BLINK_EXPORT static void forceDisplayList2dCanvas(bool);